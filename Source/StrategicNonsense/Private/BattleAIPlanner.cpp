@@ -0,0 +1,135 @@
+#include "BattleAIPlanner.h"
+#include "StrategicNonsense.h"
+#include "BattleSearch.h"
+#include "BattleMCTS.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_CYCLE_STAT(TEXT("AI PlanTurn"), STAT_SNAIPlanTurn, STATGROUP_StrategicNonsense);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI states evaluated"), STAT_SNAIStatesEvaluated, STATGROUP_StrategicNonsense);
+TRACE_DECLARE_INT_COUNTER(SNAIStatesEvaluated, TEXT("StrategicNonsense/AI states evaluated"));
+
+namespace
+{
+    constexpr double MinActionBudgetSeconds = 0.005;
+
+    // Search nodes or Monte Carlo playouts behind one planned action
+    void CountStatesEvaluated(int64 NumStates)
+    {
+        INC_DWORD_STAT_BY(STAT_SNAIStatesEvaluated, static_cast<uint32>(NumStates));
+        TRACE_COUNTER_ADD(SNAIStatesEvaluated, NumStates);
+    }
+}
+
+/**
+ * @brief Chooses one action per unit the side to move still has, splitting the turn budget between them.
+ *
+ * Later units are planned against the expected result of earlier attacks; the game thread
+ * re-validates every command against the real board before applying it.
+ *
+ * @param Board The captured terrain.
+ * @param State The captured state; the AI is the side to move.
+ * @param Settings Engine choice and limits.
+ * @param bCancelled Set by the game thread to stop planning early.
+ * @param OutCommands Receives the planned actions, in order (empty if cancelled).
+ */
+void FBattleAIPlanner::PlanTurn(const FBattleBoard& Board, const FBattleState& State, const FBattleAIPlannerSettings& Settings,
+    const std::atomic<bool>& bCancelled, TArray<FBattleAction>& OutCommands)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FBattleAIPlanner::PlanTurn);
+    SCOPE_CYCLE_COUNTER(STAT_SNAIPlanTurn);
+
+    OutCommands.Reset();
+
+    FBattleState Plan = State;
+    const uint8 Side = Plan.SideToMove;
+    const double TurnDeadline = FPlatformTime::Seconds() + Settings.TurnBudgetSeconds;
+
+    FBattleSearch Search(Board);
+    FBattleMCTS MonteCarlo(Board);
+
+    while (!Plan.IsTerminal() && Plan.SideToMove == Side)
+    {
+        int32 UnitsToAct = 0;
+        for (int32 Index = 0; Index < Plan.NumUnits; ++Index)
+        {
+            const FBattleUnit& Unit = Plan.Units[Index];
+            if (Unit.Team == Side && Unit.IsAlive() && !Unit.HasActed())
+                ++UnitsToAct;
+        }
+
+        if (UnitsToAct == 0)
+            break;
+
+        const double Budget = FMath::Max((TurnDeadline - FPlatformTime::Seconds()) / UnitsToAct, MinActionBudgetSeconds);
+
+        FBattleAction Action;
+        bool bHasAction = false;
+
+        if (Settings.bUseMonteCarlo)
+        {
+            FBattleMCTSSettings MCTSSettings;
+            MCTSSettings.TimeBudgetSeconds = Budget;
+            MCTSSettings.NumWorkers = Settings.MonteCarloWorkers;
+            MCTSSettings.Seed = Settings.Seed + OutCommands.Num() * FBattleState::MaxUnits;
+            MCTSSettings.CancelFlag = &bCancelled;
+
+            const FBattleMCTSResult Result = MonteCarlo.FindBestAction(Plan, MCTSSettings);
+            UE_LOG(LogSNAI, Log, TEXT("AI MCTS: %lld playouts on %d workers (%.0f playouts/s), win rate %.2f"),
+                Result.Playouts, Result.NumWorkers, Result.PlayoutsPerSecond, Result.WinRate);
+            CountStatesEvaluated(Result.Playouts);
+
+            Action = Result.BestAction;
+            bHasAction = Result.bHasAction;
+        }
+        else
+        {
+            FBattleSearchSettings SearchSettings;
+            SearchSettings.MaxDepth = Settings.SearchMaxDepth;
+            SearchSettings.TimeBudgetSeconds = Budget;
+            SearchSettings.CancelFlag = &bCancelled;
+            SearchSettings.TranspositionTable = Settings.TranspositionTable.Get();
+
+            const FBattleSearchResult Result = Search.FindBestAction(Plan, SearchSettings);
+            UE_LOG(LogSNAI, Log, TEXT("AI search: depth %d, %lld nodes, score %d, table hit rate %.2f"),
+                Result.CompletedDepth, Result.NodesSearched, Result.Score, Result.TableStats.GetHitRate());
+            CountStatesEvaluated(Result.NodesSearched);
+
+            Action = Result.BestAction;
+            bHasAction = Result.bHasAction;
+        }
+
+        if (bCancelled.load(std::memory_order_relaxed))
+        {
+            OutCommands.Reset();
+            return;
+        }
+
+        if (!bHasAction)
+            break;
+
+        OutCommands.Add(Action);
+
+        FBattleUndo Undo;
+        Plan.ApplyAction(Board, Action, GetExpectedOutcome(Board, Plan, Action), Undo);
+    }
+}
+
+/**
+ * @brief The average dice result of an action: mean damage and, if it applies, the target's mean counter.
+ * @param Board The board whose archetype table gives the damage ranges.
+ * @param State The state before the action.
+ * @param Action The action to resolve.
+ * @return The outcome to plan against.
+ */
+FBattleOutcome FBattleAIPlanner::GetExpectedOutcome(const FBattleBoard& Board, const FBattleState& State, const FBattleAction& Action)
+{
+    FBattleOutcome Outcome;
+    if (Action.HasAttack())
+    {
+        const FBattleUnitStats& Stats = Board.GetStats(State.Units[Action.Unit]);
+        const FBattleUnitStats& TargetStats = Board.GetStats(State.Units[Action.Target]);
+        Outcome.Damage = static_cast<int16>((Stats.DamageMin + Stats.DamageMax + 1) / 2);
+        Outcome.CounterDamage = static_cast<int16>((TargetStats.CounterDamageMin + TargetStats.CounterDamageMax + 1) / 2);
+    }
+    return Outcome;
+}
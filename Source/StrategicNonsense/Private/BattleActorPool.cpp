@@ -0,0 +1,112 @@
+#include "BattleActorPool.h"
+#include "StrategicNonsense.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+/**
+ * @brief Logs how many spawns the pool saved; the world destroys the pooled actors itself.
+ */
+void UBattleActorPool::Deinitialize()
+{
+    UE_LOG(LogSNGrid, Log, TEXT("Actor pool: %d spawned, %d reused."), NumSpawned, NumReused);
+    FreeActors.Reset();
+
+    Super::Deinitialize();
+}
+
+/**
+ * @brief The pool of WorldContextObject's world.
+ * @return The pool, or nullptr if the object has no world.
+ */
+UBattleActorPool* UBattleActorPool::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UBattleActorPool>() : nullptr;
+}
+
+/**
+ * @brief Hands out an actor of Class at Transform, reusing a released one when possible.
+ *
+ * A new actor is spawned deferred, so Prepare runs before its BeginPlay. A reused actor is moved
+ * to Transform, passed to Prepare, shown again and then told through IBattlePooledActor.
+ *
+ * @param Class The exact class wanted; released subclasses are not handed out for a parent class.
+ * @param Transform Where the actor goes.
+ * @param Prepare Sets up the actor before it becomes active (e.g. seeds it).
+ * @return The actor, or nullptr if spawning failed.
+ */
+AActor* UBattleActorPool::Acquire(UClass* Class, const FTransform& Transform, TFunctionRef<void(AActor*)> Prepare)
+{
+    if (!Class)
+        return nullptr;
+
+    FBattleActorPoolList* List = FreeActors.Find(Class);
+    while (List && !List->Actors.IsEmpty())
+    {
+        AActor* Actor = List->Actors.Pop(EAllowShrinking::No);
+        if (!IsValid(Actor))
+            continue;
+
+        Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+        Prepare(Actor);
+
+        Actor->SetActorHiddenInGame(false);
+        Actor->SetActorEnableCollision(true);
+        Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+
+        if (IBattlePooledActor* Pooled = Cast<IBattlePooledActor>(Actor))
+        {
+            Pooled->OnReactivated();
+        }
+
+        ++NumReused;
+        return Actor;
+    }
+
+    AActor* Actor = GetWorld()->SpawnActorDeferred<AActor>(Class, Transform);
+    if (!Actor)
+        return nullptr;
+
+    Prepare(Actor);
+    Actor->FinishSpawning(Transform);
+
+    ++NumSpawned;
+    return Actor;
+}
+
+/**
+ * @brief Deactivates an actor and keeps it for the next Acquire of its class.
+ *
+ * Releasing an actor that is already free does nothing.
+ *
+ * @param Actor The actor to park; it must no longer be referenced by gameplay code.
+ */
+void UBattleActorPool::Release(AActor* Actor)
+{
+    if (!IsValid(Actor))
+        return;
+
+    FBattleActorPoolList& List = FreeActors.FindOrAdd(Actor->GetClass());
+    if (List.Actors.Contains(Actor))
+        return;
+
+    if (IBattlePooledActor* Pooled = Cast<IBattlePooledActor>(Actor))
+    {
+        Pooled->OnDeactivated();
+    }
+
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    Actor->SetActorTickEnabled(false);
+
+    List.Actors.Add(Actor);
+}
+
+/**
+ * @brief Number of released actors of exactly Class.
+ */
+int32 UBattleActorPool::GetNumFree(UClass* Class) const
+{
+    const FBattleActorPoolList* List = FreeActors.Find(Class);
+    return List ? List->Actors.Num() : 0;
+}
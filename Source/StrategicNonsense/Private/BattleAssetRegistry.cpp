@@ -0,0 +1,243 @@
+#include "BattleAssetRegistry.h"
+#include "StrategicNonsense.h"
+#include "UnitArchetype.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/DataTable.h"
+#include "Engine/GameInstance.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/GameplayStatics.h"
+
+namespace
+{
+    /** Class paths of the widget blueprints, indexed by EBattleWidget. */
+    const TCHAR* const GWidgetClassPaths[] = {
+        TEXT("/Game/Blueprints/WBP_StartMessage.WBP_StartMessage_C"),
+        TEXT("/Game/Blueprints/WBP_UnitSelectionWidget.WBP_UnitSelectionWidget_C"),
+        TEXT("/Game/Blueprints/WBP_GameStatus.WBP_GameStatus_C"),
+        TEXT("/Game/Blueprints/WBP_EndTurnWidget.WBP_EndTurnWidget_C"),
+        TEXT("/Game/Blueprints/WBP_GameOver.WBP_GameOver_C"),
+    };
+    static_assert(UE_ARRAY_COUNT(GWidgetClassPaths) == static_cast<int32>(EBattleWidget::Count), "Missing path for a widget");
+
+    const TCHAR* const GUnitArchetypeTablePath = TEXT("/Game/Data/DT_UnitArchetypes.DT_UnitArchetypes");
+}
+
+/**
+ * @brief Starts streaming every widget class, so they are in memory before the first match needs them.
+ */
+void UBattleAssetRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    TArray<FSoftObjectPath> Paths;
+    for (int32 Index = 0; Index < static_cast<int32>(EBattleWidget::Count); ++Index)
+    {
+        Paths.Add(GetWidgetClassPath(static_cast<EBattleWidget>(Index)));
+    }
+    RequestAsyncLoad(MoveTemp(Paths), FSimpleDelegate());
+}
+
+/**
+ * @brief Cancels requests still in flight.
+ */
+void UBattleAssetRegistry::Deinitialize()
+{
+    for (const TSharedPtr<FStreamableHandle>& Handle : PendingHandles)
+    {
+        Handle->CancelHandle();
+    }
+    PendingHandles.Reset();
+
+    Super::Deinitialize();
+}
+
+/**
+ * @brief The registry of the game instance that owns WorldContextObject's world.
+ * @return The registry, or nullptr outside a game instance (e.g. commandlets).
+ */
+UBattleAssetRegistry* UBattleAssetRegistry::Get(const UObject* WorldContextObject)
+{
+    const UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(WorldContextObject);
+    return GameInstance ? GameInstance->GetSubsystem<UBattleAssetRegistry>() : nullptr;
+}
+
+/**
+ * @brief Streams the widget classes, both teams' unit classes and the archetype table, then calls OnLoaded.
+ *
+ * OnLoaded runs on the game thread; straight away if everything is already cached.
+ *
+ * @param TeamColours The colours of the teams in the match.
+ * @param OnLoaded Called once every class is in memory.
+ */
+void UBattleAssetRegistry::PreloadMatchAssets(TConstArrayView<FName> TeamColours, FSimpleDelegate OnLoaded)
+{
+    TArray<FSoftObjectPath> Paths;
+    for (int32 Index = 0; Index < static_cast<int32>(EBattleWidget::Count); ++Index)
+    {
+        Paths.Add(GetWidgetClassPath(static_cast<EBattleWidget>(Index)));
+    }
+    for (FName Colour : TeamColours)
+    {
+        Paths.Add(GetUnitClassPath(Colour, EGameUnitType::Sniper));
+        Paths.Add(GetUnitClassPath(Colour, EGameUnitType::Brawler));
+    }
+    if (!bUnitArchetypeTableMissing)
+    {
+        Paths.Add(GetUnitArchetypeTablePath());
+    }
+
+    RequestAsyncLoad(MoveTemp(Paths), MoveTemp(OnLoaded));
+}
+
+/**
+ * @brief The widget blueprint class, from the cache.
+ */
+TSubclassOf<UUserWidget> UBattleAssetRegistry::GetWidgetClass(EBattleWidget Widget)
+{
+    UClass* Class = ResolveClass(GetWidgetClassPath(Widget));
+    return (Class && Class->IsChildOf(UUserWidget::StaticClass())) ? Class : nullptr;
+}
+
+/**
+ * @brief A team's unit blueprint class, from the cache.
+ * @param TeamColour The team's colour (part of the blueprint name).
+ * @param UnitType Sniper or Brawler.
+ */
+TSubclassOf<AUnitActor> UBattleAssetRegistry::GetUnitClass(FName TeamColour, EGameUnitType UnitType)
+{
+    UClass* Class = ResolveClass(GetUnitClassPath(TeamColour, UnitType));
+    return (Class && Class->IsChildOf(AUnitActor::StaticClass())) ? Class : nullptr;
+}
+
+/**
+ * @brief Copies the unit archetype DataTable into FBattleArchetypeTable.
+ *
+ * Rows start from the built-in table, so a DataTable may override Sniper and Brawler, add new
+ * archetypes, or both. Rows with an invalid or duplicate ArchetypeId, or out-of-range stats, are
+ * skipped with an error. Loads the table synchronously (and warns) if it was never preloaded;
+ * without a table the built-in stats are published.
+ */
+void UBattleAssetRegistry::PublishUnitArchetypes()
+{
+    if (!UnitArchetypeTable && !bUnitArchetypeTableMissing)
+    {
+        UE_LOG(LogSNGame, Warning, TEXT("%s was not preloaded; loading it synchronously."), GUnitArchetypeTablePath);
+        UnitArchetypeTable = Cast<UDataTable>(GetUnitArchetypeTablePath().TryLoad());
+        if (!UnitArchetypeTable)
+        {
+            UE_LOG(LogSNGame, Warning, TEXT("No unit archetype table at %s; using the built-in unit stats."), GUnitArchetypeTablePath);
+            bUnitArchetypeTableMissing = true;
+        }
+    }
+
+    FBattleArchetypeTable Table = FBattleArchetypeTable::GetBuiltIn();
+    if (UnitArchetypeTable)
+    {
+        uint64 SeenIds = 0;
+        UnitArchetypeTable->ForeachRow<FUnitArchetypeRow>(TEXT("PublishUnitArchetypes"),
+            [&Table, &SeenIds](const FName& RowName, const FUnitArchetypeRow& Row)
+            {
+                FBattleUnitStats Stats;
+                const uint64 IdBit = 1ull << (Row.ArchetypeId & 63);
+                if ((SeenIds & IdBit) != 0 || !Row.ToStats(Stats) || !Table.SetStats(Row.ArchetypeId, Stats))
+                {
+                    UE_LOG(LogSNGame, Error, TEXT("Unit archetype %s (id %d) is a duplicate or out of range; skipped."), *RowName.ToString(), Row.ArchetypeId);
+                    return;
+                }
+                SeenIds |= IdBit;
+            });
+    }
+
+    FBattleArchetypeTable::Publish(Table);
+    UE_LOG(LogSNGame, Log, TEXT("Published %d unit archetypes."), Table.Num());
+}
+
+FSoftClassPath UBattleAssetRegistry::GetWidgetClassPath(EBattleWidget Widget)
+{
+    return FSoftClassPath(GWidgetClassPaths[static_cast<int32>(Widget)]);
+}
+
+FSoftClassPath UBattleAssetRegistry::GetUnitClassPath(FName TeamColour, EGameUnitType UnitType)
+{
+    const TCHAR* Kind = (UnitType == EGameUnitType::Sniper) ? TEXT("Sniper") : TEXT("Brawler");
+    const FString Colour = TeamColour.ToString();
+    return FSoftClassPath(FString::Printf(TEXT("/Game/Blueprints/BP_%s_%s.BP_%s_%s_C"), Kind, *Colour, Kind, *Colour));
+}
+
+FSoftObjectPath UBattleAssetRegistry::GetUnitArchetypeTablePath()
+{
+    return FSoftObjectPath(GUnitArchetypeTablePath);
+}
+
+/**
+ * @brief Streams the paths that are not cached yet; caches the classes and calls OnLoaded when done.
+ */
+void UBattleAssetRegistry::RequestAsyncLoad(TArray<FSoftObjectPath> Paths, FSimpleDelegate OnLoaded)
+{
+    Paths.RemoveAll([this](const FSoftObjectPath& Path) { return LoadedClasses.Contains(Path) || (UnitArchetypeTable && Path == GetUnitArchetypeTablePath()); });
+    if (Paths.IsEmpty())
+    {
+        OnLoaded.ExecuteIfBound();
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(Paths,
+        FStreamableDelegate::CreateWeakLambda(this, [this, Paths, OnLoaded, StartTime]()
+        {
+            for (const FSoftObjectPath& Path : Paths)
+            {
+                UObject* Object = Path.ResolveObject();
+                if (UClass* Class = Cast<UClass>(Object))
+                {
+                    LoadedClasses.Add(Path, Class);
+                }
+                else if (UDataTable* Table = Cast<UDataTable>(Object))
+                {
+                    UnitArchetypeTable = Table;
+                }
+                else if (Path == GetUnitArchetypeTablePath())
+                {
+                    UE_LOG(LogSNGame, Warning, TEXT("No unit archetype table at %s; using the built-in unit stats."), *Path.ToString());
+                    bUnitArchetypeTableMissing = true;
+                }
+                else
+                {
+                    UE_LOG(LogSNGame, Error, TEXT("Failed to load %s"), *Path.ToString());
+                }
+            }
+
+            PendingHandles.RemoveAll([](const TSharedPtr<FStreamableHandle>& Pending) { return Pending->HasLoadCompleted() || Pending->WasCanceled(); });
+
+            UE_LOG(LogSNGame, Log, TEXT("Streamed %d classes in %.1f ms"), Paths.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+            OnLoaded.ExecuteIfBound();
+        }),
+        FStreamableManager::AsyncLoadHighPriority);
+
+    if (Handle.IsValid() && !Handle->HasLoadCompleted())
+    {
+        PendingHandles.Add(Handle);
+    }
+}
+
+/**
+ * @brief The cached class for a path; loads it synchronously (and warns) if it was never preloaded.
+ */
+UClass* UBattleAssetRegistry::ResolveClass(const FSoftClassPath& Path)
+{
+    if (const TObjectPtr<UClass>* Cached = LoadedClasses.Find(Path))
+        return *Cached;
+
+    UClass* Class = Path.ResolveClass();
+    if (!Class)
+    {
+        UE_LOG(LogSNGame, Warning, TEXT("%s was not preloaded; loading it synchronously."), *Path.ToString());
+        Class = Path.TryLoadClass<UObject>();
+    }
+
+    if (Class)
+    {
+        LoadedClasses.Add(Path, Class);
+    }
+    return Class;
+}
@@ -1,4 +1,5 @@
 #include "BattleGameMode.h"
+#include "StrategicNonsense.h"
 #include "GridManager.h"
 #include "GridCameraActor.h"
 #include "Kismet/GameplayStatics.h"
@@ -15,48 +16,163 @@
 #include "EndTurnWidget.h"
 #include "GameOverWidget.h"
 #include "CombatManager.h"
+#include "BattleState.h"
+#include "BattleAIPlanner.h"
+#include "BattleTranspositionTable.h"
+#include "BattleAssetRegistry.h"
+#include "Tasks/Task.h"
+#include "Async/Async.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+DECLARE_CYCLE_STAT(TEXT("HandleAITurn"), STAT_SNHandleAITurn, STATGROUP_StrategicNonsense);
+DECLARE_CYCLE_STAT(TEXT("StartAIPlanning"), STAT_SNStartAIPlanning, STATGROUP_StrategicNonsense);
+DECLARE_CYCLE_STAT(TEXT("ExecuteAIAction"), STAT_SNExecuteAIAction, STATGROUP_StrategicNonsense);
+DECLARE_CYCLE_STAT(TEXT("SpawnGameStatusWidget"), STAT_SNSpawnGameStatusWidget, STATGROUP_StrategicNonsense);
+DECLARE_CYCLE_STAT(TEXT("UpdateGameStatusWidget"), STAT_SNUpdateGameStatusWidget, STATGROUP_StrategicNonsense);
+
+static_assert(static_cast<uint8>(EGameUnitType::Sniper) == static_cast<uint8>(EBattleArchetype::Sniper) &&
+    static_cast<uint8>(EGameUnitType::Brawler) == static_cast<uint8>(EBattleArchetype::Brawler),
+    "EBattleArchetype must mirror EGameUnitType");
 
 
 /**
- * @brief Constructor that sets up the player controller class and loads the GameOver widget class.
+ * @brief Constructor that sets up the player controller class.
+ *
+ * Widget classes come from UBattleAssetRegistry, which streams them in the background.
  */
 ABattleGameMode::ABattleGameMode()
 {
     PlayerControllerClass = ABattlePlayerController::StaticClass();
-
-    FString WidgetPath = TEXT("/Game//Blueprints/WBP_GameOver.WBP_GameOver_C");
-    TSubclassOf<UGameOverWidget> GameOverWidgetClassLoaded = Cast<UClass>(StaticLoadClass(UUserWidget::StaticClass(), nullptr, *WidgetPath));
-
-    if (GameOverWidgetClassLoaded)
-    {
-        GameOverWidgetClass = GameOverWidgetClassLoaded;
-    }
-    else
-    {
-        UE_LOG(LogTemp, Error, TEXT("Failed to load GameOverWidget class!"));
-    }
-
 }
 
 /**
- * @brief Called when the game begins. Spawns the camera and grid, initialises combat and unit placement managers, and starts team setup.
+ * @brief Called when the game begins. Spawns the camera and grid, initialises the combat manager, and starts the first match.
  */
 void ABattleGameMode::BeginPlay()
 {
     Super::BeginPlay();
+    MatchRandom.InitialiseFromCommandLine(FCommandLine::Get());
     SpawnTopDownCamera();
     SpawnGridAndSetup();
 
     CombatManager = NewObject<UCombatManager>(this);
-    CombatManager->Initialise(SpawnedGridManager);
+    CombatManager->Initialise(SpawnedGridManager, MatchRandom.Combat());
 
+    BeginMatch();
+}
 
+/**
+ * @brief Tosses for the starting side, sets up the teams and replay, and starts unit placement.
+ *
+ * The placement manager publishes the unit archetype table once it has streamed in, before the
+ * first unit is placed. Expects the grid and its obstacles to be in place already.
+ */
+void ABattleGameMode::BeginMatch()
+{
+    CurrentPhase = EGamePhase::Placement;
     DecideStartingPlayer();
     SetupTeams();
+    StartReplay();
     UnitPlacementManager = NewObject<UUnitPlacementManager>(this);
     UnitPlacementManager->Initialise(this, SpawnedGridManager, AllTeams, bPlayerStarts);
 }
 
+/**
+ * @brief Ends the current match and starts the next one in the same world.
+ *
+ * The grid is regenerated in place, so the previous match's cells, obstacles and units go back
+ * to the actor pool and are handed out again by the new layout and placement. The next match
+ * seed follows from the current one, so a series started with -MatchSeed= is reproducible.
+ * Ignored during placement, whose timers still refer to the current teams.
+ */
+void ABattleGameMode::RestartMatch()
+{
+    if (CurrentPhase == EGamePhase::Placement)
+    {
+        UE_LOG(LogSNGame, Warning, TEXT("Cannot restart the match while units are being placed."));
+        return;
+    }
+
+    CancelAIPlanning();
+    SaveReplay();
+    GetWorldTimerManager().ClearAllTimersForObject(this);
+    bResumeAIOnUnpause = false;
+
+    // A cancelled plan may still be storing into the old table; the next plan gets a fresh one
+    AITranspositionTable.Reset();
+
+    if (GameOverWidget)
+    {
+        GameOverWidget->RemoveFromParent();
+        GameOverWidget = nullptr;
+    }
+    if (GameStatusWidget)
+    {
+        GameStatusWidget->RemoveFromParent();
+        GameStatusWidget = nullptr;
+    }
+
+    if (ABattlePlayerController* PlayerController = Cast<ABattlePlayerController>(UGameplayStatics::GetPlayerController(this, 0)))
+    {
+        PlayerController->ClearSelection();
+        PlayerController->HideEndTurnWidget();
+        PlayerController->SetPause(false);
+    }
+
+    MatchRandom.Initialise(static_cast<int32>(static_cast<uint32>(MatchRandom.GetMatchSeed()) + 1));
+    UE_LOG(LogSNGame, Log, TEXT("Restarting with match seed %d."), MatchRandom.GetMatchSeed());
+
+    SpawnGridAndSetup();
+    BeginMatch();
+}
+
+/**
+ * @brief Cancels any AI planning still running before the world goes away.
+ */
+void ABattleGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    CancelAIPlanning();
+    SaveReplay();
+    Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * @brief Pauses the game; an AI turn in progress is cancelled and replanned on unpause.
+ */
+bool ABattleGameMode::SetPause(APlayerController* PC, FCanUnpause CanUnpauseDelegate)
+{
+    const bool bPaused = Super::SetPause(PC, CanUnpauseDelegate);
+
+    if (bPaused && CurrentPhase == EGamePhase::AITurn && (AIPlanCancelFlag.IsValid() || !AICommandQueue.IsEmpty()))
+    {
+        CancelAIPlanning();
+        bResumeAIOnUnpause = true;
+    }
+
+    return bPaused;
+}
+
+/**
+ * @brief Unpauses the game and resumes an AI turn that the pause cancelled.
+ */
+bool ABattleGameMode::ClearPause()
+{
+    const bool bCleared = Super::ClearPause();
+
+    if (bCleared && bResumeAIOnUnpause)
+    {
+        bResumeAIOnUnpause = false;
+        if (CurrentPhase == EGamePhase::AITurn)
+        {
+            StartAIPlanning();
+        }
+    }
+
+    return bCleared;
+}
+
 /**
  * @brief Spawns a fixed top-down camera above the grid.
  */
@@ -68,7 +184,7 @@ void ABattleGameMode::SpawnTopDownCamera()
 }
 
 /**
- * @brief Spawns the grid manager, generates the grid, and places obstacles.
+ * @brief Spawns the grid manager (first match only), generates the grid, and places obstacles.
  */
 void ABattleGameMode::SpawnGridAndSetup()
 
@@ -76,11 +192,14 @@ void ABattleGameMode::SpawnGridAndSetup()
     FVector Location(0.f, 0.f, 0.f);
     FRotator Rotation(0.f, 0.f, 0.f);
 
-    SpawnedGridManager = GetWorld()->SpawnActor<AGridManager>(Location, Rotation);
+    if (!SpawnedGridManager)
+    {
+        SpawnedGridManager = GetWorld()->SpawnActor<AGridManager>(Location, Rotation);
+    }
     if (!SpawnedGridManager) return;
 
     SpawnedGridManager->GenerateGrid();
-    SpawnedGridManager->PlaceObstacles();
+    SpawnedGridManager->PlaceObstacles(MatchRandom.Map());
 }
 
 /**
@@ -88,7 +207,7 @@ void ABattleGameMode::SpawnGridAndSetup()
  */
 void ABattleGameMode::DecideStartingPlayer()
 {
-    bPlayerStarts = FMath::RandBool();
+    bPlayerStarts = MatchRandom.Map().RandBool();
 }
 
 /**
@@ -100,7 +219,7 @@ void ABattleGameMode::SetupTeams()
 
     for (int32 i = AvailableColours.Num() - 1; i > 0; --i)
     {
-        int32 j = FMath::RandRange(0, i);
+        int32 j = MatchRandom.Map().RandRange(0, i);
         AvailableColours.Swap(i, j);
     }
 
@@ -108,15 +227,16 @@ void ABattleGameMode::SetupTeams()
     FName Colour2 = AvailableColours[1];
 
     Team1 = NewObject<UTeam>(this);
-    Team1->Initialise(Colour1, true);
+    Team1->Initialise(Colour1, true, 0, SpawnedGridManager);
 
     Team2 = NewObject<UTeam>(this);
-    Team2->Initialise(Colour2, false);
+    Team2->Initialise(Colour2, false, 1, SpawnedGridManager);
 
+    AllTeams.Reset();
     AllTeams.Add(Team1);
     AllTeams.Add(Team2);
 
-    UE_LOG(LogTemp, Warning, TEXT("Selected Teams: %s for player and %s for AI"), *Colour1.ToString(), *Colour2.ToString());
+    UE_LOG(LogSNPlacement, Log, TEXT("Selected Teams: %s for player and %s for AI"), *Colour1.ToString(), *Colour2.ToString());
 }
 
 /**
@@ -138,6 +258,18 @@ void ABattleGameMode::OnPlayerClickedGrid(const FVector& ClickLocation)
  */
 void ABattleGameMode::SetGamePhase(EGamePhase NewPhase)
 {
+    if (NewPhase != EGamePhase::AITurn)
+    {
+        CancelAIPlanning();
+    }
+
+    const bool bTurnPassed = (CurrentPhase == EGamePhase::PlayerTurn && NewPhase == EGamePhase::AITurn) ||
+        (CurrentPhase == EGamePhase::AITurn && NewPhase == EGamePhase::PlayerTurn);
+    if (bTurnPassed && bRecordReplays)
+    {
+        Replay.Commands.Add(FBattleReplayCommand::MakeEndTurn());
+    }
+
     CurrentPhase = NewPhase;
 
     UTeam* PlayerTeam = GetPlayerTeam();
@@ -151,23 +283,23 @@ void ABattleGameMode::SetGamePhase(EGamePhase NewPhase)
         if (PlayerTeam)
         {
             PlayerTeam->ResetUnitsForNewTurn();
-            UE_LOG(LogTemp, Warning, TEXT("Player units reset for new turn."));
+            UE_LOG(LogSNGame, Verbose, TEXT("Player units reset for new turn."));
         }
 
         if (PlayerController)
         {
-            // Load and show EndTurn widget
+            // Show the EndTurn widget, from the preloaded classes
             if (!PlayerController->EndTurnWidgetClass)
             {
-                FString WidgetPath = TEXT("/Game/Blueprints/WBP_EndTurnWidget.WBP_EndTurnWidget_C");
-                TSubclassOf<UEndTurnWidget> LoadedClass = Cast<UClass>(StaticLoadClass(UUserWidget::StaticClass(), nullptr, *WidgetPath));
+                UBattleAssetRegistry* Assets = UBattleAssetRegistry::Get(this);
+                TSubclassOf<UUserWidget> LoadedClass = Assets ? Assets->GetWidgetClass(EBattleWidget::EndTurn) : nullptr;
                 if (LoadedClass)
                 {
-                    PlayerController->EndTurnWidgetClass = LoadedClass;
+                    PlayerController->EndTurnWidgetClass = *LoadedClass;
                 }
                 else
                 {
-                    UE_LOG(LogTemp, Error, TEXT("Failed to load EndTurnWidget class!"));
+                    UE_LOG(LogSNGame, Error, TEXT("Failed to load EndTurnWidget class!"));
                 }
             }
 
@@ -179,7 +311,7 @@ void ABattleGameMode::SetGamePhase(EGamePhase NewPhase)
         if (AITeam)
         {
             AITeam->ResetUnitsForNewTurn();
-            UE_LOG(LogTemp, Warning, TEXT("AI units reset for new turn."));
+            UE_LOG(LogSNAI, Verbose, TEXT("AI units reset for new turn."));
 
             FTimerHandle AITimer;
             GetWorld()->GetTimerManager().SetTimer(AITimer, this, &ABattleGameMode::HandleAITurn, 0.6f, false);
@@ -222,71 +354,418 @@ UTeam* ABattleGameMode::GetAITeam() const
 }
 
 /**
- * @brief Executes the AI turn logic: moves units randomly and performs attacks if in range.
- * Ends the turn and transitions back to the player.
+ * @brief Starts the AI turn with the selected engine.
+ *
+ * The random engine plays synchronously and hands the turn straight back; the search engines
+ * plan on a background task and the turn continues once the plan arrives.
  */
 void ABattleGameMode::HandleAITurn()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(ABattleGameMode::HandleAITurn);
+    SCOPE_CYCLE_COUNTER(STAT_SNHandleAITurn);
+
     UTeam* AITeam = GetAITeam();
     if (!AITeam || !SpawnedGridManager || !CombatManager)
     {
-        UE_LOG(LogTemp, Error, TEXT("Cannot run AI turn - missing team, grid, or combat manager."));
+        UE_LOG(LogSNAI, Error, TEXT("Cannot run AI turn - missing team, grid, or combat manager."));
         return;
     }
 
-    TArray<AUnitActor*> Units = AITeam->GetControlledUnits();
+    switch (AIEngine)
+    {
+    case EAIEngine::Expectiminimax:
+    case EAIEngine::MonteCarlo:
+        StartAIPlanning();
+        return;
+
+    default:
+        RunApproachAITurn();
+        break;
+    }
+
+    if (CurrentPhase == EGamePhase::GameOver)
+        return;
+
+    // End AI turn and go back to player
+    SetGamePhase(EGamePhase::PlayerTurn);
+}
+
+/**
+ * @brief Moves each AI unit toward the nearest cell it can attack from and attacks the first enemy in range.
+ *
+ * One attack-position field per attack range and line-of-sight rule is shared by every unit of the turn; the grid repairs
+ * them as units move. Each unit picks randomly among its reachable cells closest to an attack
+ * position, or among all reachable cells when no attack position can be reached.
+ */
+void ABattleGameMode::RunApproachAITurn()
+{
+    // Team membership is fixed once placement ends, so both lists stay valid while units move and fall
+    const FBattleUnitRegistry& Registry = SpawnedGridManager->GetUnitRegistry();
+    TConstArrayView<int32> UnitIds = Registry.GetTeamUnits(GetAITeam()->GetTeamIndex());
+    TConstArrayView<int32> TargetIds = Registry.GetTeamUnits(GetPlayerTeam()->GetTeamIndex());
+
+    TMap<int32, TSharedPtr<FGridDistanceField>> AttackFields;
+    auto GetAttackField = [this, &Registry, TargetIds, &AttackFields](int32 AttackRange, EAttackType AttackType) -> const FGridDistanceField&
+    {
+        // Attack types that share the line-of-sight rule share a field
+        const bool bNeedsSight = SpawnedGridManager->RequiresLineOfSight(AttackType);
+        TSharedPtr<FGridDistanceField>& Field = AttackFields.FindOrAdd(AttackRange * 2 + (bNeedsSight ? 1 : 0));
+        if (!Field.IsValid())
+        {
+            TArray<FIntPoint> Targets;
+            for (int32 TargetId : TargetIds)
+            {
+                if (Registry.IsAlive(TargetId))
+                {
+                    Targets.Add(Registry.GetCell(TargetId));
+                }
+            }
+            Field = SpawnedGridManager->ComputeAttackPositionField(Targets, AttackRange, AttackType);
+        }
+        return *Field;
+    };
 
-    for (AUnitActor* Unit : Units)
+    TArray<FIntPoint> Candidates;
+
+    for (int32 UnitId : UnitIds)
     {
-        if (!Unit || Unit->HasMovedThisTurn())
+        // Fallen units keep their registry entry
+        if (!Registry.IsAlive(UnitId) || (Registry.GetFlags(UnitId) & FBattleUnit::Flag_Moved) != 0)
+            continue;
+
+        AUnitActor* Unit = SpawnedGridManager->GetRegisteredUnit(UnitId);
+        if (!Unit)
             continue;
 
-        // Random movement
         FIntPoint Current = Unit->GetGridPosition();
         int32 Range = Unit->GetMovementRange();
-        TSet<FIntPoint> Reachable = SpawnedGridManager->FindReachableCellsBFS(Current, Range);
+        TConstArrayView<FIntPoint> Reachable = SpawnedGridManager->GetReachableCells(Current, Range);
 
         if (Reachable.Num() == 0)
             continue;
 
-        TArray<FIntPoint> ReachableArray = Reachable.Array();
-        int32 RandIndex = FMath::RandRange(0, ReachableArray.Num() - 1);
-        FIntPoint Destination = ReachableArray[RandIndex];
+        // Approach: keep the reachable cells nearest to an attack position
+        const FGridDistanceField& Field = GetAttackField(Unit->GetAttackRange(), Unit->GetAttackType());
+        int32 BestDistance = MAX_int32;
+        Candidates.Reset();
+        for (const FIntPoint& Cell : Reachable)
+        {
+            const int32 Distance = Field.GetDistance(SpawnedGridManager->GetOccupancy(), Cell);
+            if (Distance == INDEX_NONE || Distance > BestDistance)
+                continue;
 
-        SpawnedGridManager->SetUnitAtCell(Current, nullptr);
-        SpawnedGridManager->SetUnitAtCell(Destination, Unit);
-        Unit->SetGridPosition(Destination);
-        Unit->SetActorLocation(SpawnedGridManager->GridToWorld(Destination));
-        Unit->MarkAsMoved();
+            if (Distance < BestDistance)
+            {
+                BestDistance = Distance;
+                Candidates.Reset();
+            }
+            Candidates.Add(Cell);
+        }
 
-        UE_LOG(LogTemp, Warning, TEXT("AI moved %s to (%d, %d)"), *Unit->GetName(), Destination.X, Destination.Y);
+        TConstArrayView<FIntPoint> Choices = Candidates.IsEmpty() ? Reachable : TConstArrayView<FIntPoint>(Candidates);
+        FIntPoint Destination = Choices[MatchRandom.AI().RandRange(0, Choices.Num() - 1)];
 
         // Try to attack after moving
-        TArray<AUnitActor*> EnemyUnits = GetPlayerTeam()->GetControlledUnits();
-        for (AUnitActor* Target : EnemyUnits)
+        AUnitActor* ChosenTarget = nullptr;
+        for (int32 TargetId : TargetIds)
         {
-            if (!Target || Target->IsDead()) continue;
-
-            FIntPoint From = Unit->GetGridPosition();
-            FIntPoint To = Target->GetGridPosition();
-            int32 Distance = FMath::Abs(From.X - To.X) + FMath::Abs(From.Y - To.Y);
+            if (!Registry.IsAlive(TargetId)) continue;
 
-            if (Distance <= Unit->GetAttackRange())
+            if (SpawnedGridManager->CanAttackFrom(Unit, Destination, Registry.GetCell(TargetId)))
             {
-                if (CombatManager->ExecuteAttack(Unit, Target))
-                {
-                    CheckGameEnd(); 
-                }
-
+                ChosenTarget = SpawnedGridManager->GetRegisteredUnit(TargetId);
                 break; // Attack once per turn
             }
         }
+
+        ExecuteAIAction(Unit, Destination, ChosenTarget);
+
+        if (CurrentPhase == EGamePhase::GameOver)
+            return;
+
+        // A fallen target's attack positions are stale; rebuild the fields on next use
+        if (ChosenTarget && ChosenTarget->IsDead())
+        {
+            AttackFields.Reset();
+        }
+    }
+}
+
+/**
+ * @brief Snapshots the board and plans the rest of the AI turn on a background task.
+ *
+ * The game thread keeps running while the search thinks; the plan comes back through
+ * OnAIPlanReady. Any plan still in flight is cancelled first.
+ */
+void ABattleGameMode::StartAIPlanning()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(ABattleGameMode::StartAIPlanning);
+    SCOPE_CYCLE_COUNTER(STAT_SNStartAIPlanning);
+
+    CancelAIPlanning();
+
+    FBattleBoard Board;
+    FBattleState State;
+    TArray<AUnitActor*> Slots;
+    CaptureBattleState(Board, State, Slots);
+
+    AIPlanSlots.Reset(Slots.Num());
+    for (AUnitActor* Unit : Slots)
+    {
+        AIPlanSlots.Add(Unit);
+    }
+
+    FBattleAIPlannerSettings Settings;
+    Settings.bUseMonteCarlo = AIEngine == EAIEngine::MonteCarlo;
+    Settings.TurnBudgetSeconds = AITurnBudgetMs / 1000.0;
+    Settings.SearchMaxDepth = AISearchMaxDepth;
+    Settings.MonteCarloWorkers = AIMonteCarloWorkers;
+    Settings.Seed = static_cast<int32>(MatchRandom.AI().GetUnsignedInt());
+
+    if (AIEngine == EAIEngine::Expectiminimax)
+    {
+        if (!AITranspositionTable.IsValid())
+        {
+            AITranspositionTable = MakeShared<FBattleTranspositionTable, ESPMode::ThreadSafe>(AITranspositionTableMB);
+        }
+        Settings.TranspositionTable = AITranspositionTable;
+    }
+
+    TSharedRef<std::atomic<bool>, ESPMode::ThreadSafe> CancelFlag = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+    AIPlanCancelFlag = CancelFlag;
+
+    TWeakObjectPtr<ABattleGameMode> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, CancelFlag, Settings, Board = MoveTemp(Board), State]()
+    {
+        TArray<FBattleAction> Commands;
+        FBattleAIPlanner::PlanTurn(Board, State, Settings, *CancelFlag, Commands);
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, CancelFlag, Commands = MoveTemp(Commands)]()
+        {
+            ABattleGameMode* GameMode = WeakThis.Get();
+            if (GameMode && !CancelFlag->load())
+            {
+                GameMode->OnAIPlanReady(Commands);
+            }
+        });
+    });
+}
+
+/**
+ * @brief Stops the planning task in flight (its result is dropped) and discards queued commands.
+ */
+void ABattleGameMode::CancelAIPlanning()
+{
+    if (AIPlanCancelFlag.IsValid())
+    {
+        AIPlanCancelFlag->store(true);
+        AIPlanCancelFlag.Reset();
+    }
+
+    AICommandQueue.Reset();
+
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(AICommandTimer);
+    }
+}
+
+/**
+ * @brief Queues a finished plan as actor-bound commands and starts applying them.
+ * @param Commands The planned actions, in snapshot slot indices.
+ */
+void ABattleGameMode::OnAIPlanReady(const TArray<FBattleAction>& Commands)
+{
+    AIPlanCancelFlag.Reset();
+
+    if (CurrentPhase != EGamePhase::AITurn)
+        return;
+
+    AICommandQueue.Reset(Commands.Num());
+    for (const FBattleAction& Action : Commands)
+    {
+        FQueuedAICommand& Command = AICommandQueue.AddDefaulted_GetRef();
+        Command.Unit = AIPlanSlots[Action.Unit];
+        Command.Destination = Action.GetDestination();
+        if (Action.HasAttack())
+        {
+            Command.Target = AIPlanSlots[Action.Target];
+        }
+    }
+
+    if (AICommandQueue.IsEmpty())
+    {
+        SetGamePhase(EGamePhase::PlayerTurn);
+        return;
+    }
+
+    ExecuteNextAICommand();
+}
+
+/**
+ * @brief Applies the next queued AI command, replanning if the board no longer allows it.
+ *
+ * Later commands were planned against expected dice, so a unit or target may have died since.
+ * Once the queue is empty the turn passes to the player, unless units are still waiting to act.
+ */
+void ABattleGameMode::ExecuteNextAICommand()
+{
+    if (CurrentPhase != EGamePhase::AITurn || AICommandQueue.IsEmpty())
+        return;
+
+    const FQueuedAICommand Command = AICommandQueue[0];
+    AICommandQueue.RemoveAt(0);
+
+    if (!IsAICommandLegal(Command))
+    {
+        UE_LOG(LogSNAI, Log, TEXT("Queued AI command is no longer legal - replanning."));
+        StartAIPlanning();
+        return;
+    }
+
+    ExecuteAIAction(Command.Unit.Get(), Command.Destination, Command.Target.Get());
+
+    if (CurrentPhase != EGamePhase::AITurn)
+        return;
+
+    if (!AICommandQueue.IsEmpty())
+    {
+        GetWorld()->GetTimerManager().SetTimer(AICommandTimer, this, &ABattleGameMode::ExecuteNextAICommand, FMath::Max(AICommandInterval, 0.01f), false);
+        return;
+    }
+
+    if (!GetAITeam()->HasTeamFinishedTurn())
+    {
+        StartAIPlanning();
+        return;
     }
 
     // End AI turn and go back to player
     SetGamePhase(EGamePhase::PlayerTurn);
 }
 
+/**
+ * @brief Checks a queued command against a fresh capture of the live board.
+ * @param Command The command to check.
+ * @return true if the headless rules still allow it.
+ */
+bool ABattleGameMode::IsAICommandLegal(const FQueuedAICommand& Command) const
+{
+    if (!Command.Unit.IsValid() || Command.Unit->IsDead())
+        return false;
+
+    FBattleBoard Board;
+    FBattleState State;
+    TArray<AUnitActor*> Slots;
+    CaptureBattleState(Board, State, Slots);
+
+    FBattleAction Action;
+    Action.Unit = static_cast<int8>(Slots.Find(Command.Unit.Get()));
+    Action.ToX = static_cast<int16>(Command.Destination.X);
+    Action.ToY = static_cast<int16>(Command.Destination.Y);
+
+    if (!Command.Target.IsExplicitlyNull())
+    {
+        const int32 TargetSlot = Command.Target.IsValid() ? Slots.Find(Command.Target.Get()) : INDEX_NONE;
+        if (TargetSlot == INDEX_NONE)
+            return false;
+
+        Action.Target = static_cast<int8>(TargetSlot);
+    }
+
+    FBattleScratch Scratch;
+    return State.IsActionLegal(Board, Action, Scratch);
+}
+
+/**
+ * @brief Applies one AI activation to the live game: move (if the destination differs), then attack.
+ * @param Unit The acting AI unit.
+ * @param Destination The cell to move to (may be the current cell).
+ * @param Target The unit to attack afterwards, or nullptr.
+ */
+void ABattleGameMode::ExecuteAIAction(AUnitActor* Unit, const FIntPoint& Destination, AUnitActor* Target)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(ABattleGameMode::ExecuteAIAction);
+    SCOPE_CYCLE_COUNTER(STAT_SNExecuteAIAction);
+
+    if (!Unit || Unit->IsDead())
+        return;
+
+    const FIntPoint Current = Unit->GetGridPosition();
+    if (Destination != Current)
+    {
+        SpawnedGridManager->SetUnitAtCell(Current, nullptr);
+        SpawnedGridManager->SetUnitAtCell(Destination, Unit);
+        Unit->SetGridPosition(Destination);
+        Unit->SetActorLocation(SpawnedGridManager->GridToWorld(Destination));
+        RecordReplayMove(Unit, Destination);
+
+        UE_LOG(LogSNAI, Verbose, TEXT("AI moved %s to (%d, %d)"), *Unit->GetName(), Destination.X, Destination.Y);
+    }
+    Unit->MarkAsMoved();
+
+    if (Target && CombatManager->ExecuteAttack(Unit, Target))
+    {
+        Unit->MarkAsAttacked();
+        CheckGameEnd();
+    }
+}
+
+
+/**
+ * @brief Copies the live match into the headless battle core.
+ *
+ * Team1 becomes team 0 and Team2 team 1. Only living units are captured; the slot array maps
+ * each battle-state slot back to its actor so decisions can be applied to the live game.
+ *
+ * @param OutBoard Receives the obstacle layout.
+ * @param OutState Receives unit positions, health, turn flags and the side to move.
+ * @param OutSlots Receives the actor for each captured slot.
+ */
+void ABattleGameMode::CaptureBattleState(FBattleBoard& OutBoard, FBattleState& OutState, TArray<AUnitActor*>& OutSlots) const
+{
+    OutState = FBattleState();
+    OutSlots.Reset();
+
+    if (!SpawnedGridManager || !Team1 || !Team2)
+        return;
+
+    OutBoard.InitialiseFromOccupancy(SpawnedGridManager->GetOccupancy());
+    for (EAttackType AttackType : { EAttackType::ShortRange, EAttackType::Ranged })
+    {
+        if (SpawnedGridManager->RequiresLineOfSight(AttackType))
+        {
+            OutBoard.LineOfSightAttackTypes |= 1 << static_cast<uint8>(AttackType);
+        }
+    }
+
+    // Straight from the registry's arrays; actors are only touched for the slot table
+    const FBattleUnitRegistry& Registry = SpawnedGridManager->GetUnitRegistry();
+    for (uint8 TeamIndex = 0; TeamIndex < 2; ++TeamIndex)
+    {
+        for (int32 UnitId : Registry.GetTeamUnits(TeamIndex))
+        {
+            if (!Registry.IsAlive(UnitId))
+                continue;
+
+            const int32 Slot = OutState.AddUnit(OutBoard, Registry.GetArchetype(UnitId), TeamIndex, Registry.GetCell(UnitId));
+            if (Slot == INDEX_NONE)
+            {
+                UE_LOG(LogSNAI, Warning, TEXT("Battle state is full - unit %d not captured."), UnitId);
+                continue;
+            }
+
+            FBattleUnit& Captured = OutState.Units[Slot];
+            Captured.Health = static_cast<int16>(Registry.GetHealth(UnitId));
+            Captured.Flags = Registry.GetFlags(UnitId);
+            OutSlots.Add(SpawnedGridManager->GetRegisteredUnit(UnitId));
+        }
+    }
+
+    const UTeam* SideTeam = (CurrentPhase == EGamePhase::AITurn) ? GetAITeam() : GetPlayerTeam();
+    OutState.SideToMove = SideTeam->GetTeamIndex();
+    OutState.RefreshHash();
+}
 
 /**
  * @brief Checks whether either team has lost all units and triggers game-over logic if so.
@@ -304,24 +783,128 @@ void ABattleGameMode::CheckGameEnd()
 
     if (!bPlayerAlive && !bAIAlive)
     {
-        UE_LOG(LogTemp, Warning, TEXT("It's a draw!"));
+        UE_LOG(LogSNGame, Log, TEXT("It's a draw!"));
         CurrentPhase = EGamePhase::GameOver;
         ShowGameOverWidget(TEXT("Draw!"));
     }
     else if (!bPlayerAlive)
     {
         FString Winner = AITeam->GetTeamColour().ToString();
-        UE_LOG(LogTemp, Warning, TEXT("%s wins!"), *Winner);
+        UE_LOG(LogSNGame, Log, TEXT("%s wins!"), *Winner);
         CurrentPhase = EGamePhase::GameOver;
         ShowGameOverWidget(FString::Printf(TEXT("%s wins!"), *Winner));
     }
     else if (!bAIAlive)
     {
         FString Winner = PlayerTeam->GetTeamColour().ToString();
-        UE_LOG(LogTemp, Warning, TEXT("%s wins!"), *Winner);
+        UE_LOG(LogSNGame, Log, TEXT("%s wins!"), *Winner);
         CurrentPhase = EGamePhase::GameOver;
         ShowGameOverWidget(FString::Printf(TEXT("%s wins!"), *Winner));
     }
+
+    if (CurrentPhase == EGamePhase::GameOver)
+    {
+        SaveReplay();
+    }
+}
+
+/**
+ * @brief Starts the match's replay with its seeds, terrain and starting side.
+ *
+ * Called once the grid, coin toss and teams are set up and before any unit is placed.
+ */
+void ABattleGameMode::StartReplay()
+{
+    Replay = FBattleReplay();
+    ReplayUnitIds.Reset();
+    bReplaySaved = false;
+
+    if (!bRecordReplays || !SpawnedGridManager || !Team1)
+        return;
+
+    Replay.MatchSeed = MatchRandom.GetMatchSeed();
+    for (int32 Index = 0; Index < static_cast<int32>(EMatchRandomStream::Count); ++Index)
+    {
+        Replay.StreamSeeds[Index] = MatchRandom.GetStreamSeed(static_cast<EMatchRandomStream>(Index));
+    }
+    Replay.SetTerrain(SpawnedGridManager->GetOccupancy());
+
+    // Team1 is team 0 of the replay, as in CaptureBattleState
+    Replay.StartingTeam = (bPlayerStarts == Team1->IsPlayerControlled()) ? 0 : 1;
+}
+
+/**
+ * @brief Writes the replay to Saved/Replays, once per match; matches that are left early are saved too.
+ */
+void ABattleGameMode::SaveReplay()
+{
+    if (!bRecordReplays || bReplaySaved || Replay.Commands.IsEmpty())
+        return;
+
+    bReplaySaved = true;
+
+    const FString Path = FPaths::ProjectSavedDir() / TEXT("Replays") /
+        FString::Printf(TEXT("Match_%d_%s.snreplay"), Replay.MatchSeed, *FDateTime::Now().ToString());
+
+    if (Replay.SaveToFile(Path))
+    {
+        UE_LOG(LogSNGame, Log, TEXT("Replay saved to %s (%d commands)."), *Path, Replay.Commands.Num());
+    }
+    else
+    {
+        UE_LOG(LogSNGame, Error, TEXT("Failed to write replay %s."), *Path);
+    }
+}
+
+/**
+ * @brief Records a unit joining the match and its archetype's stats; its placement order names it in later commands.
+ * @param Unit The unit just placed on the grid.
+ * @param Team The team it was added to.
+ */
+void ABattleGameMode::RecordReplayPlacement(const AUnitActor* Unit, const UTeam* Team)
+{
+    if (!bRecordReplays || !Unit)
+        return;
+
+    const int32 Slot = ReplayUnitIds.Num();
+    ReplayUnitIds.Add(Unit, static_cast<uint8>(Slot));
+    Replay.RecordArchetype(Unit->GetArchetype(), Unit->GetStats());
+    Replay.Commands.Add(FBattleReplayCommand::MakePlace(Slot, Team == Team1 ? 0 : 1,
+        Unit->GetArchetype(), Unit->GetGridPosition()));
+}
+
+/**
+ * @brief Records a unit moving to a cell.
+ */
+void ABattleGameMode::RecordReplayMove(const AUnitActor* Unit, const FIntPoint& Cell)
+{
+    if (!bRecordReplays)
+        return;
+
+    if (const uint8* UnitId = ReplayUnitIds.Find(Unit))
+    {
+        Replay.Commands.Add(FBattleReplayCommand::MakeMove(*UnitId, Cell));
+    }
+}
+
+/**
+ * @brief Records an attack with the health each side actually lost.
+ * @param Attacker The attacking unit.
+ * @param Target The attacked unit.
+ * @param Damage Health the target lost.
+ * @param CounterDamage Health the attacker lost to the counterattack.
+ */
+void ABattleGameMode::RecordReplayAttack(const AUnitActor* Attacker, const AUnitActor* Target, int32 Damage, int32 CounterDamage)
+{
+    if (!bRecordReplays)
+        return;
+
+    const uint8* AttackerId = ReplayUnitIds.Find(Attacker);
+    const uint8* TargetId = ReplayUnitIds.Find(Target);
+    if (AttackerId && TargetId)
+    {
+        Replay.Commands.Add(FBattleReplayCommand::MakeAttack(*AttackerId, *TargetId, Damage, CounterDamage));
+    }
 }
 
 
@@ -331,7 +914,18 @@ void ABattleGameMode::CheckGameEnd()
  */
 void ABattleGameMode::ShowGameOverWidget(const FString& ResultText)
 {
-    if (!GameOverWidgetClass) return;
+    CancelAIPlanning();
+
+    if (!GameOverWidgetClass)
+    {
+        UBattleAssetRegistry* Assets = UBattleAssetRegistry::Get(this);
+        GameOverWidgetClass = Assets ? Assets->GetWidgetClass(EBattleWidget::GameOver) : nullptr;
+    }
+    if (!GameOverWidgetClass)
+    {
+        UE_LOG(LogSNGame, Error, TEXT("Failed to load GameOverWidget class!"));
+        return;
+    }
 
     GameOverWidget = CreateWidget<UUserWidget>(GetWorld(), GameOverWidgetClass);
     if (!GameOverWidget) return;
@@ -355,21 +949,24 @@ void ABattleGameMode::ShowGameOverWidget(const FString& ResultText)
  */
 void ABattleGameMode::SpawnGameStatusWidget()
 {
-    FString WidgetPath = TEXT("/Game/Blueprints/WBP_GameStatus.WBP_GameStatus_C");
-    TSubclassOf<UGameStatusWidget> GameStatusWidgetClassLoaded =
-        Cast<UClass>(StaticLoadClass(UGameStatusWidget::StaticClass(), nullptr, *WidgetPath));
+    TRACE_CPUPROFILER_EVENT_SCOPE(ABattleGameMode::SpawnGameStatusWidget);
+    SCOPE_CYCLE_COUNTER(STAT_SNSpawnGameStatusWidget);
+
+    UBattleAssetRegistry* Assets = UBattleAssetRegistry::Get(this);
+    TSubclassOf<UUserWidget> WidgetClass = Assets ? Assets->GetWidgetClass(EBattleWidget::GameStatus) : nullptr;
+    TSubclassOf<UGameStatusWidget> GameStatusWidgetClassLoaded = (WidgetClass && WidgetClass->IsChildOf(UGameStatusWidget::StaticClass())) ? *WidgetClass : nullptr;
 
 
     if (!GameStatusWidgetClassLoaded)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to load GameStatusWidget class!"));
+        UE_LOG(LogSNGame, Error, TEXT("Failed to load GameStatusWidget class!"));
         return;
     }
 
     UGameStatusWidget* Widget = CreateWidget<UGameStatusWidget>(GetWorld(), GameStatusWidgetClassLoaded);
     if (!Widget)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to create GameStatusWidget!"));
+        UE_LOG(LogSNGame, Error, TEXT("Failed to create GameStatusWidget!"));
         return;
     }
 
@@ -384,39 +981,64 @@ void ABattleGameMode::SpawnGameStatusWidget()
 
         for (AUnitActor* Unit : Team1->GetControlledUnits())
         {
-            Widget->SetUnitHealth(Team1->IsPlayerControlled(), Unit->GetUnitType(), Unit->GetHealth(), /* MaxHP */ Unit->GetHealth());
+            Widget->SetUnitHealth(Team1->IsPlayerControlled(), Unit->GetUnitType(), Unit->GetHealth(), Unit->GetMaxHealth());
+            Unit->OnHealthChanged.AddUObject(this, &ABattleGameMode::OnUnitHealthChanged);
         }
 
         for (AUnitActor* Unit : Team2->GetControlledUnits())
         {
-            Widget->SetUnitHealth(Team2->IsPlayerControlled(), Unit->GetUnitType(), Unit->GetHealth(), /* MaxHP */ Unit->GetHealth());
+            Widget->SetUnitHealth(Team2->IsPlayerControlled(), Unit->GetUnitType(), Unit->GetHealth(), Unit->GetMaxHealth());
+            Unit->OnHealthChanged.AddUObject(this, &ABattleGameMode::OnUnitHealthChanged);
         }
     }
 }
 
+/**
+ * @brief Queues a unit's new health on the status widget, which shows it on the next frame.
+ * @param Unit The unit whose health changed.
+ */
+void ABattleGameMode::OnUnitHealthChanged(AUnitActor* Unit)
+{
+    if (!GameStatusWidget || !Team1 || !Team2)
+        return;
+
+    const UTeam* Team = Team1->OwnsUnit(Unit) ? Team1 : Team2;
+    GameStatusWidget->SetUnitHealth(Team->IsPlayerControlled(), Unit->GetUnitType(), Unit->GetHealth(), Unit->GetMaxHealth());
+}
+
 /**
  * @brief Updates the Game Status Widget with current unit health for both teams.
  * Displays 0 HP for units that are dead or missing.
+ *
+ * A full resync; health changes during play arrive through OnUnitHealthChanged instead. The widget
+ * skips values it already shows, so calling this costs no text updates when nothing changed.
  */
 void ABattleGameMode::UpdateGameStatusWidget()
 {
-    if (!GameStatusWidget || !Team1 || !Team2)
+    TRACE_CPUPROFILER_EVENT_SCOPE(ABattleGameMode::UpdateGameStatusWidget);
+    SCOPE_CYCLE_COUNTER(STAT_SNUpdateGameStatusWidget);
+
+    if (!GameStatusWidget || !Team1 || !Team2 || !SpawnedGridManager)
         return;
 
+    const FBattleUnitRegistry& Registry = SpawnedGridManager->GetUnitRegistry();
+
     auto UpdateTeam = [&](UTeam* Team)
         {
             bool IsPlayer = Team->IsPlayerControlled();
             AUnitActor* Sniper = nullptr;
             AUnitActor* Brawler = nullptr;
 
-            for (AUnitActor* Unit : Team->GetControlledUnits())
+            // Only living units are looked up; fallen ones show 0 HP below
+            for (int32 UnitId : Registry.GetTeamUnits(Team->GetTeamIndex()))
             {
+                AUnitActor* Unit = Registry.IsAlive(UnitId) ? SpawnedGridManager->GetRegisteredUnit(UnitId) : nullptr;
                 if (!Unit) continue;
 
-                if (Unit->GetUnitType() == EGameUnitType::Sniper && !Sniper && !Unit->IsDead())
+                if (Unit->GetUnitType() == EGameUnitType::Sniper && !Sniper)
                     Sniper = Unit;
 
-                if (Unit->GetUnitType() == EGameUnitType::Brawler && !Brawler && !Unit->IsDead())
+                if (Unit->GetUnitType() == EGameUnitType::Brawler && !Brawler)
                     Brawler = Unit;
             }
 
@@ -427,7 +1049,7 @@ void ABattleGameMode::UpdateGameStatusWidget()
             }
             else
             {
-                GameStatusWidget->SetUnitHealth(IsPlayer, EGameUnitType::Sniper, 0, 20); // Max for sniper
+                GameStatusWidget->SetUnitHealth(IsPlayer, EGameUnitType::Sniper, 0, FBattleUnitStats::Get(EBattleArchetype::Sniper).MaxHealth);
             }
 
             // Brawler
@@ -437,7 +1059,7 @@ void ABattleGameMode::UpdateGameStatusWidget()
             }
             else
             {
-                GameStatusWidget->SetUnitHealth(IsPlayer, EGameUnitType::Brawler, 0, 40); // Max for brawler
+                GameStatusWidget->SetUnitHealth(IsPlayer, EGameUnitType::Brawler, 0, FBattleUnitStats::Get(EBattleArchetype::Brawler).MaxHealth);
             }
         };
 
@@ -0,0 +1,424 @@
+#include "BattleMCTS.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+    /**
+     * Tree node. Decision nodes (a state where a side picks an action) own a contiguous
+     * block of action children; action nodes own a sibling list of decision nodes, one per
+     * set of surviving units after the action's dice.
+     */
+    struct FMCTSNode
+    {
+        FBattleAction Action;
+        uint8 AliveMask = 0;
+        uint8 Team = 0;
+
+        int32 FirstChild = INDEX_NONE;
+        int32 NumChildren = 0;
+        int32 NumTried = 0;
+        int32 NextSibling = INDEX_NONE;
+
+        int32 Visits = 0;
+        float Reward = 0.0f;
+    };
+
+    uint8 GetAliveMask(const FBattleState& State)
+    {
+        uint8 Mask = 0;
+        for (int32 Index = 0; Index < State.NumUnits; ++Index)
+        {
+            if (State.Units[Index].IsAlive())
+            {
+                Mask |= 1 << Index;
+            }
+        }
+        return Mask;
+    }
+
+    /**
+     * @class FMCTSWorker
+     * @brief One independent search tree with its own RNG and scratch buffers.
+     */
+    class FMCTSWorker
+    {
+    public:
+        FMCTSWorker(const FBattleBoard& InBoard, const FBattleState& InRoot, const FBattleMCTSSettings& InSettings, int32 InSeed)
+            : Board(InBoard)
+            , Root(InRoot)
+            , Settings(InSettings)
+            , Stream(InSeed)
+        {
+            for (int32 Index = 0; Index < Root.NumUnits; ++Index)
+            {
+                TeamMaxHealth[Root.Units[Index].Team] += Board.GetStats(Root.Units[Index]).MaxHealth;
+            }
+        }
+
+        /** Builds the root with one child per root action, in the given order. */
+        void Initialise(const TArray<FBattleAction>& RootActions)
+        {
+            Nodes.Reset();
+            Nodes.Reserve(FMath::Min(Settings.MaxNodesPerWorker, 4096));
+
+            FMCTSNode& RootNode = Nodes.AddDefaulted_GetRef();
+            RootNode.AliveMask = GetAliveMask(Root);
+            AddChildren(0, RootActions, Root.SideToMove, /*bShuffle*/ false);
+        }
+
+        void Run(double Deadline)
+        {
+            while (FPlatformTime::Seconds() < Deadline)
+            {
+                if (Settings.CancelFlag && Settings.CancelFlag->load(std::memory_order_relaxed))
+                    break;
+
+                if (Settings.MaxPlayoutsPerWorker > 0 && Playouts >= Settings.MaxPlayoutsPerWorker)
+                    break;
+
+                RunIteration();
+                ++Playouts;
+            }
+        }
+
+        int32 GetRootChildVisits(int32 ChildIndex) const { return Nodes[1 + ChildIndex].Visits; }
+        float GetRootChildReward(int32 ChildIndex) const { return Nodes[1 + ChildIndex].Reward; }
+        int64 GetPlayouts() const { return Playouts; }
+
+    private:
+        void AddChildren(int32 Parent, const TArray<FBattleAction>& Actions, uint8 Team, bool bShuffle)
+        {
+            const int32 First = Nodes.Num();
+
+            for (const FBattleAction& Action : Actions)
+            {
+                FMCTSNode& Child = Nodes.AddDefaulted_GetRef();
+                Child.Action = Action;
+                Child.Team = Team;
+            }
+
+            // Untried children are taken in block order, so shuffling makes that order random
+            if (bShuffle)
+            {
+                for (int32 Index = Actions.Num() - 1; Index > 0; --Index)
+                {
+                    Nodes.Swap(First + Index, First + Stream.RandRange(0, Index));
+                }
+            }
+
+            Nodes[Parent].FirstChild = First;
+            Nodes[Parent].NumChildren = Actions.Num();
+        }
+
+        bool HasRoomFor(int32 Count) const
+        {
+            return Nodes.Num() + Count <= Settings.MaxNodesPerWorker;
+        }
+
+        /** UCB1 over tried children, or the next untried child if any remain. */
+        int32 SelectChild(int32 Parent)
+        {
+            FMCTSNode& Node = Nodes[Parent];
+            if (Node.NumTried < Node.NumChildren)
+                return Node.FirstChild + Node.NumTried++;
+
+            const float LogVisits = FMath::Loge(static_cast<float>(FMath::Max(Node.Visits, 1)));
+            int32 Best = Node.FirstChild;
+            float BestValue = -1.0f;
+
+            for (int32 Child = Node.FirstChild; Child < Node.FirstChild + Node.NumChildren; ++Child)
+            {
+                const FMCTSNode& ChildNode = Nodes[Child];
+                const float Visits = static_cast<float>(ChildNode.Visits);
+                const float Value = ChildNode.Reward / Visits + Settings.Exploration * FMath::Sqrt(LogVisits / Visits);
+                if (Value > BestValue)
+                {
+                    BestValue = Value;
+                    Best = Child;
+                }
+            }
+            return Best;
+        }
+
+        /** Finds the decision node under an action for the current survivors, adding it if there is room. */
+        int32 FindOrAddOutcome(int32 ActionNode, uint8 AliveMask)
+        {
+            for (int32 Child = Nodes[ActionNode].FirstChild; Child != INDEX_NONE; Child = Nodes[Child].NextSibling)
+            {
+                if (Nodes[Child].AliveMask == AliveMask)
+                    return Child;
+            }
+
+            if (!HasRoomFor(1))
+                return INDEX_NONE;
+
+            const int32 NewNode = Nodes.Num();
+            FMCTSNode& Outcome = Nodes.AddDefaulted_GetRef();
+            Outcome.AliveMask = AliveMask;
+            Outcome.NextSibling = Nodes[ActionNode].FirstChild;
+            Nodes[ActionNode].FirstChild = NewNode;
+            return NewNode;
+        }
+
+        FBattleOutcome RollOutcome(const FBattleAction& Action)
+        {
+            FBattleOutcome Outcome;
+            if (Action.HasAttack())
+            {
+                const FBattleUnitStats& Stats = Board.GetStats(State.Units[Action.Unit]);
+                const FBattleUnitStats& TargetStats = Board.GetStats(State.Units[Action.Target]);
+                Outcome.Damage = static_cast<int16>(Stream.RandRange(Stats.DamageMin, Stats.DamageMax));
+                Outcome.CounterDamage = static_cast<int16>(Stream.RandRange(TargetStats.CounterDamageMin, TargetStats.CounterDamageMax));
+            }
+            return Outcome;
+        }
+
+        void Apply(const FBattleAction& Action)
+        {
+            FBattleUndo Undo;
+            State.ApplyAction(Board, Action, RollOutcome(Action), Undo);
+        }
+
+        /** Selection, expansion, playout and backpropagation for one playout. */
+        void RunIteration()
+        {
+            State = Root;
+            Path.Reset();
+
+            int32 Node = 0;
+            Nodes[Node].Visits++;
+
+            while (!State.IsTerminal())
+            {
+                if (Nodes[Node].NumChildren == 0)
+                {
+                    // Expand on the second visit so one-off leaves cost a single node
+                    if (Nodes[Node].Visits < 2)
+                        break;
+
+                    State.GenerateActions(Board, Scratch, Actions);
+                    if (Actions.IsEmpty() || !HasRoomFor(Actions.Num()))
+                        break;
+
+                    AddChildren(Node, Actions, State.SideToMove, /*bShuffle*/ true);
+                }
+
+                const int32 ActionNode = SelectChild(Node);
+                Apply(Nodes[ActionNode].Action);
+                Nodes[ActionNode].Visits++;
+                Path.Add(ActionNode);
+
+                const int32 Outcome = FindOrAddOutcome(ActionNode, GetAliveMask(State));
+                if (Outcome == INDEX_NONE)
+                    break;
+
+                Node = Outcome;
+                Nodes[Node].Visits++;
+            }
+
+            const float Reward = Playout();
+
+            for (int32 ActionNode : Path)
+            {
+                Nodes[ActionNode].Reward += (Nodes[ActionNode].Team == 0) ? Reward : 1.0f - Reward;
+            }
+        }
+
+        /**
+         * Plays on from the current state and scores it for team 0: 1 or 0 for a finished match,
+         * otherwise 0.5 shifted by the difference in remaining health fractions.
+         */
+        float Playout()
+        {
+            for (int32 Ply = 0; Ply < Settings.MaxPlayoutPlies && !State.IsTerminal(); ++Ply)
+            {
+                PlayRandomAction();
+            }
+
+            switch (State.GetResult())
+            {
+            case EBattleResult::Team0Wins: return 1.0f;
+            case EBattleResult::Team1Wins: return 0.0f;
+            case EBattleResult::Draw: return 0.5f;
+            default: break;
+            }
+
+            int32 Health[2] = { 0, 0 };
+            for (int32 Index = 0; Index < State.NumUnits; ++Index)
+            {
+                Health[State.Units[Index].Team] += State.Units[Index].Health;
+            }
+
+            const float Fraction0 = static_cast<float>(Health[0]) / FMath::Max(TeamMaxHealth[0], 1);
+            const float Fraction1 = static_cast<float>(Health[1]) / FMath::Max(TeamMaxHealth[1], 1);
+            return 0.5f + 0.5f * (Fraction0 - Fraction1);
+        }
+
+        /**
+         * Picks a random unit of the side to move. It attacks a random enemy from a random cell in
+         * range if there is one; otherwise it moves towards the nearest enemy half of the time and
+         * to a random reachable cell the rest.
+         */
+        void PlayRandomAction()
+        {
+            int32 Candidates[FBattleState::MaxUnits];
+            int32 NumCandidates = 0;
+            for (int32 Index = 0; Index < State.NumUnits; ++Index)
+            {
+                const FBattleUnit& Unit = State.Units[Index];
+                if (Unit.Team == State.SideToMove && Unit.IsAlive() && !Unit.HasActed())
+                {
+                    Candidates[NumCandidates++] = Index;
+                }
+            }
+
+            if (NumCandidates == 0)
+                return;
+
+            const int32 UnitIndex = Candidates[Stream.RandRange(0, NumCandidates - 1)];
+            const FBattleUnit& Unit = State.Units[UnitIndex];
+            const bool bCanAttack = !(Unit.Flags & FBattleUnit::Flag_Attacked);
+
+            State.FindReachableCells(Board, UnitIndex, Scratch, Destinations);
+            Destinations.Add(Unit.GetCell());
+
+            FBattleAction Action;
+            Action.Unit = static_cast<int8>(UnitIndex);
+
+            int32 NumSeen = 0;
+            int32 BestDistance = MAX_int32;
+            FIntPoint Closest = Unit.GetCell();
+
+            for (const FIntPoint& Destination : Destinations)
+            {
+                for (int32 TargetIndex = 0; TargetIndex < State.NumUnits; ++TargetIndex)
+                {
+                    const FBattleUnit& Target = State.Units[TargetIndex];
+                    if (Target.Team == Unit.Team || !Target.IsAlive())
+                        continue;
+
+                    const int32 Distance = FBattleState::GetDistance(Destination, Target.GetCell());
+                    if (Distance < BestDistance)
+                    {
+                        BestDistance = Distance;
+                        Closest = Destination;
+                    }
+
+                    // Reservoir-sample one attack uniformly among all (cell, target) pairs
+                    if (bCanAttack && State.IsInRange(Board, UnitIndex, Destination, TargetIndex) && Stream.RandRange(0, NumSeen++) == 0)
+                    {
+                        Action.ToX = static_cast<int16>(Destination.X);
+                        Action.ToY = static_cast<int16>(Destination.Y);
+                        Action.Target = static_cast<int8>(TargetIndex);
+                    }
+                }
+            }
+
+            if (!Action.HasAttack())
+            {
+                const FIntPoint Destination = (Stream.RandRange(0, 1) == 0) ? Closest : Destinations[Stream.RandRange(0, Destinations.Num() - 1)];
+                Action.ToX = static_cast<int16>(Destination.X);
+                Action.ToY = static_cast<int16>(Destination.Y);
+            }
+
+            Apply(Action);
+        }
+
+        const FBattleBoard& Board;
+        const FBattleState& Root;
+        const FBattleMCTSSettings& Settings;
+
+        FRandomStream Stream;
+        FBattleScratch Scratch;
+        FBattleState State;
+
+        TArray<FMCTSNode> Nodes;
+        TArray<int32> Path;
+        TArray<FBattleAction> Actions;
+        TArray<FIntPoint> Destinations;
+
+        int32 TeamMaxHealth[2] = { 0, 0 };
+        int64 Playouts = 0;
+    };
+}
+
+/**
+ * @brief Creates a search over a fixed board. The board must outlive the search.
+ * @param InBoard Terrain shared by every searched state.
+ */
+FBattleMCTS::FBattleMCTS(const FBattleBoard& InBoard)
+    : Board(InBoard)
+{
+}
+
+/**
+ * @brief Runs one tree per worker until the budget is spent and picks the most visited root action.
+ *
+ * Blocks the calling thread for the budget; the calling thread takes part as one of the workers.
+ *
+ * @param Root The state to search from; it is never modified.
+ * @param Settings Time, worker and tree limits.
+ * @return The chosen action and playout statistics.
+ */
+FBattleMCTSResult FBattleMCTS::FindBestAction(const FBattleState& Root, const FBattleMCTSSettings& Settings) const
+{
+    FBattleMCTSResult Result;
+
+    FBattleScratch Scratch;
+    TArray<FBattleAction> RootActions;
+    Root.GenerateActions(Board, Scratch, RootActions);
+    if (RootActions.IsEmpty())
+        return Result;
+
+    Result.BestAction = RootActions[0];
+    Result.bHasAction = true;
+
+    const int32 NumWorkers = (Settings.NumWorkers > 0) ? Settings.NumWorkers : FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1);
+
+    TArray<TUniquePtr<FMCTSWorker>> Workers;
+    Workers.SetNum(NumWorkers);
+
+    const double StartTime = FPlatformTime::Seconds();
+    const double Deadline = StartTime + Settings.TimeBudgetSeconds;
+
+    ParallelFor(NumWorkers, [&](int32 WorkerIndex)
+    {
+        TUniquePtr<FMCTSWorker> Worker = MakeUnique<FMCTSWorker>(Board, Root, Settings, Settings.Seed + WorkerIndex);
+        Worker->Initialise(RootActions);
+        Worker->Run(Deadline);
+        Workers[WorkerIndex] = MoveTemp(Worker);
+    }, EParallelForFlags::Unbalanced);
+
+    Result.Seconds = FPlatformTime::Seconds() - StartTime;
+    Result.NumWorkers = NumWorkers;
+
+    int64 BestVisits = -1;
+    for (int32 ActionIndex = 0; ActionIndex < RootActions.Num(); ++ActionIndex)
+    {
+        int64 Visits = 0;
+        double Reward = 0.0;
+        for (const TUniquePtr<FMCTSWorker>& Worker : Workers)
+        {
+            Visits += Worker->GetRootChildVisits(ActionIndex);
+            Reward += Worker->GetRootChildReward(ActionIndex);
+        }
+
+        if (Visits > BestVisits)
+        {
+            BestVisits = Visits;
+            Result.BestAction = RootActions[ActionIndex];
+            Result.WinRate = (Visits > 0) ? Reward / Visits : 0.0;
+        }
+    }
+
+    for (const TUniquePtr<FMCTSWorker>& Worker : Workers)
+    {
+        Result.Playouts += Worker->GetPlayouts();
+    }
+    Result.PlayoutsPerSecond = (Result.Seconds > 0.0) ? Result.Playouts / Result.Seconds : 0.0;
+
+    return Result;
+}
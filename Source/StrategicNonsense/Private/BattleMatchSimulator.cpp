@@ -0,0 +1,219 @@
+#include "BattleMatchSimulator.h"
+#include "BattleSearch.h"
+#include "BattleMCTS.h"
+#include "GridConnectivity.h"
+#include "GridObstacleLayout.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+    constexpr double UnlimitedBudgetSeconds = 1.0e9;
+    constexpr double DefaultMonteCarloBudgetSeconds = 0.02;
+
+    // Each team places these in order, as queued by UTeam::Initialise
+    const EBattleArchetype GTeamRoster[] = { EBattleArchetype::Sniper, EBattleArchetype::Brawler };
+
+    /**
+     * The Random agent: the next unit to act moves to a random reachable cell, then attacks the
+     * first enemy in range. A baseline for the search agents; the game's Approach engine
+     * (ABattleGameMode::RunApproachAITurn) walks toward attack positions instead.
+     */
+    FBattleAction ChooseRandomAction(const FBattleBoard& Board, const FBattleState& State, FBattleScratch& Scratch, FRandomStream& Stream)
+    {
+        FBattleAction Action;
+
+        for (int32 Index = 0; Index < State.NumUnits; ++Index)
+        {
+            const FBattleUnit& Unit = State.Units[Index];
+            if (Unit.Team == State.SideToMove && Unit.IsAlive() && !Unit.HasActed())
+            {
+                Action.Unit = static_cast<int8>(Index);
+                break;
+            }
+        }
+
+        if (Action.Unit == INDEX_NONE)
+            return Action;
+
+        TArray<FIntPoint> Reachable;
+        State.FindReachableCells(Board, Action.Unit, Scratch, Reachable);
+
+        const FIntPoint Destination = Reachable.IsEmpty() ? State.Units[Action.Unit].GetCell() : Reachable[Stream.RandRange(0, Reachable.Num() - 1)];
+        Action.ToX = static_cast<int16>(Destination.X);
+        Action.ToY = static_cast<int16>(Destination.Y);
+
+        for (int32 TargetIndex = 0; TargetIndex < State.NumUnits; ++TargetIndex)
+        {
+            const FBattleUnit& Target = State.Units[TargetIndex];
+            if (Target.Team != State.SideToMove && Target.IsAlive() && State.IsInRange(Board, Action.Unit, Destination, TargetIndex))
+            {
+                Action.Target = static_cast<int8>(TargetIndex);
+                break;
+            }
+        }
+
+        return Action;
+    }
+}
+
+/**
+ * @brief Plays one match from map generation to the last hit.
+ * @param Config Map, agents, limits and seed.
+ * @return The result and per-hit damage statistics.
+ */
+FBattleMatchReport FBattleMatchSimulator::RunMatch(const FBattleMatchConfig& Config)
+{
+    FBattleMatchReport Report;
+    const double StartTime = FPlatformTime::Seconds();
+
+    FRandomStream Stream(Config.Seed);
+
+    // Map
+    FGridOccupancy Occupancy;
+    Occupancy.Initialise(Config.GridSizeX, Config.GridSizeY);
+
+    FGridConnectivity Connectivity;
+    TArray<FGridObstacle> Obstacles;
+    FGridObstacleLayout::Generate(Occupancy, Connectivity, Config.ObstaclePercentage, Stream, Obstacles);
+
+    FBattleBoard Board;
+    Board.InitialiseFromOccupancy(Occupancy);
+
+    // Coin toss, then alternating placement starting with the winner
+    FBattleState State;
+    Report.StartingTeam = Stream.RandBool() ? 0 : 1;
+
+    TArray<FIntPoint> FreeCells;
+    Board.Terrain.ForEachFreeCell([&FreeCells](const FIntPoint& Cell) { FreeCells.Add(Cell); });
+
+    for (int32 RosterIndex = 0; RosterIndex < UE_ARRAY_COUNT(GTeamRoster); ++RosterIndex)
+    {
+        for (int32 Step = 0; Step < 2 && !FreeCells.IsEmpty(); ++Step)
+        {
+            const uint8 Team = (Step == 0) ? Report.StartingTeam : 1 - Report.StartingTeam;
+            const int32 CellIndex = Stream.RandRange(0, FreeCells.Num() - 1);
+            State.AddUnit(Board, GTeamRoster[RosterIndex], Team, FreeCells[CellIndex]);
+            FreeCells.RemoveAtSwap(CellIndex);
+        }
+    }
+
+    State.SideToMove = Report.StartingTeam;
+    State.RefreshHash();
+
+    // Turns
+    FBattleScratch Scratch;
+    FBattleSearch Search(Board);
+    FBattleMCTS MonteCarlo(Board);
+
+    while (!State.IsTerminal() && State.TurnNumber < Config.MaxTurns)
+    {
+        FBattleAction Action;
+
+        switch (Config.Agents[State.SideToMove])
+        {
+        case EBattleAgent::Expectiminimax:
+        {
+            FBattleSearchSettings Settings;
+            Settings.TimeBudgetSeconds = (Config.ActionBudgetSeconds > 0.0 && Config.ActionSearchNodes <= 0) ? Config.ActionBudgetSeconds : UnlimitedBudgetSeconds;
+            Settings.MaxNodes = Config.ActionSearchNodes;
+            Settings.MaxDepth = Config.SearchMaxDepth;
+            Action = Search.FindBestAction(State, Settings).BestAction;
+            break;
+        }
+
+        case EBattleAgent::MonteCarlo:
+        {
+            // Matches already run in parallel, so each tree search stays on one worker
+            FBattleMCTSSettings Settings;
+            if (Config.ActionPlayouts > 0)
+            {
+                Settings.TimeBudgetSeconds = UnlimitedBudgetSeconds;
+                Settings.MaxPlayoutsPerWorker = Config.ActionPlayouts;
+            }
+            else
+            {
+                Settings.TimeBudgetSeconds = (Config.ActionBudgetSeconds > 0.0) ? Config.ActionBudgetSeconds : DefaultMonteCarloBudgetSeconds;
+            }
+            Settings.NumWorkers = 1;
+            Settings.Seed = static_cast<int32>(Stream.GetUnsignedInt());
+            Action = MonteCarlo.FindBestAction(State, Settings).BestAction;
+            break;
+        }
+
+        default:
+            Action = ChooseRandomAction(Board, State, Scratch, Stream);
+            break;
+        }
+
+        if (Action.Unit == INDEX_NONE)
+            break;
+
+        // Roll the dice like UCombatManager
+        FBattleOutcome Outcome;
+        if (Action.HasAttack())
+        {
+            const FBattleUnitStats& Stats = Board.GetStats(State.Units[Action.Unit]);
+            const FBattleUnitStats& TargetStats = Board.GetStats(State.Units[Action.Target]);
+            Outcome.Damage = static_cast<int16>(Stream.RandRange(Stats.DamageMin, Stats.DamageMax));
+            Outcome.CounterDamage = static_cast<int16>(Stream.RandRange(TargetStats.CounterDamageMin, TargetStats.CounterDamageMax));
+        }
+
+        const uint8 AttackingTeam = State.Units[Action.Unit].Team;
+        const int16 AttackerHealth = State.Units[Action.Unit].Health;
+        const int16 TargetHealth = Action.HasAttack() ? State.Units[Action.Target].Health : 0;
+
+        FBattleUndo Undo;
+        State.ApplyAction(Board, Action, Outcome, Undo);
+        ++Report.Activations;
+
+        if (Action.HasAttack())
+        {
+            Report.AttackDamage[AttackingTeam].Add(static_cast<uint8>(TargetHealth - State.Units[Action.Target].Health));
+
+            const int16 CounterTaken = AttackerHealth - State.Units[Action.Unit].Health;
+            if (CounterTaken > 0)
+            {
+                Report.CounterDamage[1 - AttackingTeam].Add(static_cast<uint8>(CounterTaken));
+            }
+        }
+    }
+
+    Report.Result = State.GetResult();
+    Report.Turns = State.TurnNumber;
+    Report.Seconds = FPlatformTime::Seconds() - StartTime;
+    return Report;
+}
+
+/**
+ * @brief Display and command-line name of an agent.
+ */
+const TCHAR* FBattleMatchSimulator::GetAgentName(EBattleAgent Agent)
+{
+    switch (Agent)
+    {
+    case EBattleAgent::Expectiminimax: return TEXT("Expectiminimax");
+    case EBattleAgent::MonteCarlo: return TEXT("MonteCarlo");
+    default: return TEXT("Random");
+    }
+}
+
+/**
+ * @brief Parses an agent name (case-insensitive), as written by GetAgentName.
+ * @param Name The name to parse.
+ * @param OutAgent Receives the agent.
+ * @return false if the name is unknown.
+ */
+bool FBattleMatchSimulator::ParseAgent(const FString& Name, EBattleAgent& OutAgent)
+{
+    const EBattleAgent Agents[] = { EBattleAgent::Random, EBattleAgent::Expectiminimax, EBattleAgent::MonteCarlo };
+    for (EBattleAgent Agent : Agents)
+    {
+        if (Name.Equals(GetAgentName(Agent), ESearchCase::IgnoreCase))
+        {
+            OutAgent = Agent;
+            return true;
+        }
+    }
+    return false;
+}
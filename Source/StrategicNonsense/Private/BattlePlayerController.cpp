@@ -1,4 +1,5 @@
 #include "BattlePlayerController.h"
+#include "StrategicNonsense.h"
 #include "BattleGameMode.h"
 #include "GridManager.h"
 #include "Team.h"
@@ -53,7 +54,7 @@ void ABattlePlayerController::HandleLeftClick()
     switch (GameMode->GetCurrentPhase())
     {
     case EGamePhase::Placement:
-        UE_LOG(LogTemp, Warning, TEXT("Placement phase - forwarding to game mode"));
+        UE_LOG(LogSNGame, Verbose, TEXT("Placement phase - forwarding to game mode"));
         GameMode->OnPlayerClickedGrid(Hit.Location);
         break;
 
@@ -80,7 +81,7 @@ void ABattlePlayerController::HandleLeftClick()
         break;
 
     default:
-        UE_LOG(LogTemp, Warning, TEXT("Click ignored - not in an interactive phase."));
+        UE_LOG(LogSNGame, Verbose, TEXT("Click ignored - not in an interactive phase."));
         break;
     }
 }
@@ -100,7 +101,7 @@ void ABattlePlayerController::HandleUnitClicked(AUnitActor* ClickedUnit)
     if (GameMode->GetPlayerTeam()->OwnsUnit(ClickedUnit))
     {
         SelectedUnit = ClickedUnit;
-        UE_LOG(LogTemp, Warning, TEXT("Selected Unit: %s"), *ClickedUnit->GetName());
+        UE_LOG(LogSNGame, Verbose, TEXT("Selected Unit: %s"), *ClickedUnit->GetName());
     }
 
     // If we already selected a unit, try attacking
@@ -108,7 +109,7 @@ void ABattlePlayerController::HandleUnitClicked(AUnitActor* ClickedUnit)
     {
         if (SelectedUnit->HasAttackedThisTurn())
         {
-            UE_LOG(LogTemp, Warning, TEXT("Unit has already attacked this turn."));
+            UE_LOG(LogSNGame, Verbose, TEXT("Unit has already attacked this turn."));
             return;
         }
 
@@ -124,8 +125,6 @@ void ABattlePlayerController::HandleUnitClicked(AUnitActor* ClickedUnit)
                 SelectedUnit->MarkAsAttacked();
                 SelectedUnit = nullptr;
 
-                GameMode->UpdateGameStatusWidget();
-
                 GameMode->CheckGameEnd();
 
                 if (GameMode->GetPlayerTeam()->HasTeamFinishedTurn())
@@ -148,13 +147,13 @@ void ABattlePlayerController::HandleGridCellClicked(FVector ClickLocation)
 {
     if (!SelectedUnit || !CachedGridManager)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Missing unit or grid manager."));
+        UE_LOG(LogSNGame, Warning, TEXT("Missing unit or grid manager."));
         return;
     }
 
     if (SelectedUnit->HasMovedThisTurn())
     {
-        UE_LOG(LogTemp, Warning, TEXT("Unit has already moved this turn."));
+        UE_LOG(LogSNGame, Verbose, TEXT("Unit has already moved this turn."));
         return;
     }
 
@@ -163,27 +162,26 @@ void ABattlePlayerController::HandleGridCellClicked(FVector ClickLocation)
 
     if (TargetCell == CurrentCell)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Clicked on current unit position."));
+        UE_LOG(LogSNGame, Verbose, TEXT("Clicked on current unit position."));
         return;
     }
 
     int32 MaxRange = SelectedUnit->GetMovementRange();
-    TSet<FIntPoint> ReachableCells = CachedGridManager->FindReachableCellsBFS(CurrentCell, MaxRange);
 
-    if (!ReachableCells.Contains(TargetCell))
+    if (CachedGridManager->GetReachableDistance(CurrentCell, MaxRange, TargetCell) == INDEX_NONE)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Cell (%d, %d) is outside movement range."), TargetCell.X, TargetCell.Y);
+        UE_LOG(LogSNGame, Verbose, TEXT("Cell (%d, %d) is outside movement range."), TargetCell.X, TargetCell.Y);
         return;
     }
 
     if (!CachedGridManager->IsCellWalkable(TargetCell))
     {
-        UE_LOG(LogTemp, Warning, TEXT("Target cell is not walkable."));
+        UE_LOG(LogSNGame, Verbose, TEXT("Target cell is not walkable."));
         return;
     }
 
     // Move
-    UE_LOG(LogTemp, Warning, TEXT("Snapping unit to cell (%d, %d)"), TargetCell.X, TargetCell.Y);
+    UE_LOG(LogSNGame, Verbose, TEXT("Snapping unit to cell (%d, %d)"), TargetCell.X, TargetCell.Y);
     CachedGridManager->SetUnitAtCell(CurrentCell, nullptr);
     CachedGridManager->SetUnitAtCell(TargetCell, SelectedUnit);
     SelectedUnit->SetGridPosition(TargetCell);
@@ -195,12 +193,12 @@ void ABattlePlayerController::HandleGridCellClicked(FVector ClickLocation)
 
     if (GameMode)
     {
-        GameMode->UpdateGameStatusWidget();
+        GameMode->RecordReplayMove(SelectedUnit, TargetCell);
 
         UTeam* PlayerTeam = GameMode->GetPlayerTeam();
         if (PlayerTeam && PlayerTeam->HasTeamFinishedTurn())
         {
-            UE_LOG(LogTemp, Warning, TEXT("Player has finished their turn."));
+            UE_LOG(LogSNGame, Log, TEXT("Player has finished their turn."));
             GameMode->SetGamePhase(EGamePhase::AITurn);
         }
     }
@@ -221,20 +219,11 @@ void ABattlePlayerController::HandleEndTurnPressed()
     UTeam* PlayerTeam = GameMode->GetPlayerTeam();
     if (!PlayerTeam) return;
 
-    // Mark all units as done
-    for (AUnitActor* Unit : PlayerTeam->GetControlledUnits())
-    {
-        if (Unit && !Unit->IsDead())
-        {
-            Unit->MarkAsDone();
-        }
-    }
+    PlayerTeam->MarkUnitsAsDone();
 
     SelectedUnit = nullptr;
 
-    GameMode->UpdateGameStatusWidget();
-
-    UE_LOG(LogTemp, Warning, TEXT("Player clicked end turn  forcing transition to AI turn."));
+    UE_LOG(LogSNGame, Log, TEXT("Player clicked end turn  forcing transition to AI turn."));
     GameMode->SetGamePhase(EGamePhase::AITurn);
 }
 
@@ -0,0 +1,385 @@
+#include "BattleReplay.h"
+#include "StrategicNonsense.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/Archive.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/**
+ * @brief A placement; Slot must be the number of units placed before it.
+ */
+FBattleReplayCommand FBattleReplayCommand::MakePlace(int32 Slot, uint8 Team, EBattleArchetype Archetype, const FIntPoint& Cell)
+{
+    FBattleReplayCommand Command;
+    Command.Type = EBattleReplayCommand::Place;
+    Command.Unit = static_cast<uint8>(Slot);
+    Command.Target = Team;
+    Command.Archetype = static_cast<uint8>(Archetype);
+    Command.X = static_cast<int16>(Cell.X);
+    Command.Y = static_cast<int16>(Cell.Y);
+    return Command;
+}
+
+/**
+ * @brief A unit moving to a cell.
+ */
+FBattleReplayCommand FBattleReplayCommand::MakeMove(int32 Unit, const FIntPoint& Cell)
+{
+    FBattleReplayCommand Command;
+    Command.Type = EBattleReplayCommand::Move;
+    Command.Unit = static_cast<uint8>(Unit);
+    Command.X = static_cast<int16>(Cell.X);
+    Command.Y = static_cast<int16>(Cell.Y);
+    return Command;
+}
+
+/**
+ * @brief An attack with its resolved dice: health the target lost and health the attacker lost to the counter.
+ */
+FBattleReplayCommand FBattleReplayCommand::MakeAttack(int32 Unit, int32 Target, int32 Damage, int32 CounterDamage)
+{
+    FBattleReplayCommand Command;
+    Command.Type = EBattleReplayCommand::Attack;
+    Command.Unit = static_cast<uint8>(Unit);
+    Command.Target = static_cast<uint8>(Target);
+    Command.X = static_cast<int16>(Damage);
+    Command.Y = static_cast<int16>(CounterDamage);
+    return Command;
+}
+
+/**
+ * @brief The side to move hands the turn to the other side.
+ */
+FBattleReplayCommand FBattleReplayCommand::MakeEndTurn()
+{
+    return FBattleReplayCommand();
+}
+
+FArchive& operator<<(FArchive& Ar, FBattleReplayCommand& Command)
+{
+    uint8 Type = static_cast<uint8>(Command.Type);
+    Ar << Type << Command.Unit << Command.Target << Command.Archetype << Command.X << Command.Y;
+    Command.Type = static_cast<EBattleReplayCommand>(Type);
+    return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FBattleReplayArchetype& Entry)
+{
+    FBattleUnitStats& Stats = Entry.Stats;
+    Ar << Entry.ArchetypeId << Stats.MaxHealth << Stats.Movement << Stats.AttackRange << Stats.DamageMin << Stats.DamageMax;
+    Ar << Stats.AttackType << Stats.CounterRange << Stats.CounterDamageMin << Stats.CounterDamageMax << Stats.Flags;
+    return Ar;
+}
+
+/**
+ * @brief Records the grid size and packs the blocked cells of Occupancy (before any unit is placed).
+ * @param Occupancy The grid's occupancy right after obstacle placement.
+ */
+void FBattleReplay::SetTerrain(const FGridOccupancy& Occupancy)
+{
+    GridSizeX = static_cast<int16>(Occupancy.GetWidth());
+    GridSizeY = static_cast<int16>(Occupancy.GetHeight());
+    Terrain.Init(0, (Occupancy.GetNumCells() + 7) / 8);
+
+    for (int32 Index = 0; Index < Occupancy.GetNumCells(); ++Index)
+    {
+        if (Occupancy.IsBlockedIndex(Index))
+        {
+            Terrain[Index >> 3] |= 1 << (Index & 7);
+        }
+    }
+}
+
+/**
+ * @brief Whether a cell was blocked by terrain when the match started.
+ */
+bool FBattleReplay::IsTerrainBlocked(const FIntPoint& Cell) const
+{
+    const int32 Index = Cell.Y * GridSizeX + Cell.X;
+    return (Terrain[Index >> 3] >> (Index & 7)) & 1;
+}
+
+/**
+ * @brief Remembers an archetype's stats the first time a unit of it is placed.
+ * @param Archetype The placed unit's archetype.
+ * @param Stats Its stats in the active table.
+ */
+void FBattleReplay::RecordArchetype(EBattleArchetype Archetype, const FBattleUnitStats& Stats)
+{
+    const uint8 ArchetypeId = static_cast<uint8>(Archetype);
+    if (Archetypes.ContainsByPredicate([ArchetypeId](const FBattleReplayArchetype& Entry) { return Entry.ArchetypeId == ArchetypeId; }))
+        return;
+
+    FBattleReplayArchetype& Entry = Archetypes.AddDefaulted_GetRef();
+    Entry.ArchetypeId = ArchetypeId;
+    Entry.Stats = Stats;
+}
+
+/**
+ * @brief The archetype table the match was played with.
+ *
+ * Replays without recorded stats (version 1) get the built-in table.
+ *
+ * @param OutTable Receives the table.
+ * @return false if a recorded entry is out of range or unusable.
+ */
+bool FBattleReplay::BuildArchetypeTable(FBattleArchetypeTable& OutTable) const
+{
+    if (Archetypes.IsEmpty())
+    {
+        OutTable = FBattleArchetypeTable::GetBuiltIn();
+        return true;
+    }
+
+    OutTable = FBattleArchetypeTable();
+    for (const FBattleReplayArchetype& Entry : Archetypes)
+    {
+        if (!OutTable.SetStats(Entry.ArchetypeId, Entry.Stats))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads or writes the replay.
+ * @param Ar The archive; loading replaces every field.
+ * @return false if the data is not a replay, comes from a newer version or is truncated.
+ */
+bool FBattleReplay::Serialize(FArchive& Ar)
+{
+    uint32 FileMagic = Magic;
+    uint16 FileVersion = Version;
+    Ar << FileMagic << FileVersion;
+
+    if (FileMagic != Magic || FileVersion > Version)
+    {
+        UE_LOG(LogSNGame, Error, TEXT("Not a replay, or written by a newer version (%u)."), FileVersion);
+        return false;
+    }
+
+    Ar << MatchSeed;
+    for (int32& Seed : StreamSeeds)
+    {
+        Ar << Seed;
+    }
+    Ar << GridSizeX << GridSizeY << StartingTeam;
+    Ar << Terrain;
+
+    if (FileVersion >= 2)
+    {
+        Ar << Archetypes;
+    }
+    else
+    {
+        Archetypes.Reset();
+    }
+
+    Ar << Commands;
+
+    if (Ar.IsError() || GridSizeX <= 0 || GridSizeY <= 0 || Terrain.Num() != (GridSizeX * GridSizeY + 7) / 8)
+    {
+        UE_LOG(LogSNGame, Error, TEXT("Replay data is truncated or inconsistent."));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the replay to a file.
+ * @return true if the file was written.
+ */
+bool FBattleReplay::SaveToFile(const FString& Path)
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    return Serialize(Writer) && FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+/**
+ * @brief Reads a replay written by SaveToFile.
+ * @return true if the file was read and is a valid replay.
+ */
+bool FBattleReplay::LoadFromFile(const FString& Path)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+    {
+        UE_LOG(LogSNGame, Error, TEXT("Could not read replay %s."), *Path);
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+    return Serialize(Reader);
+}
+
+/**
+ * @brief Builds the terrain and archetype table, validates every command and indexes the turns and keyframes.
+ * @param InReplay The replay to play; its commands are copied.
+ * @return false if the terrain, the archetypes or any command is malformed. The player is left at the end of the replay otherwise.
+ */
+bool FBattleReplayPlayer::Initialise(const FBattleReplay& InReplay)
+{
+    if (InReplay.GridSizeX <= 0 || InReplay.GridSizeY <= 0 || InReplay.Terrain.Num() != (InReplay.GridSizeX * InReplay.GridSizeY + 7) / 8)
+    {
+        UE_LOG(LogSNGame, Error, TEXT("Replay terrain does not match its grid size."));
+        return false;
+    }
+
+    FBattleArchetypeTable Archetypes;
+    if (!InReplay.BuildArchetypeTable(Archetypes))
+    {
+        UE_LOG(LogSNGame, Error, TEXT("Replay archetype stats are invalid."));
+        return false;
+    }
+    Board.Archetypes = MakeShared<const FBattleArchetypeTable, ESPMode::ThreadSafe>(Archetypes);
+
+    Board.Terrain.Initialise(InReplay.GridSizeX, InReplay.GridSizeY);
+    Board.LineOfSightAttackTypes = 0;
+    for (int32 Y = 0; Y < InReplay.GridSizeY; ++Y)
+    {
+        for (int32 X = 0; X < InReplay.GridSizeX; ++X)
+        {
+            if (InReplay.IsTerrainBlocked(FIntPoint(X, Y)))
+            {
+                Board.Terrain.SetBlocked(FIntPoint(X, Y), true);
+            }
+        }
+    }
+
+    InitialState = FBattleState();
+    InitialState.SideToMove = InReplay.StartingTeam & 1;
+    InitialState.RefreshHash();
+
+    Commands = InReplay.Commands;
+    Keyframes.Reset(Commands.Num() / KeyframeInterval + 1);
+    TurnStarts.Reset();
+
+    State = InitialState;
+    Keyframes.Add(State);
+    TurnStarts.Add(0);
+
+    for (int32 Index = 0; Index < Commands.Num(); ++Index)
+    {
+        if (!ApplyCommand(Board, State, Commands[Index]))
+        {
+            UE_LOG(LogSNGame, Error, TEXT("Replay command %d (type %d) is malformed."), Index, static_cast<int32>(Commands[Index].Type));
+            return false;
+        }
+
+        if (Commands[Index].Type == EBattleReplayCommand::EndTurn)
+        {
+            TurnStarts.Add(Index + 1);
+        }
+        if ((Index + 1) % KeyframeInterval == 0)
+        {
+            Keyframes.Add(State);
+        }
+    }
+
+    State.RefreshHash();
+    CommandIndex = Commands.Num();
+    return true;
+}
+
+/**
+ * @brief Moves to the state after the first InCommandIndex commands.
+ *
+ * Plays forward from the current position when that is no further than the nearest keyframe,
+ * so stepping through a replay one command at a time stays cheap.
+ *
+ * @param InCommandIndex Number of commands applied afterwards (clamped to the log).
+ */
+void FBattleReplayPlayer::SeekToCommand(int32 InCommandIndex)
+{
+    const int32 Target = FMath::Clamp(InCommandIndex, 0, Commands.Num());
+    const int32 Keyframe = Target / KeyframeInterval;
+
+    if (Target < CommandIndex || CommandIndex < Keyframe * KeyframeInterval)
+    {
+        State = Keyframes[Keyframe];
+        CommandIndex = Keyframe * KeyframeInterval;
+    }
+
+    for (; CommandIndex < Target; ++CommandIndex)
+    {
+        ApplyCommand(Board, State, Commands[CommandIndex]);
+    }
+
+    State.RefreshHash();
+}
+
+/**
+ * @brief Moves to the start of a turn, before its first command.
+ * @param Turn 0 is the starting side's first turn; every EndTurn starts the next one.
+ * @return false if the replay has no such turn.
+ */
+bool FBattleReplayPlayer::SeekToTurn(int32 Turn)
+{
+    if (!TurnStarts.IsValidIndex(Turn))
+        return false;
+
+    SeekToCommand(TurnStarts[Turn]);
+    return true;
+}
+
+/**
+ * @brief Applies one command to a state, trusting the recorded dice.
+ *
+ * Only the hash is left stale; callers refresh it once they are done applying commands.
+ *
+ * @param Board The board whose archetype table placed units must be in.
+ * @param State The state to update.
+ * @param Command The command.
+ * @return false if the command names a unit or slot the state does not have.
+ */
+bool FBattleReplayPlayer::ApplyCommand(const FBattleBoard& Board, FBattleState& State, const FBattleReplayCommand& Command)
+{
+    switch (Command.Type)
+    {
+    case EBattleReplayCommand::Place:
+        if (Command.Unit != State.NumUnits || Command.Target > 1 || !Board.Archetypes->IsValid(Command.Archetype))
+            return false;
+
+        return State.AddUnit(Board, static_cast<EBattleArchetype>(Command.Archetype), Command.Target, FIntPoint(Command.X, Command.Y)) != INDEX_NONE;
+
+    case EBattleReplayCommand::Move:
+    {
+        if (Command.Unit >= State.NumUnits)
+            return false;
+
+        FBattleUnit& Unit = State.Units[Command.Unit];
+        Unit.X = Command.X;
+        Unit.Y = Command.Y;
+        Unit.Flags |= FBattleUnit::Flag_Moved;
+        return true;
+    }
+
+    case EBattleReplayCommand::Attack:
+    {
+        if (Command.Unit >= State.NumUnits || Command.Target >= State.NumUnits)
+            return false;
+
+        FBattleUnit& Attacker = State.Units[Command.Unit];
+        FBattleUnit& Target = State.Units[Command.Target];
+        Target.Health = static_cast<int16>(FMath::Max(Target.Health - Command.X, 0));
+        Attacker.Health = static_cast<int16>(FMath::Max(Attacker.Health - Command.Y, 0));
+        Attacker.Flags |= FBattleUnit::Flag_Attacked;
+        return true;
+    }
+
+    case EBattleReplayCommand::EndTurn:
+        State.SideToMove ^= 1;
+        ++State.TurnNumber;
+        for (int32 Index = 0; Index < State.NumUnits; ++Index)
+        {
+            if (State.Units[Index].Team == State.SideToMove)
+            {
+                State.Units[Index].Flags = 0;
+            }
+        }
+        return true;
+
+    default:
+        return false;
+    }
+}
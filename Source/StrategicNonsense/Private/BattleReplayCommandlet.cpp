@@ -0,0 +1,62 @@
+#include "BattleReplayCommandlet.h"
+#include "StrategicNonsense.h"
+#include "BattleReplay.h"
+#include "HAL/PlatformTime.h"
+
+UBattleReplayCommandlet::UBattleReplayCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+/**
+ * @brief Loads and validates the replay, seeks to the requested turn and logs every unit.
+ * @param Params Command line parameters (see the class comment).
+ * @return 0 on success, 1 if the replay is missing or malformed or the turn does not exist.
+ */
+int32 UBattleReplayCommandlet::Main(const FString& Params)
+{
+    FString ReplayPath;
+    if (!FParse::Value(*Params, TEXT("Replay="), ReplayPath))
+    {
+        UE_LOG(LogSNGame, Error, TEXT("Missing -Replay=<path>."));
+        return 1;
+    }
+
+    FBattleReplay Replay;
+    if (!Replay.LoadFromFile(ReplayPath))
+        return 1;
+
+    FBattleReplayPlayer Player;
+    const double StartTime = FPlatformTime::Seconds();
+    if (!Player.Initialise(Replay))
+        return 1;
+    const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+    UE_LOG(LogSNGame, Display, TEXT("Replay %s: seed %d (map %d, combat %d, AI %d), %dx%d, %d commands over %d turns, played in %.3f ms (%.0f commands/s)"),
+        *ReplayPath, Replay.MatchSeed, Replay.StreamSeeds[0], Replay.StreamSeeds[1], Replay.StreamSeeds[2],
+        Replay.GridSizeX, Replay.GridSizeY, Player.GetNumCommands(), Player.GetNumTurns(),
+        Seconds * 1000.0, Seconds > 0.0 ? Player.GetNumCommands() / Seconds : 0.0);
+
+    int32 Turn = INDEX_NONE;
+    if (FParse::Value(*Params, TEXT("Turn="), Turn) && !Player.SeekToTurn(Turn))
+    {
+        UE_LOG(LogSNGame, Error, TEXT("The replay has no turn %d (turns 0 to %d)."), Turn, Player.GetNumTurns() - 1);
+        return 1;
+    }
+
+    const FBattleState& State = Player.GetState();
+    UE_LOG(LogSNGame, Display, TEXT("After command %d: turn %d, team %d to move, hash %016llx"),
+        Player.GetCommandIndex(), State.TurnNumber, State.SideToMove, State.Hash);
+
+    for (int32 Index = 0; Index < State.NumUnits; ++Index)
+    {
+        const FBattleUnit& Unit = State.Units[Index];
+        UE_LOG(LogSNGame, Display, TEXT("  Unit %d: team %d, archetype %d at (%d, %d), %d HP"), Index, Unit.Team,
+            static_cast<int32>(Unit.Archetype), Unit.X, Unit.Y, Unit.Health);
+    }
+
+    return 0;
+}
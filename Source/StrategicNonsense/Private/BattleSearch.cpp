@@ -0,0 +1,552 @@
+#include "BattleSearch.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    // Evaluation weights, in score points
+    constexpr int32 AliveUnitValue = 400;
+    constexpr int32 HealthPointValue = 10;
+    constexpr int32 HealthFractionValue = 200;
+    constexpr int32 ThreatValue = 30;
+    constexpr int32 ApproachValue = 2;
+    constexpr int32 MaxApproachPenalty = 50;
+
+    constexpr int32 NodesBetweenTimeChecks = 1024;
+
+    // Scores this close to +-WinScore are wins or losses, stored relative to the node's ply
+    constexpr int32 ForcedScoreMargin = 1000;
+
+    // Evaluation is from the root side's view, so the two perspectives must not share entries
+    constexpr uint64 RootSideKey = 0x9E3779B97F4A7C15ull;
+
+    int32 ScoreToTable(int32 Score, int32 Ply)
+    {
+        if (Score >= FBattleSearch::WinScore - ForcedScoreMargin) return Score + Ply;
+        if (Score <= -FBattleSearch::WinScore + ForcedScoreMargin) return Score - Ply;
+        return Score;
+    }
+
+    int32 ScoreFromTable(int32 Score, int32 Ply)
+    {
+        if (Score >= FBattleSearch::WinScore - ForcedScoreMargin) return Score - Ply;
+        if (Score <= -FBattleSearch::WinScore + ForcedScoreMargin) return Score + Ply;
+        return Score;
+    }
+
+    /** Distance from a cell to the nearest living enemy of a team, or MAX_int32 if none. */
+    int32 GetNearestEnemyDistance(const FBattleState& State, uint8 Team, const FIntPoint& From)
+    {
+        int32 Nearest = MAX_int32;
+        for (int32 Index = 0; Index < State.NumUnits; ++Index)
+        {
+            const FBattleUnit& Other = State.Units[Index];
+            if (Other.Team != Team && Other.IsAlive())
+            {
+                Nearest = FMath::Min(Nearest, FBattleState::GetDistance(From, Other.GetCell()));
+            }
+        }
+        return Nearest;
+    }
+}
+
+/**
+ * @brief Creates a search over a fixed board. The board must outlive the search.
+ * @param InBoard Terrain shared by every searched state.
+ */
+FBattleSearch::FBattleSearch(const FBattleBoard& InBoard)
+    : Board(InBoard)
+{
+}
+
+/**
+ * @brief Picks the best action for the side to move using iterative deepening.
+ *
+ * Each iteration searches one ply deeper with the previous best action ordered first.
+ * When the budget runs out mid-iteration, the result of the last completed iteration is kept.
+ *
+ * @param Root The state to search from; it is copied and never modified.
+ * @param Settings Time and depth limits.
+ * @return The chosen action and search statistics.
+ */
+FBattleSearchResult FBattleSearch::FindBestAction(const FBattleState& Root, const FBattleSearchSettings& Settings)
+{
+    FBattleSearchResult Result;
+
+    ActiveSettings = Settings;
+    RootSide = Root.SideToMove;
+    BoardKey = ActiveSettings.TranspositionTable ? Board.ComputeKey() : 0;
+    Deadline = FPlatformTime::Seconds() + Settings.TimeBudgetSeconds;
+    Nodes = 0;
+    bAborted = false;
+    TableStats = FBattleTranspositionTable::FStats();
+
+    if (ActionStack.Num() < Settings.MaxDepth + 1)
+    {
+        ActionStack.SetNum(Settings.MaxDepth + 1);
+    }
+
+    FBattleState State = Root;
+
+    TArray<FBattleAction> RootActions;
+    State.GenerateActions(Board, Scratch, RootActions);
+    if (RootActions.IsEmpty())
+        return Result;
+
+    OrderActions(State, RootActions, nullptr);
+    Result.BestAction = RootActions[0];
+    Result.bHasAction = true;
+
+    for (int32 Depth = 1; Depth <= Settings.MaxDepth; ++Depth)
+    {
+        int32 Alpha = -WinScore;
+        int32 BestScore = MIN_int32;
+        FBattleAction BestAction = RootActions[0];
+
+        for (const FBattleAction& Action : RootActions)
+        {
+            const int32 Score = SearchAction(State, Action, Depth, Alpha, WinScore, 0);
+            if (bAborted)
+                break;
+
+            if (Score > BestScore)
+            {
+                BestScore = Score;
+                BestAction = Action;
+                Alpha = FMath::Max(Alpha, Score);
+            }
+        }
+
+        if (bAborted)
+            break;
+
+        Result.BestAction = BestAction;
+        Result.Score = BestScore;
+        Result.CompletedDepth = Depth;
+
+        // Search the current best first next iteration
+        const int32 BestIndex = RootActions.Find(BestAction);
+        if (BestIndex > 0)
+        {
+            RootActions.RemoveAt(BestIndex);
+            RootActions.Insert(BestAction, 0);
+        }
+
+        // A forced result was found; deeper search cannot change it
+        if (FMath::Abs(BestScore) >= WinScore - Settings.MaxDepth)
+            break;
+    }
+
+    Result.NodesSearched = Nodes;
+    Result.TableStats = TableStats;
+    if (Settings.TranspositionTable)
+    {
+        Settings.TranspositionTable->RecordStats(TableStats);
+    }
+    return Result;
+}
+
+/**
+ * @brief Enumerates the distinct dice results of an attack.
+ *
+ * Damage is uniform over the attacker's range and counter damage uniform over 1-3.
+ * All rolls that kill the target (or the attacker, for counters) are merged into one outcome.
+ * Non-attacks produce a single certain outcome.
+ *
+ * @param Board The board whose archetype table gives the damage ranges.
+ * @param State The state before the action.
+ * @param Action The action to resolve.
+ * @param OutOutcomes Receives the outcomes and their probabilities.
+ */
+void FBattleSearch::GetAttackOutcomes(const FBattleBoard& Board, const FBattleState& State, const FBattleAction& Action, TArray<FWeightedOutcome, TInlineAllocator<16>>& OutOutcomes)
+{
+    OutOutcomes.Reset();
+
+    if (!Action.HasAttack())
+    {
+        OutOutcomes.Add({ FBattleOutcome(), 1.0 });
+        return;
+    }
+
+    const FBattleUnit& Attacker = State.Units[Action.Unit];
+    const FBattleUnit& Target = State.Units[Action.Target];
+    const FBattleUnitStats& Stats = Board.GetStats(Attacker);
+    const FBattleUnitStats& TargetStats = Board.GetStats(Target);
+
+    const int32 NumDamageRolls = Stats.DamageMax - Stats.DamageMin + 1;
+    const double DamageProbability = 1.0 / NumDamageRolls;
+    const bool bCounter = State.WouldCounterattack(Board, Action.Unit, Action.GetDestination(), Action.Target);
+
+    const int32 CounterMin = TargetStats.CounterDamageMin;
+    const int32 CounterMax = TargetStats.CounterDamageMax;
+    const double CounterProbability = 1.0 / (CounterMax - CounterMin + 1);
+
+    double LethalProbability = 0.0;
+
+    for (int32 Damage = Stats.DamageMin; Damage <= Stats.DamageMax; ++Damage)
+    {
+        if (Damage >= Target.Health)
+        {
+            LethalProbability += DamageProbability;
+            continue;
+        }
+
+        if (!bCounter)
+        {
+            OutOutcomes.Add({ { static_cast<int16>(Damage), 0 }, DamageProbability });
+            continue;
+        }
+
+        double CounterLethalProbability = 0.0;
+        for (int32 Counter = CounterMin; Counter <= CounterMax; ++Counter)
+        {
+            if (Counter >= Attacker.Health)
+            {
+                CounterLethalProbability += DamageProbability * CounterProbability;
+                continue;
+            }
+            OutOutcomes.Add({ { static_cast<int16>(Damage), static_cast<int16>(Counter) }, DamageProbability * CounterProbability });
+        }
+
+        if (CounterLethalProbability > 0.0)
+        {
+            OutOutcomes.Add({ { static_cast<int16>(Damage), Attacker.Health }, CounterLethalProbability });
+        }
+    }
+
+    if (LethalProbability > 0.0)
+    {
+        OutOutcomes.Add({ { Target.Health, 0 }, LethalProbability });
+    }
+}
+
+/**
+ * @brief Static evaluation from the root side's point of view.
+ *
+ * Counts surviving units, raw and relative health, and whether each unit can reach an
+ * enemy with its next activation (with a small pull towards the enemy when it cannot).
+ *
+ * @param State The state to evaluate.
+ * @return Score in (-WinScore, WinScore).
+ */
+int32 FBattleSearch::Evaluate(const FBattleState& State) const
+{
+    int32 Score = 0;
+
+    for (int32 Index = 0; Index < State.NumUnits; ++Index)
+    {
+        const FBattleUnit& Unit = State.Units[Index];
+        if (!Unit.IsAlive())
+            continue;
+
+        const FBattleUnitStats& Stats = Board.GetStats(Unit);
+        int32 Value = AliveUnitValue + Unit.Health * HealthPointValue + (HealthFractionValue * Unit.Health) / FMath::Max<int32>(Stats.MaxHealth, 1);
+
+        // Reward being able to strike next activation, and closing in otherwise
+        const int32 Reach = Stats.Movement + Stats.AttackRange;
+        const int32 Nearest = GetNearestEnemyDistance(State, Unit.Team, Unit.GetCell());
+        if (Nearest <= Reach)
+        {
+            Value += ThreatValue;
+        }
+        else if (Nearest != MAX_int32)
+        {
+            Value -= FMath::Min(Nearest - Reach, MaxApproachPenalty) * ApproachValue;
+        }
+
+        Score += (Unit.Team == RootSide) ? Value : -Value;
+    }
+
+    return Score;
+}
+
+/**
+ * @brief Alpha-beta decision node (fail-hard). Maximises for the root side, minimises otherwise.
+ * @param State The state to search; restored before returning.
+ * @param Depth Remaining plies.
+ * @param Alpha Lower bound of the search window.
+ * @param Beta Upper bound of the search window.
+ * @param Ply Distance from the root.
+ * @return The node value clamped to [Alpha, Beta].
+ */
+int32 FBattleSearch::SearchDecision(FBattleState& State, int32 Depth, int32 Alpha, int32 Beta, int32 Ply)
+{
+    if (ShouldAbort())
+        return Alpha;
+
+    const EBattleResult Result = State.GetResult();
+    if (Result != EBattleResult::Ongoing)
+        return FMath::Clamp(ScoreTerminal(Result, Ply), Alpha, Beta);
+
+    if (Depth <= 0)
+        return FMath::Clamp(Evaluate(State), Alpha, Beta);
+
+    FBattleTranspositionTable* Table = ActiveSettings.TranspositionTable;
+    const uint64 Key = Table ? GetTableKey(State) : 0;
+
+    FBattleTTEntry Entry;
+    const bool bTableHit = Table && Table->Probe(Key, Entry);
+    if (Table)
+    {
+        ++TableStats.Probes;
+        TableStats.Hits += bTableHit ? 1 : 0;
+    }
+
+    if (bTableHit && Entry.Depth >= Depth)
+    {
+        const int32 Stored = ScoreFromTable(Entry.Score, Ply);
+        if (Entry.Bound == EBattleBound::Exact)
+            return FMath::Clamp(Stored, Alpha, Beta);
+        if (Entry.Bound == EBattleBound::Lower && Stored >= Beta)
+            return Beta;
+        if (Entry.Bound == EBattleBound::Upper && Stored <= Alpha)
+            return Alpha;
+    }
+
+    if (ActionStack.Num() <= Ply)
+    {
+        ActionStack.SetNum(Ply + 1);
+    }
+
+    TArray<FBattleAction>& Actions = ActionStack[Ply];
+    State.GenerateActions(Board, Scratch, Actions);
+    if (Actions.IsEmpty())
+        return FMath::Clamp(Evaluate(State), Alpha, Beta);
+
+    // The stored best action is only a hint: OrderActions ignores it unless it is in the list
+    OrderActions(State, Actions, (bTableHit && Entry.bHasBestAction) ? &Entry.BestAction : nullptr);
+
+    const int32 NumToSearch = (ActiveSettings.MaxBranching > 0) ? FMath::Min(Actions.Num(), ActiveSettings.MaxBranching) : Actions.Num();
+    const bool bMaximising = State.SideToMove == RootSide;
+    const int32 OriginalAlpha = Alpha;
+    const int32 OriginalBeta = Beta;
+
+    FBattleAction BestAction = ActionStack[Ply][0];
+    int32 BestScore = bMaximising ? MIN_int32 : MAX_int32;
+
+    for (int32 Index = 0; Index < NumToSearch; ++Index)
+    {
+        // Copy, and index through ActionStack: a deeper ply may grow the stack and move this array
+        const FBattleAction Action = ActionStack[Ply][Index];
+        const int32 Score = SearchAction(State, Action, Depth, Alpha, Beta, Ply);
+        if (bAborted)
+            return Alpha;
+
+        if (bMaximising ? Score > BestScore : Score < BestScore)
+        {
+            BestScore = Score;
+            BestAction = Action;
+        }
+
+        if (bMaximising)
+        {
+            Alpha = FMath::Max(Alpha, Score);
+        }
+        else
+        {
+            Beta = FMath::Min(Beta, Score);
+        }
+
+        if (Alpha >= Beta)
+            break;
+    }
+
+    const int32 Value = (Alpha >= Beta) ? (bMaximising ? Beta : Alpha) : (bMaximising ? Alpha : Beta);
+
+    if (Table)
+    {
+        FBattleTTEntry NewEntry;
+        NewEntry.Score = ScoreToTable(Value, Ply);
+        NewEntry.Depth = Depth;
+        NewEntry.Bound = (Value <= OriginalAlpha) ? EBattleBound::Upper : (Value >= OriginalBeta) ? EBattleBound::Lower : EBattleBound::Exact;
+        NewEntry.bHasBestAction = true;
+        NewEntry.BestAction = BestAction;
+        Table->Store(Key, NewEntry);
+        ++TableStats.Stores;
+    }
+
+    return Value;
+}
+
+/**
+ * @brief Applies an action and searches the resulting position; attacks become chance nodes.
+ *
+ * Chance nodes use Star1 pruning: before each outcome is searched, the window it would need
+ * to stay inside for the weighted sum to land in [Alpha, Beta] is derived from the evaluation
+ * bounds, and the node cuts off as soon as one outcome falls outside it.
+ *
+ * @param State The state to search; restored before returning.
+ * @param Action The action to apply.
+ * @param Depth Remaining plies including this action.
+ * @param Alpha Lower bound of the search window.
+ * @param Beta Upper bound of the search window.
+ * @param Ply Distance from the root.
+ * @return The (expected) value clamped to [Alpha, Beta].
+ */
+int32 FBattleSearch::SearchAction(FBattleState& State, const FBattleAction& Action, int32 Depth, int32 Alpha, int32 Beta, int32 Ply)
+{
+    TArray<FWeightedOutcome, TInlineAllocator<16>> Outcomes;
+    GetAttackOutcomes(Board, State, Action, Outcomes);
+
+    FBattleUndo Undo;
+
+    if (Outcomes.Num() == 1)
+    {
+        State.ApplyAction(Board, Action, Outcomes[0].Outcome, Undo);
+        const int32 Score = SearchDecision(State, Depth - 1, Alpha, Beta, Ply + 1);
+        State.UndoAction(Action, Undo);
+        return Score;
+    }
+
+    // Likeliest outcomes first give Star1 its tightest windows early
+    Outcomes.Sort([](const FWeightedOutcome& A, const FWeightedOutcome& B) { return A.Probability > B.Probability; });
+
+    const double Lower = -WinScore;
+    const double Upper = WinScore;
+    double WeightedSum = 0.0;
+    double RemainingProbability = 1.0;
+
+    for (const FWeightedOutcome& Weighted : Outcomes)
+    {
+        const double Probability = Weighted.Probability;
+        RemainingProbability = FMath::Max(RemainingProbability - Probability, 0.0);
+
+        const double ChildLower = (Alpha - WeightedSum - Upper * RemainingProbability) / Probability;
+        const double ChildUpper = (Beta - WeightedSum - Lower * RemainingProbability) / Probability;
+
+        const int32 ChildAlpha = static_cast<int32>(FMath::Max(Lower, FMath::FloorToDouble(ChildLower)));
+        const int32 ChildBeta = static_cast<int32>(FMath::Min(Upper, FMath::CeilToDouble(ChildUpper)));
+
+        State.ApplyAction(Board, Action, Weighted.Outcome, Undo);
+        const int32 Score = SearchDecision(State, Depth - 1, ChildAlpha, ChildBeta, Ply + 1);
+        State.UndoAction(Action, Undo);
+
+        if (bAborted)
+            return Alpha;
+
+        if (Score <= ChildLower)
+            return Alpha; // Even best-case remaining outcomes cannot lift the sum above Alpha
+
+        if (Score >= ChildUpper)
+            return Beta; // Even worst-case remaining outcomes keep the sum above Beta
+
+        WeightedSum += Probability * Score;
+    }
+
+    return FMath::Clamp(FMath::RoundToInt(WeightedSum), Alpha, Beta);
+}
+
+/**
+ * @brief Scores a finished match, preferring quicker wins and slower losses.
+ * @param Result The match result.
+ * @param Ply Distance from the root.
+ * @return Score from the root side's point of view.
+ */
+int32 FBattleSearch::ScoreTerminal(EBattleResult Result, int32 Ply) const
+{
+    if (Result == EBattleResult::Draw)
+        return 0;
+
+    const uint8 Winner = (Result == EBattleResult::Team0Wins) ? 0 : 1;
+    return (Winner == RootSide) ? WinScore - Ply : -WinScore + Ply;
+}
+
+/**
+ * @brief Sorts actions so the most promising are searched first.
+ *
+ * Attacks come first, ranked by expected damage and kill chance minus counter risk;
+ * every action also prefers ending at the unit's attack range from the nearest enemy.
+ *
+ * @param State The state the actions belong to.
+ * @param Actions The actions to sort in place.
+ * @param FirstAction Optional action to force to the front (e.g. the previous best).
+ */
+void FBattleSearch::OrderActions(const FBattleState& State, TArray<FBattleAction>& Actions, const FBattleAction* FirstAction) const
+{
+    struct FScoredAction
+    {
+        FBattleAction Action;
+        int32 Key;
+    };
+
+    TArray<FScoredAction, TInlineAllocator<256>> Scored;
+    Scored.Reserve(Actions.Num());
+
+    for (const FBattleAction& Action : Actions)
+    {
+        const FBattleUnit& Unit = State.Units[Action.Unit];
+        const FBattleUnitStats& Stats = Board.GetStats(Unit);
+        const FIntPoint Destination = Action.GetDestination();
+
+        int32 Key = 0;
+
+        if (Action.HasAttack())
+        {
+            const FBattleUnit& Target = State.Units[Action.Target];
+            const int32 ExpectedDamage = FMath::Min<int32>((Stats.DamageMin + Stats.DamageMax) / 2, Target.Health);
+
+            Key += 10000 + ExpectedDamage * 100;
+            if (Stats.DamageMax >= Target.Health)
+            {
+                Key += 5000;
+            }
+            if (State.WouldCounterattack(Board, Action.Unit, Destination, Action.Target))
+            {
+                Key -= 200;
+            }
+        }
+
+        const int32 Nearest = GetNearestEnemyDistance(State, Unit.Team, Destination);
+        if (Nearest != MAX_int32)
+        {
+            Key -= FMath::Abs(Nearest - Stats.AttackRange) * 10;
+        }
+
+        if (FirstAction && Action == *FirstAction)
+        {
+            Key = MAX_int32;
+        }
+
+        Scored.Add({ Action, Key });
+    }
+
+    Scored.StableSort([](const FScoredAction& A, const FScoredAction& B) { return A.Key > B.Key; });
+
+    for (int32 Index = 0; Index < Scored.Num(); ++Index)
+    {
+        Actions[Index] = Scored[Index].Action;
+    }
+}
+
+/**
+ * @brief Key for a state in the transposition table, separating the two root perspectives and boards.
+ * @param State The state to key.
+ * @return The table key.
+ */
+uint64 FBattleSearch::GetTableKey(const FBattleState& State) const
+{
+    return (RootSide ? State.Hash ^ RootSideKey : State.Hash) ^ BoardKey;
+}
+
+/**
+ * @brief Counts a node and checks the deadline and cancel flag every few thousand nodes.
+ * @return true once the search has run out of time or was cancelled.
+ */
+bool FBattleSearch::ShouldAbort()
+{
+    if (bAborted)
+        return true;
+
+    if (ActiveSettings.MaxNodes > 0 && Nodes >= ActiveSettings.MaxNodes)
+    {
+        bAborted = true;
+        return true;
+    }
+
+    if ((++Nodes % NodesBetweenTimeChecks) == 0)
+    {
+        const bool bCancelled = ActiveSettings.CancelFlag && ActiveSettings.CancelFlag->load(std::memory_order_relaxed);
+        bAborted = bCancelled || FPlatformTime::Seconds() >= Deadline;
+    }
+
+    return bAborted;
+}
@@ -0,0 +1,591 @@
+#include "BattleState.h"
+#include "GridLineOfSight.h"
+
+namespace
+{
+    const FIntPoint GBattleDirections[] = {
+        FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1)
+    };
+
+    // Built-in rules, used until the game publishes the unit archetype DataTable. AttackType
+    // values are EAttackType::ShortRange (0) and EAttackType::Ranged (1).
+    //                              HP  Move Range Dmg    Type  Counter  CDmg   Flags
+    const FBattleUnitStats GBuiltInUnitStats[] = {
+        /* Sniper  */ { 20, 3,   10,   4, 8,  1,    10,      1, 3,  FBattleUnitStats::Flag_ProvokesCounters },
+        /* Brawler */ { 40, 6,   1,    1, 6,  0,    1,       1, 3,  0 },
+    };
+
+    static_assert(UE_ARRAY_COUNT(GBuiltInUnitStats) == static_cast<int32>(EBattleArchetype::NumBuiltIn), "Missing stats for an archetype");
+
+    // Zobrist key domains. Keys are derived on the fly instead of looked up, so grids of any
+    // size need no per-cell tables.
+    enum class EZobristDomain : uint64
+    {
+        Cell = 1,
+        Health = 2,
+        Flags = 3,
+        Side = 4,
+        Identity = 5,
+        Terrain = 6,
+    };
+
+    /** SplitMix64 finaliser: a cheap bijective mix with full avalanche. */
+    uint64 MixZobristKey(uint64 Value)
+    {
+        Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+        return Value ^ (Value >> 31);
+    }
+
+    uint64 GetZobristKey(EZobristDomain Domain, int32 Slot, uint32 A, uint32 B = 0)
+    {
+        return MixZobristKey((static_cast<uint64>(Domain) << 60) | (static_cast<uint64>(Slot & 0xF) << 52) |
+            (static_cast<uint64>(A & 0x3FFFFFF) << 26) | (B & 0x3FFFFFF));
+    }
+}
+
+TSharedRef<const FBattleArchetypeTable, ESPMode::ThreadSafe> FBattleArchetypeTable::Active = MakeShared<const FBattleArchetypeTable, ESPMode::ThreadSafe>(FBattleArchetypeTable::GetBuiltIn());
+
+/**
+ * @brief An empty table; every ID is invalid until SetStats fills it.
+ */
+FBattleArchetypeTable::FBattleArchetypeTable()
+{
+    FMemory::Memzero(Stats, sizeof(Stats));
+}
+
+/**
+ * @brief Sets the stats of one archetype, growing the table to cover its ID.
+ * @param ArchetypeId ID to fill; IDs skipped on the way stay invalid.
+ * @param InStats The archetype's rules. MaxHealth must be positive and DamageMin no greater than DamageMax.
+ * @return false if the ID is out of range or the stats are unusable.
+ */
+bool FBattleArchetypeTable::SetStats(int32 ArchetypeId, const FBattleUnitStats& InStats)
+{
+    if (ArchetypeId < 0 || ArchetypeId >= MaxArchetypes || InStats.MaxHealth <= 0 ||
+        InStats.DamageMin > InStats.DamageMax || InStats.CounterDamageMin > InStats.CounterDamageMax)
+    {
+        return false;
+    }
+
+    Stats[ArchetypeId] = InStats;
+    NumArchetypes = FMath::Max(NumArchetypes, ArchetypeId + 1);
+    return true;
+}
+
+/**
+ * @brief The built-in Sniper and Brawler rules.
+ */
+const FBattleArchetypeTable& FBattleArchetypeTable::GetBuiltIn()
+{
+    static const FBattleArchetypeTable BuiltIn = []()
+    {
+        FBattleArchetypeTable Table;
+        for (int32 Index = 0; Index < static_cast<int32>(EBattleArchetype::NumBuiltIn); ++Index)
+        {
+            Table.SetStats(Index, GBuiltInUnitStats[Index]);
+        }
+        return Table;
+    }();
+    return BuiltIn;
+}
+
+/**
+ * @brief Makes a copy of Table the active snapshot, read by gameplay and by boards made from now on.
+ *
+ * Boards made earlier keep the snapshot they hold, so planning tasks still in flight are unaffected.
+ *
+ * @param Table The new table; it is copied.
+ */
+void FBattleArchetypeTable::Publish(const FBattleArchetypeTable& Table)
+{
+    Active = MakeShared<const FBattleArchetypeTable, ESPMode::ThreadSafe>(Table);
+}
+
+/**
+ * @brief Copies the terrain from a live occupancy layer, dropping cells that are occupied by units,
+ *        and takes the active archetype table.
+ * @param Occupancy The grid manager's occupancy layer.
+ */
+void FBattleBoard::InitialiseFromOccupancy(const FGridOccupancy& Occupancy)
+{
+    Terrain = Occupancy;
+    LineOfSightAttackTypes = 0;
+    Archetypes = FBattleArchetypeTable::GetSnapshot();
+
+    for (int32 Y = 0; Y < Terrain.GetHeight(); ++Y)
+    {
+        for (int32 X = 0; X < Terrain.GetWidth(); ++X)
+        {
+            const FIntPoint Cell(X, Y);
+            if (Terrain.GetUnitIndex(Cell) != INDEX_NONE)
+            {
+                Terrain.SetBlocked(Cell, false);
+                Terrain.SetUnitIndex(Cell, INDEX_NONE);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Key of the terrain and line-of-sight rules, for salting transposition table keys.
+ *
+ * Two boards only share a key if their size, blocked cells and line-of-sight attack types match,
+ * so a table kept across captures never mixes scores from different boards.
+ *
+ * @return The board's key; computed on every call (one pass over the cells).
+ */
+uint64 FBattleBoard::ComputeKey() const
+{
+    uint64 Key = GetZobristKey(EZobristDomain::Terrain, 0, Terrain.GetWidth(), Terrain.GetHeight()) ^
+        GetZobristKey(EZobristDomain::Terrain, 1, LineOfSightAttackTypes);
+
+    for (int32 Index = 0; Index < Terrain.GetNumCells(); ++Index)
+    {
+        if (Terrain.IsBlockedIndex(Index))
+        {
+            Key ^= GetZobristKey(EZobristDomain::Terrain, 2, Index);
+        }
+    }
+    return Key;
+}
+
+/**
+ * @brief Sizes the scratch buffers for a grid and starts a new visit generation.
+ * @param NumCells Number of cells in the grid.
+ */
+void FBattleScratch::Prepare(int32 NumCells)
+{
+    if (VisitStamp.Num() != NumCells || Generation == MAX_uint32)
+    {
+        VisitStamp.Reset();
+        VisitStamp.SetNumZeroed(NumCells);
+        Distance.SetNumUninitialized(NumCells);
+        Generation = 0;
+    }
+
+    ++Generation;
+    Queue.Reset();
+}
+
+/**
+ * @brief Computes the Zobrist key of the state from scratch.
+ * @return The key that Hash holds when it is up to date.
+ */
+uint64 FBattleState::ComputeHash() const
+{
+    uint64 Result = SideToMove ? GetZobristKey(EZobristDomain::Side, 0, 0) : 0;
+    for (int32 Index = 0; Index < NumUnits; ++Index)
+    {
+        Result ^= GetUnitHash(Index, Units[Index]);
+    }
+    return Result;
+}
+
+/**
+ * @brief Zobrist contribution of one unit slot: its archetype and team, cell, exact health and turn flags.
+ * @param Slot The unit's slot index.
+ * @param Unit The unit.
+ * @return The slot's key.
+ */
+uint64 FBattleState::GetUnitHash(int32 Slot, const FBattleUnit& Unit)
+{
+    return GetZobristKey(EZobristDomain::Cell, Slot, static_cast<uint16>(Unit.X), static_cast<uint16>(Unit.Y)) ^
+        GetZobristKey(EZobristDomain::Health, Slot, static_cast<uint16>(Unit.Health)) ^
+        GetZobristKey(EZobristDomain::Flags, Slot, Unit.Flags) ^
+        GetZobristKey(EZobristDomain::Identity, Slot, static_cast<uint8>(Unit.Archetype), Unit.Team);
+}
+
+/**
+ * @brief Adds a unit at full health to the next free slot.
+ * @param Board The board whose archetype table gives the unit's health.
+ * @param Archetype The unit's archetype.
+ * @param Team Owning team (0 or 1).
+ * @param Cell Starting grid coordinate.
+ * @return The slot index, or INDEX_NONE if all slots are used.
+ */
+int32 FBattleState::AddUnit(const FBattleBoard& Board, EBattleArchetype Archetype, uint8 Team, const FIntPoint& Cell)
+{
+    if (NumUnits >= MaxUnits)
+        return INDEX_NONE;
+
+    FBattleUnit& Unit = Units[NumUnits];
+    Unit = FBattleUnit();
+    Unit.X = static_cast<int16>(Cell.X);
+    Unit.Y = static_cast<int16>(Cell.Y);
+    Unit.Archetype = Archetype;
+    Unit.Health = Board.GetStats(Archetype).MaxHealth;
+    Unit.Team = Team;
+
+    Hash ^= GetUnitHash(NumUnits, Unit);
+    return NumUnits++;
+}
+
+/**
+ * @brief Checks whether a cell is inside the board and free of obstacles and living units.
+ * @param Board The shared terrain.
+ * @param Cell The grid coordinate.
+ * @return true if a unit could stand on the cell.
+ */
+bool FBattleState::IsCellFree(const FBattleBoard& Board, const FIntPoint& Cell) const
+{
+    return Board.Terrain.IsValidCell(Cell) && !Board.Terrain.IsBlocked(Cell) && GetUnitAt(Cell) == INDEX_NONE;
+}
+
+/**
+ * @brief Finds the living unit standing on a cell.
+ * @param Cell The grid coordinate.
+ * @return The unit's slot index, or INDEX_NONE.
+ */
+int32 FBattleState::GetUnitAt(const FIntPoint& Cell) const
+{
+    for (int32 Index = 0; Index < NumUnits; ++Index)
+    {
+        if (Units[Index].IsAlive() && Units[Index].GetCell() == Cell)
+            return Index;
+    }
+    return INDEX_NONE;
+}
+
+/**
+ * @brief Checks whether a team still has at least one living unit.
+ * @param Team The team index.
+ * @return true if any unit of the team is alive.
+ */
+bool FBattleState::HasLivingUnits(uint8 Team) const
+{
+    for (int32 Index = 0; Index < NumUnits; ++Index)
+    {
+        if (Units[Index].Team == Team && Units[Index].IsAlive())
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Evaluates the win condition used by ABattleGameMode::CheckGameEnd.
+ * @return The match result for this state.
+ */
+EBattleResult FBattleState::GetResult() const
+{
+    const bool bTeam0Alive = HasLivingUnits(0);
+    const bool bTeam1Alive = HasLivingUnits(1);
+
+    if (!bTeam0Alive && !bTeam1Alive) return EBattleResult::Draw;
+    if (!bTeam0Alive) return EBattleResult::Team1Wins;
+    if (!bTeam1Alive) return EBattleResult::Team0Wins;
+    return EBattleResult::Ongoing;
+}
+
+/**
+ * @brief Breadth-first search over free cells within the unit's movement range.
+ *
+ * Mirrors AGridManager::FindReachableCellsBFS: obstacles and other living units block,
+ * and the unit's own cell is not included in the result.
+ *
+ * @param Board The shared terrain.
+ * @param UnitIndex Slot of the moving unit.
+ * @param Scratch Reusable buffers; Scratch.Distance holds each reached cell's step count afterwards.
+ * @param OutCells Receives the reachable cells.
+ * @return Number of reachable cells.
+ */
+int32 FBattleState::FindReachableCells(const FBattleBoard& Board, int32 UnitIndex, FBattleScratch& Scratch, TArray<FIntPoint>& OutCells) const
+{
+    OutCells.Reset();
+
+    const FGridOccupancy& Terrain = Board.Terrain;
+    const FBattleUnit& Unit = Units[UnitIndex];
+    const int32 MaxRange = Board.GetStats(Unit).Movement;
+
+    Scratch.Prepare(Terrain.GetNumCells());
+    const uint32 Stamp = Scratch.Generation;
+
+    // Other units block movement: mark them visited so the search never enters them
+    for (int32 Index = 0; Index < NumUnits; ++Index)
+    {
+        if (Units[Index].IsAlive())
+        {
+            Scratch.VisitStamp[Terrain.ToIndex(Units[Index].GetCell())] = Stamp;
+        }
+    }
+
+    const int32 StartIndex = Terrain.ToIndex(Unit.GetCell());
+    Scratch.Distance[StartIndex] = 0;
+    Scratch.Queue.Add(Unit.GetCell());
+
+    for (int32 Head = 0; Head < Scratch.Queue.Num(); ++Head)
+    {
+        const FIntPoint Cell = Scratch.Queue[Head];
+        const uint8 Distance = Scratch.Distance[Terrain.ToIndex(Cell)];
+
+        if (Distance >= MaxRange)
+            continue;
+
+        for (const FIntPoint& Dir : GBattleDirections)
+        {
+            const FIntPoint Neighbour = Cell + Dir;
+            if (!Terrain.IsValidCell(Neighbour)) continue;
+            if (Terrain.IsBlocked(Neighbour)) continue;
+
+            const int32 NeighbourIndex = Terrain.ToIndex(Neighbour);
+            if (Scratch.VisitStamp[NeighbourIndex] == Stamp) continue;
+
+            Scratch.VisitStamp[NeighbourIndex] = Stamp;
+            Scratch.Distance[NeighbourIndex] = Distance + 1;
+            Scratch.Queue.Add(Neighbour);
+            OutCells.Add(Neighbour);
+        }
+    }
+
+    return OutCells.Num();
+}
+
+/**
+ * @brief Lists every legal activation for the side to move.
+ *
+ * For each living unit that has not acted: every destination (including staying put),
+ * each combined with either no attack or an attack on any enemy in range from there.
+ * Units that already attacked this turn only get move options.
+ *
+ * @param Board The shared terrain.
+ * @param Scratch Reusable buffers.
+ * @param OutActions Receives the actions.
+ */
+void FBattleState::GenerateActions(const FBattleBoard& Board, FBattleScratch& Scratch, TArray<FBattleAction>& OutActions) const
+{
+    OutActions.Reset();
+
+    if (IsTerminal())
+        return;
+
+    TArray<FIntPoint> Destinations;
+
+    for (int32 UnitIndex = 0; UnitIndex < NumUnits; ++UnitIndex)
+    {
+        const FBattleUnit& Unit = Units[UnitIndex];
+        if (Unit.Team != SideToMove || !Unit.IsAlive() || Unit.HasActed())
+            continue;
+
+        FindReachableCells(Board, UnitIndex, Scratch, Destinations);
+        Destinations.Add(Unit.GetCell());
+
+        for (const FIntPoint& Destination : Destinations)
+        {
+            FBattleAction Action;
+            Action.Unit = static_cast<int8>(UnitIndex);
+            Action.ToX = static_cast<int16>(Destination.X);
+            Action.ToY = static_cast<int16>(Destination.Y);
+            OutActions.Add(Action);
+
+            if (Unit.Flags & FBattleUnit::Flag_Attacked)
+                continue;
+
+            for (int32 TargetIndex = 0; TargetIndex < NumUnits; ++TargetIndex)
+            {
+                const FBattleUnit& Target = Units[TargetIndex];
+                if (Target.Team == SideToMove || !Target.IsAlive())
+                    continue;
+
+                if (IsInRange(Board, UnitIndex, Destination, TargetIndex))
+                {
+                    Action.Target = static_cast<int8>(TargetIndex);
+                    OutActions.Add(Action);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Validates an action against this state (e.g. a queued command after the board changed).
+ * @param Board The shared terrain.
+ * @param Action The action to check.
+ * @param Scratch Reusable buffers.
+ * @return true if the action could be generated by GenerateActions.
+ */
+bool FBattleState::IsActionLegal(const FBattleBoard& Board, const FBattleAction& Action, FBattleScratch& Scratch) const
+{
+    if (Action.Unit < 0 || Action.Unit >= NumUnits || IsTerminal())
+        return false;
+
+    const FBattleUnit& Unit = Units[Action.Unit];
+    if (Unit.Team != SideToMove || !Unit.IsAlive() || Unit.HasActed())
+        return false;
+
+    const FIntPoint Destination = Action.GetDestination();
+    if (Destination != Unit.GetCell())
+    {
+        TArray<FIntPoint> Reachable;
+        FindReachableCells(Board, Action.Unit, Scratch, Reachable);
+        if (!Reachable.Contains(Destination))
+            return false;
+    }
+
+    if (Action.HasAttack())
+    {
+        if (Action.Target >= NumUnits || (Unit.Flags & FBattleUnit::Flag_Attacked))
+            return false;
+
+        const FBattleUnit& Target = Units[Action.Target];
+        if (Target.Team == SideToMove || !Target.IsAlive() || !IsInRange(Board, Action.Unit, Destination, Action.Target))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Manhattan distance between two cells, as used for attack range checks.
+ */
+int32 FBattleState::GetDistance(const FIntPoint& A, const FIntPoint& B)
+{
+    return FMath::Abs(A.X - B.X) + FMath::Abs(A.Y - B.Y);
+}
+
+/**
+ * @brief Mirrors UCombatManager::IsInRange for an attacker standing on a given cell.
+ *
+ * Line of sight is traced directly rather than cached, so the check stays const and safe to call
+ * from search workers.
+ *
+ * @param Board The shared terrain.
+ * @param AttackerIndex Slot of the attacker.
+ * @param From Cell the attacker attacks from.
+ * @param TargetIndex Slot of the target.
+ * @return true if the target is within the attacker's range (and in sight, if its archetype needs it).
+ */
+bool FBattleState::IsInRange(const FBattleBoard& Board, int32 AttackerIndex, const FIntPoint& From, int32 TargetIndex) const
+{
+    const FBattleUnit& Attacker = Units[AttackerIndex];
+    const FIntPoint TargetCell = Units[TargetIndex].GetCell();
+    if (GetDistance(From, TargetCell) > Board.GetStats(Attacker).AttackRange)
+        return false;
+
+    return !Board.RequiresLineOfSight(Attacker.Archetype) || FGridLineOfSight::TraceLine(Board.Terrain, From, TargetCell);
+}
+
+/**
+ * @brief Mirrors the rule in UCombatManager::HandleCounterattack.
+ *
+ * The target counterattacks if the attacker's archetype provokes counters and the attack comes
+ * from within the target's counter range. The caller is responsible for checking that the target survived the attack.
+ *
+ * @param Board The shared terrain and unit stats.
+ * @param AttackerIndex Slot of the attacker.
+ * @param From Cell the attacker attacks from.
+ * @param TargetIndex Slot of the target.
+ * @return true if the target would counterattack.
+ */
+bool FBattleState::WouldCounterattack(const FBattleBoard& Board, int32 AttackerIndex, const FIntPoint& From, int32 TargetIndex) const
+{
+    const FBattleUnit& Target = Units[TargetIndex];
+    return Board.GetStats(Units[AttackerIndex]).WouldBeCounteredBy(Board.GetStats(Target), GetDistance(From, Target.GetCell()));
+}
+
+/**
+ * @brief Applies an action with already-resolved dice and ends the turn when the side is done.
+ *
+ * The acting unit is marked as having moved and attacked. Counter damage is only applied
+ * if the target survives and the counterattack rule holds.
+ *
+ * @param Board The shared terrain and unit stats.
+ * @param Action A legal action for this state.
+ * @param Outcome The damage rolls for the attack (ignored if the action has no attack).
+ * @param OutUndo Receives the information needed to undo the action.
+ */
+void FBattleState::ApplyAction(const FBattleBoard& Board, const FBattleAction& Action, const FBattleOutcome& Outcome, FBattleUndo& OutUndo)
+{
+    FBattleUnit& Unit = Units[Action.Unit];
+
+    OutUndo.Attacker = Unit;
+    OutUndo.SideToMove = SideToMove;
+    OutUndo.TurnNumber = TurnNumber;
+    OutUndo.Hash = Hash;
+    for (int32 Index = 0; Index < NumUnits; ++Index)
+    {
+        OutUndo.PreviousFlags[Index] = Units[Index].Flags;
+    }
+
+    Hash ^= GetUnitHash(Action.Unit, Unit);
+    if (Action.HasAttack())
+    {
+        Hash ^= GetUnitHash(Action.Target, Units[Action.Target]);
+    }
+
+    Unit.X = Action.ToX;
+    Unit.Y = Action.ToY;
+
+    if (Action.HasAttack())
+    {
+        FBattleUnit& Target = Units[Action.Target];
+        OutUndo.Target = Target;
+
+        Target.Health = static_cast<int16>(FMath::Max(Target.Health - Outcome.Damage, 0));
+
+        if (Target.IsAlive() && WouldCounterattack(Board, Action.Unit, Unit.GetCell(), Action.Target))
+        {
+            Unit.Health = static_cast<int16>(FMath::Max(Unit.Health - Outcome.CounterDamage, 0));
+        }
+    }
+
+    Unit.Flags |= FBattleUnit::Flag_Moved | FBattleUnit::Flag_Attacked;
+
+    Hash ^= GetUnitHash(Action.Unit, Unit);
+    if (Action.HasAttack())
+    {
+        Hash ^= GetUnitHash(Action.Target, Units[Action.Target]);
+    }
+
+    EndTurnIfDone();
+}
+
+/**
+ * @brief Reverts an action previously applied with ApplyAction.
+ * @param Action The action that was applied.
+ * @param Undo The record filled by ApplyAction.
+ */
+void FBattleState::UndoAction(const FBattleAction& Action, const FBattleUndo& Undo)
+{
+    for (int32 Index = 0; Index < NumUnits; ++Index)
+    {
+        Units[Index].Flags = Undo.PreviousFlags[Index];
+    }
+
+    Units[Action.Unit] = Undo.Attacker;
+    if (Action.HasAttack())
+    {
+        Units[Action.Target] = Undo.Target;
+    }
+
+    SideToMove = Undo.SideToMove;
+    TurnNumber = Undo.TurnNumber;
+    Hash = Undo.Hash;
+}
+
+/**
+ * @brief Passes the turn once every living unit of the side to move has acted.
+ *
+ * Mirrors UTeam::HasTeamFinishedTurn followed by ResetUnitsForNewTurn on the other team.
+ */
+void FBattleState::EndTurnIfDone()
+{
+    for (int32 Index = 0; Index < NumUnits; ++Index)
+    {
+        const FBattleUnit& Unit = Units[Index];
+        if (Unit.Team == SideToMove && Unit.IsAlive() && !Unit.HasActed())
+            return;
+    }
+
+    SideToMove ^= 1;
+    ++TurnNumber;
+    Hash ^= GetZobristKey(EZobristDomain::Side, 0, 0);
+
+    for (int32 Index = 0; Index < NumUnits; ++Index)
+    {
+        if (Units[Index].Team == SideToMove && Units[Index].Flags != 0)
+        {
+            Hash ^= GetZobristKey(EZobristDomain::Flags, Index, Units[Index].Flags) ^ GetZobristKey(EZobristDomain::Flags, Index, 0);
+            Units[Index].Flags = 0;
+        }
+    }
+}
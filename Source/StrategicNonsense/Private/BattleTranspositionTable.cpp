@@ -0,0 +1,174 @@
+#include "BattleTranspositionTable.h"
+
+namespace
+{
+    // Packed entry layout (low to high bits)
+    constexpr int32 ScoreBits = 20;     // biased by ScoreBias; covers +-WinScore
+    constexpr int32 DepthBits = 6;
+    constexpr int32 BoundBits = 2;
+    constexpr int32 UnitBits = 3;       // FBattleState::MaxUnits == 8
+    constexpr int32 TargetBits = 4;     // target + 1, 0 = no attack
+    constexpr int32 CoordBits = 10;
+
+    constexpr int32 DepthShift = ScoreBits;
+    constexpr int32 BoundShift = DepthShift + DepthBits;
+    constexpr int32 HasActionShift = BoundShift + BoundBits;
+    constexpr int32 UnitShift = HasActionShift + 1;
+    constexpr int32 TargetShift = UnitShift + UnitBits;
+    constexpr int32 ToXShift = TargetShift + TargetBits;
+    constexpr int32 ToYShift = ToXShift + CoordBits;
+
+    constexpr int32 ScoreBias = 1 << (ScoreBits - 1);
+
+    static_assert(ToYShift + CoordBits <= 64, "Packed entry must fit in 64 bits");
+    static_assert(FBattleState::MaxUnits <= (1 << UnitBits), "Unit slot must fit the packed field");
+
+    constexpr uint64 FieldMask(int32 Bits) { return (1ull << Bits) - 1; }
+}
+
+/**
+ * @brief Allocates the table, rounded down to a power-of-two number of slots.
+ * @param SizeMB Memory budget in megabytes (at least one slot is allocated).
+ */
+FBattleTranspositionTable::FBattleTranspositionTable(int32 SizeMB)
+{
+    const uint64 Budget = static_cast<uint64>(FMath::Max(SizeMB, 1)) * 1024 * 1024;
+    uint64 NumSlots = 1;
+    while (NumSlots * 2 * sizeof(FSlot) <= Budget)
+    {
+        NumSlots *= 2;
+    }
+
+    Slots = MakeUnique<FSlot[]>(NumSlots);
+    IndexMask = NumSlots - 1;
+}
+
+/**
+ * @brief Looks up a position.
+ * @param Key The position's hash.
+ * @param OutEntry Receives the entry on a hit.
+ * @return true if the slot holds an intact entry for this key.
+ */
+bool FBattleTranspositionTable::Probe(uint64 Key, FBattleTTEntry& OutEntry) const
+{
+    const FSlot& Slot = Slots[Key & IndexMask];
+    const uint64 Data = Slot.Data.load(std::memory_order_relaxed);
+    const uint64 Check = Slot.KeyXorData.load(std::memory_order_relaxed);
+
+    if ((Check ^ Data) != Key || Data == 0)
+        return false;
+
+    OutEntry = Unpack(Data);
+    return true;
+}
+
+/**
+ * @brief Stores a search result, keeping a deeper result for the same position.
+ * @param Key The position's hash.
+ * @param Entry The result to store.
+ */
+void FBattleTranspositionTable::Store(uint64 Key, const FBattleTTEntry& Entry)
+{
+    FSlot& Slot = Slots[Key & IndexMask];
+
+    const uint64 OldData = Slot.Data.load(std::memory_order_relaxed);
+    const uint64 OldCheck = Slot.KeyXorData.load(std::memory_order_relaxed);
+    if ((OldCheck ^ OldData) == Key && Unpack(OldData).Depth > Entry.Depth)
+        return;
+
+    const uint64 Data = Pack(Entry);
+    Slot.KeyXorData.store(Key ^ Data, std::memory_order_relaxed);
+    Slot.Data.store(Data, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Empties every slot. Not safe to call while searches are running.
+ */
+void FBattleTranspositionTable::Clear()
+{
+    for (uint64 Index = 0; Index <= IndexMask; ++Index)
+    {
+        Slots[Index].KeyXorData.store(0, std::memory_order_relaxed);
+        Slots[Index].Data.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Adds a search's local probe, hit and store counts to the totals.
+ * @param Delta The counts to add.
+ */
+void FBattleTranspositionTable::RecordStats(const FStats& Delta)
+{
+    TotalProbes.fetch_add(Delta.Probes, std::memory_order_relaxed);
+    TotalHits.fetch_add(Delta.Hits, std::memory_order_relaxed);
+    TotalStores.fetch_add(Delta.Stores, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the counts recorded since construction or the last ResetStats.
+ */
+FBattleTranspositionTable::FStats FBattleTranspositionTable::GetStats() const
+{
+    FStats Stats;
+    Stats.Probes = TotalProbes.load(std::memory_order_relaxed);
+    Stats.Hits = TotalHits.load(std::memory_order_relaxed);
+    Stats.Stores = TotalStores.load(std::memory_order_relaxed);
+    return Stats;
+}
+
+/**
+ * @brief Zeroes the recorded counts.
+ */
+void FBattleTranspositionTable::ResetStats()
+{
+    TotalProbes.store(0, std::memory_order_relaxed);
+    TotalHits.store(0, std::memory_order_relaxed);
+    TotalStores.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Packs an entry into 64 bits. Actions on cells beyond the packed coordinate range are dropped.
+ */
+uint64 FBattleTranspositionTable::Pack(const FBattleTTEntry& Entry)
+{
+    const int32 Score = FMath::Clamp(Entry.Score, -ScoreBias + 1, ScoreBias - 1);
+    const int32 Depth = FMath::Clamp(Entry.Depth, 0, static_cast<int32>(FieldMask(DepthBits)));
+
+    uint64 Data = static_cast<uint64>(Score + ScoreBias) |
+        (static_cast<uint64>(Depth) << DepthShift) |
+        (static_cast<uint64>(Entry.Bound) << BoundShift);
+
+    const FBattleAction& Action = Entry.BestAction;
+    const bool bPackable = Entry.bHasBestAction && Action.Unit >= 0 &&
+        Action.ToX >= 0 && Action.ToX <= FieldMask(CoordBits) && Action.ToY >= 0 && Action.ToY <= FieldMask(CoordBits);
+
+    if (bPackable)
+    {
+        Data |= (1ull << HasActionShift) |
+            (static_cast<uint64>(Action.Unit) << UnitShift) |
+            (static_cast<uint64>(Action.Target + 1) << TargetShift) |
+            (static_cast<uint64>(Action.ToX) << ToXShift) |
+            (static_cast<uint64>(Action.ToY) << ToYShift);
+    }
+
+    return Data;
+}
+
+FBattleTTEntry FBattleTranspositionTable::Unpack(uint64 Data)
+{
+    FBattleTTEntry Entry;
+    Entry.Score = static_cast<int32>(Data & FieldMask(ScoreBits)) - ScoreBias;
+    Entry.Depth = static_cast<int32>((Data >> DepthShift) & FieldMask(DepthBits));
+    Entry.Bound = static_cast<EBattleBound>((Data >> BoundShift) & FieldMask(BoundBits));
+    Entry.bHasBestAction = ((Data >> HasActionShift) & 1) != 0;
+
+    if (Entry.bHasBestAction)
+    {
+        Entry.BestAction.Unit = static_cast<int8>((Data >> UnitShift) & FieldMask(UnitBits));
+        Entry.BestAction.Target = static_cast<int8>(static_cast<int32>((Data >> TargetShift) & FieldMask(TargetBits)) - 1);
+        Entry.BestAction.ToX = static_cast<int16>((Data >> ToXShift) & FieldMask(CoordBits));
+        Entry.BestAction.ToY = static_cast<int16>((Data >> ToYShift) & FieldMask(CoordBits));
+    }
+
+    return Entry;
+}
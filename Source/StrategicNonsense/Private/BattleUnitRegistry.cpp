@@ -0,0 +1,165 @@
+#include "BattleUnitRegistry.h"
+
+/**
+ * @brief Drops every unit and sizes the cell index for a grid.
+ * @param InWidth Grid width in cells.
+ * @param InHeight Grid height in cells.
+ */
+void FBattleUnitRegistry::Initialise(int32 InWidth, int32 InHeight)
+{
+    Width = InWidth;
+    Height = InHeight;
+
+    Cells.Reset();
+    Health.Reset();
+    Teams.Reset();
+    Flags.Reset();
+    Archetypes.Reset();
+
+    for (int32 Team = 0; Team < MaxTeams; ++Team)
+    {
+        TeamUnits[Team].Reset();
+        NumLiving[Team] = 0;
+        NumToAct[Team] = 0;
+    }
+
+    CellUnits.Init(INDEX_NONE, Width * Height);
+}
+
+/**
+ * @brief Registers a unit at full health with no team and no actions taken.
+ * @param Archetype The unit's archetype; its stats give the starting health.
+ * @param Cell The cell the unit stands on; must be inside the grid.
+ * @return The new unit's ID.
+ */
+int32 FBattleUnitRegistry::AddUnit(EBattleArchetype Archetype, const FIntPoint& Cell)
+{
+    check(IsValidCell(Cell));
+
+    const int32 Unit = Cells.Add(Cell);
+    Health.Add(FBattleUnitStats::Get(Archetype).MaxHealth);
+    Teams.Add(NoTeam);
+    Flags.Add(0);
+    Archetypes.Add(Archetype);
+
+    CellUnits[Cell.Y * Width + Cell.X] = Unit;
+    return Unit;
+}
+
+/**
+ * @brief The unit standing on a cell.
+ * @return Its ID, or INDEX_NONE if the cell is empty or outside the grid.
+ */
+int32 FBattleUnitRegistry::GetUnitAt(const FIntPoint& Cell) const
+{
+    return IsValidCell(Cell) ? CellUnits[Cell.Y * Width + Cell.X] : INDEX_NONE;
+}
+
+/**
+ * @brief Moves a unit to a team. A unit joins a team once, after it is placed.
+ * @param Unit The unit ID.
+ * @param Team 0 or 1.
+ */
+void FBattleUnitRegistry::SetTeam(int32 Unit, uint8 Team)
+{
+    check(Team < MaxTeams);
+    if (Teams[Unit] == Team)
+        return;
+
+    if (Teams[Unit] != NoTeam)
+    {
+        RemoveFromCounts(Unit);
+        TeamUnits[Teams[Unit]].RemoveSingle(Unit);
+    }
+
+    Teams[Unit] = Team;
+    TeamUnits[Team].Add(Unit);
+    AddToCounts(Unit);
+}
+
+/**
+ * @brief Moves a unit to a cell, vacating the cell it stood on if the index still points at it.
+ * @param Unit The unit ID.
+ * @param Cell The destination; must be inside the grid.
+ */
+void FBattleUnitRegistry::SetCell(int32 Unit, const FIntPoint& Cell)
+{
+    check(IsValidCell(Cell));
+
+    const FIntPoint From = Cells[Unit];
+    if (IsValidCell(From) && CellUnits[From.Y * Width + From.X] == Unit)
+    {
+        CellUnits[From.Y * Width + From.X] = INDEX_NONE;
+    }
+
+    Cells[Unit] = Cell;
+    CellUnits[Cell.Y * Width + Cell.X] = Unit;
+}
+
+/**
+ * @brief Empties a cell in the index; the unit that stood there keeps its last cell.
+ */
+void FBattleUnitRegistry::ClearCell(const FIntPoint& Cell)
+{
+    if (IsValidCell(Cell))
+    {
+        CellUnits[Cell.Y * Width + Cell.X] = INDEX_NONE;
+    }
+}
+
+/**
+ * @brief Sets a unit's health (clamped at zero). A unit that dies leaves the cell index.
+ */
+void FBattleUnitRegistry::SetHealth(int32 Unit, int32 InHealth)
+{
+    RemoveFromCounts(Unit);
+    Health[Unit] = static_cast<int16>(FMath::Clamp(InHealth, 0, static_cast<int32>(MAX_int16)));
+    AddToCounts(Unit);
+
+    if (Health[Unit] == 0 && GetUnitAt(Cells[Unit]) == Unit)
+    {
+        ClearCell(Cells[Unit]);
+    }
+}
+
+/**
+ * @brief Sets a unit's FBattleUnit::EFlags for the current turn.
+ */
+void FBattleUnitRegistry::SetFlags(int32 Unit, uint8 InFlags)
+{
+    RemoveFromCounts(Unit);
+    Flags[Unit] = InFlags;
+    AddToCounts(Unit);
+}
+
+/**
+ * @brief Clears the turn flags of every unit on a team.
+ */
+void FBattleUnitRegistry::ResetTeamForNewTurn(uint8 Team)
+{
+    for (int32 Unit : TeamUnits[Team])
+    {
+        Flags[Unit] = 0;
+    }
+    NumToAct[Team] = NumLiving[Team];
+}
+
+void FBattleUnitRegistry::RemoveFromCounts(int32 Unit)
+{
+    const uint8 Team = Teams[Unit];
+    if (Team == NoTeam)
+        return;
+
+    NumLiving[Team] -= IsAlive(Unit) ? 1 : 0;
+    NumToAct[Team] -= NeedsToAct(Unit) ? 1 : 0;
+}
+
+void FBattleUnitRegistry::AddToCounts(int32 Unit)
+{
+    const uint8 Team = Teams[Unit];
+    if (Team == NoTeam)
+        return;
+
+    NumLiving[Team] += IsAlive(Unit) ? 1 : 0;
+    NumToAct[Team] += NeedsToAct(Unit) ? 1 : 0;
+}
@@ -1,15 +1,21 @@
 #include "CombatManager.h"
+#include "StrategicNonsense.h"
 #include "UnitActor.h"
 #include "BattleGameMode.h"
 #include "GridManager.h"
+#include "BattleActorPool.h"
+
+DECLARE_CYCLE_STAT(TEXT("ExecuteAttack"), STAT_SNExecuteAttack, STATGROUP_StrategicNonsense);
 
 /**
  * @brief Initialises the combat manager with a reference to the grid and owning game mode.
  * @param Grid Pointer to the grid manager used for cell updates and position tracking.
+ * @param InCombatStream Stream for damage and counterattack rolls; must outlive the manager.
  */
-void UCombatManager::Initialise(AGridManager* Grid)
+void UCombatManager::Initialise(AGridManager* Grid, FRandomStream& InCombatStream)
 {
     GridManager = Grid;
+    CombatStream = &InCombatStream;
     GameMode = Cast<ABattleGameMode>(GetOuter());
 }
 
@@ -17,7 +23,7 @@ void UCombatManager::Initialise(AGridManager* Grid)
  * @brief Executes an attack from one unit to another, applying damage and triggering counterattack logic.
  *
  * Validates that both attacker and target are alive and within range before applying damage.
- * Updates the game status widget and removes units if their health reaches zero.
+ * Removes units if their health reaches zero; the status widget follows through OnHealthChanged.
  *
  * @param Attacker The unit initiating the attack.
  * @param Target The unit receiving the attack.
@@ -25,18 +31,24 @@ void UCombatManager::Initialise(AGridManager* Grid)
  */
 bool UCombatManager::ExecuteAttack(AUnitActor* Attacker, AUnitActor* Target)
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(UCombatManager::ExecuteAttack);
+    SCOPE_CYCLE_COUNTER(STAT_SNExecuteAttack);
+
     if (!Attacker || !Target || Attacker->IsDead() || Target->IsDead())
         return false;
 
     if (!IsInRange(Attacker, Target))
         return false;
 
-    Attacker->ApplyDamageTo(Target);
-    if (GameMode) GameMode->UpdateGameStatusWidget();
+    const int32 TargetHealth = Target->GetHealth();
+    Attacker->ApplyDamageTo(Target, *CombatStream);
+    const int32 Damage = TargetHealth - Target->GetHealth();
     RemoveUnitIfDead(Target);
 
 
+    const int32 AttackerHealth = Attacker->GetHealth();
     HandleCounterattack(Attacker, Target);
+    if (GameMode) GameMode->RecordReplayAttack(Attacker, Target, Damage, AttackerHealth - Attacker->GetHealth());
     RemoveUnitIfDead(Attacker);
 
     return true;
@@ -44,24 +56,23 @@ bool UCombatManager::ExecuteAttack(AUnitActor* Attacker, AUnitActor* Target)
 
 /**
  * @brief Checks if the target unit is within attack range of the attacker.
+ *
+ * Attack types the grid lists as needing line of sight also need a clear line to the target.
+ *
  * @param Attacker The attacking unit.
  * @param Target The target unit.
  * @return true if the target is within range; false otherwise.
  */
 bool UCombatManager::IsInRange(AUnitActor* Attacker, AUnitActor* Target) const
 {
-    FIntPoint From = Attacker->GetGridPosition();
-    FIntPoint To = Target->GetGridPosition();
-
-    int32 Distance = FMath::Abs(From.X - To.X) + FMath::Abs(From.Y - To.Y);
-    return Distance <= Attacker->GetAttackRange();
+    return GridManager->CanAttackFrom(Attacker, Attacker->GetGridPosition(), Target->GetGridPosition());
 }
 
 /**
  * @brief Handles counterattack logic after a successful attack.
  *
- * A Sniper receives counter damage if it attacks another Sniper,
- * or a Brawler from adjacent range (1 cell).
+ * The attacker receives the target's counter damage if its archetype provokes counters and it
+ * attacked from within the target's counter range (FBattleUnitStats::WouldBeCounteredBy).
  *
  * @param Attacker The unit that initiated the attack (and may receive counter damage).
  * @param Target The unit that may counterattack.
@@ -75,28 +86,23 @@ void UCombatManager::HandleCounterattack(AUnitActor* Attacker, AUnitActor* Targe
     FIntPoint T = Target->GetGridPosition();
     int32 Distance = FMath::Abs(A.X - T.X) + FMath::Abs(A.Y - T.Y);
 
-    bool IsAttackerSniper = Attacker->GetUnitType() == EGameUnitType::Sniper;
+    const FBattleUnitStats& TargetStats = Target->GetStats();
+    if (!Attacker->GetStats().WouldBeCounteredBy(TargetStats, Distance)) return;
 
-    bool ShouldCounter = IsAttackerSniper &&
-        (
-            Target->GetUnitType() == EGameUnitType::Sniper ||
-            (Target->GetUnitType() == EGameUnitType::Brawler && Distance == 1)
-            );
-
-
-    if (!ShouldCounter) return;
-
-    int32 CounterDamage = FMath::RandRange(1, 3);
+    int32 CounterDamage = CombatStream->RandRange(TargetStats.CounterDamageMin, TargetStats.CounterDamageMax);
     Attacker->ReceiveDamage(CounterDamage);
 
-    UE_LOG(LogTemp, Warning, TEXT("Counterattack! %s received %d damage."),
+    UE_LOG(LogSNCombat, Verbose, TEXT("Counterattack! %s received %d damage."),
         *UEnum::GetValueAsString(Attacker->GetUnitType()), CounterDamage);
-    if (GameMode) GameMode->UpdateGameStatusWidget();
 
 }
 
 /**
- * @brief Removes a unit from the grid and destroys it if its health has reached zero.
+ * @brief Removes a unit from the grid and returns it to the actor pool if its health has reached zero.
+ *
+ * The actor stays valid (and dead) for the rest of the match, so team lists and queued AI
+ * commands that still point at it simply see a dead unit.
+ *
  * @param Unit The unit to check and remove if dead.
  */
 void UCombatManager::RemoveUnitIfDead(AUnitActor* Unit)
@@ -105,9 +111,15 @@ void UCombatManager::RemoveUnitIfDead(AUnitActor* Unit)
     {
         FIntPoint Pos = Unit->GetGridPosition();
         GridManager->SetUnitAtCell(Pos, nullptr);
-        Unit->Destroy(); // Or SetActorHidden + Disable
-        UE_LOG(LogTemp, Warning, TEXT("%s has been eliminated."), *Unit->GetName());
-        if (GameMode) GameMode->UpdateGameStatusWidget();
+        UE_LOG(LogSNCombat, Log, TEXT("%s has been eliminated."), *Unit->GetName());
+        if (UBattleActorPool* Pool = UBattleActorPool::Get(Unit))
+        {
+            Pool->Release(Unit);
+        }
+        else
+        {
+            Unit->Destroy();
+        }
 
     }
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include "GameOverWidget.h"
+#include "StrategicNonsense.h"
 #include "Components/TextBlock.h"
 #include "Components/Button.h"
 #include "Kismet/GameplayStatics.h"
+#include "BattleGameMode.h"
 
 /**
  * @brief Called when the widget is constructed.
@@ -22,11 +24,18 @@ void UGameOverWidget::NativeConstruct()
 /**
  * @brief Handles the click on the Restart button.
  *
- * Reloads the current level to restart the game from the beginning.
+ * Restarts the match in the current world; reloads the level if the battle game mode is not running.
  */
 void UGameOverWidget::OnRestartClicked()
 {
-    UE_LOG(LogTemp, Warning, TEXT("Restart button clicked. Restarting level..."));
+    if (ABattleGameMode* GameMode = Cast<ABattleGameMode>(UGameplayStatics::GetGameMode(this)))
+    {
+        UE_LOG(LogSNGame, Log, TEXT("Restart button clicked. Restarting match..."));
+        GameMode->RestartMatch();
+        return;
+    }
+
+    UE_LOG(LogSNGame, Log, TEXT("Restart button clicked. Restarting level..."));
     UGameplayStatics::OpenLevel(this, FName(*GetWorld()->GetName()), false);
 }
 
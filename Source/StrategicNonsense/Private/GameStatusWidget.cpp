@@ -1,8 +1,12 @@
 #include "GameStatusWidget.h"
+#include "StrategicNonsense.h"
 #include "UnitActor.h"
 
+DECLARE_CYCLE_STAT(TEXT("GameStatusWidget Flush"), STAT_SNGameStatusFlush, STATGROUP_StrategicNonsense);
+DECLARE_DWORD_COUNTER_STAT(TEXT("GameStatusWidget SetText calls"), STAT_SNGameStatusSetTextCalls, STATGROUP_StrategicNonsense);
+
 /**
- * @brief Sets the displayed information for a team.
+ * @brief Queues the displayed information for a team.
  *
  * Displays the teams role (PLAYER or AI) and its assigned colour.
  *
@@ -15,20 +19,19 @@ void UGameStatusWidget::SetTeamInfo(bool bIsTeam1, const FString& Colour, bool b
     FString Role = bIsAI ? TEXT("AI") : TEXT("PLAYER");
     FString Text = FString::Printf(TEXT("%s: %s"), *Role, *Colour);
 
-    if (bIsTeam1 && Team1Text)
-    {
-        Team1Text->SetText(FText::FromString(Text));
-    }
-    else if (!bIsTeam1 && Team2Text)
+    const int32 Row = bIsTeam1 ? 0 : 1;
+    if (PendingTeamInfo[Row] != Text)
     {
-        Team2Text->SetText(FText::FromString(Text));
+        PendingTeamInfo[Row] = MoveTemp(Text);
+        DirtyRows |= TeamInfoDirtyBit << Row;
     }
 }
 
 /**
- * @brief Updates the displayed health text for a specific unit.
+ * @brief Queues the health shown for a specific unit.
  *
- * Shows the current and max HP of a Sniper or Brawler on either team.
+ * Only the numbers are stored here; the text is formatted when the next flush finds them
+ * different from what the row already shows.
  *
  * @param bIsTeam1 Whether the unit belongs to Team 1 or not (Team 2).
  * @param UnitType The type of unit (Sniper or Brawler).
@@ -37,27 +40,18 @@ void UGameStatusWidget::SetTeamInfo(bool bIsTeam1, const FString& Colour, bool b
  */
 void UGameStatusWidget::SetUnitHealth(bool bIsTeam1, EGameUnitType UnitType, int32 CurrentHP, int32 MaxHP)
 {
-    FString TypeStr = UnitType == EGameUnitType::Sniper ? TEXT("Sniper") : TEXT("Brawler");
-    FString Text = FString::Printf(TEXT("%s: %d/%d HP"), *TypeStr, CurrentHP, MaxHP);
-
-    if (bIsTeam1)
+    const int32 Row = GetHealthRow(bIsTeam1, UnitType);
+    FHealthRow& Pending = PendingHealth[Row];
+    if (Pending.Current != CurrentHP || Pending.Max != MaxHP)
     {
-        if (UnitType == EGameUnitType::Sniper && Team1SniperText)
-            Team1SniperText->SetText(FText::FromString(Text));
-        else if (UnitType == EGameUnitType::Brawler && Team1BrawlerText)
-            Team1BrawlerText->SetText(FText::FromString(Text));
-    }
-    else
-    {
-        if (UnitType == EGameUnitType::Sniper && Team2SniperText)
-            Team2SniperText->SetText(FText::FromString(Text));
-        else if (UnitType == EGameUnitType::Brawler && Team2BrawlerText)
-            Team2BrawlerText->SetText(FText::FromString(Text));
+        Pending.Current = CurrentHP;
+        Pending.Max = MaxHP;
+        DirtyRows |= HealthDirtyBit << Row;
     }
 }
 
 /**
- * @brief Sets the turn indicator text in the UI.
+ * @brief Queues the turn indicator text.
  *
  * Typically displays "Player Turn" or "AI Turn".
  *
@@ -65,8 +59,76 @@ void UGameStatusWidget::SetUnitHealth(bool bIsTeam1, EGameUnitType UnitType, int
  */
 void UGameStatusWidget::SetTurnText(const FString& TurnDescription)
 {
-    if (Turntext)
+    if (PendingTurn != TurnDescription)
+    {
+        PendingTurn = TurnDescription;
+        DirtyRows |= TurnDirtyBit;
+    }
+}
+
+/**
+ * @brief Flushes the rows queued since the last frame.
+ */
+void UGameStatusWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+    Super::NativeTick(MyGeometry, InDeltaTime);
+
+    if (DirtyRows != 0)
+    {
+        FlushPendingUpdates();
+    }
+}
+
+/**
+ * @brief Writes every queued row whose value differs from what it shows.
+ *
+ * However many updates a row received since the last flush, it is formatted and set at most once;
+ * a row that changed and changed back is not touched at all.
+ */
+void UGameStatusWidget::FlushPendingUpdates()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UGameStatusWidget::FlushPendingUpdates);
+    SCOPE_CYCLE_COUNTER(STAT_SNGameStatusFlush);
+
+    UTextBlock* const TeamTexts[] = { Team1Text, Team2Text };
+    for (int32 Row = 0; Row < 2; ++Row)
+    {
+        if ((DirtyRows & (TeamInfoDirtyBit << Row)) && ShownTeamInfo[Row] != PendingTeamInfo[Row] && TeamTexts[Row])
+        {
+            TeamTexts[Row]->SetText(FText::FromString(PendingTeamInfo[Row]));
+            ShownTeamInfo[Row] = PendingTeamInfo[Row];
+            INC_DWORD_STAT(STAT_SNGameStatusSetTextCalls);
+        }
+    }
+
+    UTextBlock* const HealthTexts[NumHealthRows] = { Team1SniperText, Team1BrawlerText, Team2SniperText, Team2BrawlerText };
+    for (int32 Row = 0; Row < NumHealthRows; ++Row)
+    {
+        const FHealthRow& Pending = PendingHealth[Row];
+        FHealthRow& Shown = ShownHealth[Row];
+        if (!(DirtyRows & (HealthDirtyBit << Row)) || (Shown.Current == Pending.Current && Shown.Max == Pending.Max) || !HealthTexts[Row])
+            continue;
+
+        const TCHAR* TypeStr = (Row % 2 == 0) ? TEXT("Sniper") : TEXT("Brawler");
+        HealthTexts[Row]->SetText(FText::FromString(FString::Printf(TEXT("%s: %d/%d HP"), TypeStr, Pending.Current, Pending.Max)));
+        Shown = Pending;
+        INC_DWORD_STAT(STAT_SNGameStatusSetTextCalls);
+    }
+
+    if ((DirtyRows & TurnDirtyBit) && ShownTurn != PendingTurn && Turntext)
     {
-        Turntext->SetText(FText::FromString(TurnDescription));
+        Turntext->SetText(FText::FromString(PendingTurn));
+        ShownTurn = PendingTurn;
+        INC_DWORD_STAT(STAT_SNGameStatusSetTextCalls);
     }
+
+    DirtyRows = 0;
+}
+
+/**
+ * @brief Index of a unit's health row: Team 1 Sniper, Team 1 Brawler, Team 2 Sniper, Team 2 Brawler.
+ */
+int32 UGameStatusWidget::GetHealthRow(bool bIsTeam1, EGameUnitType UnitType)
+{
+    return (bIsTeam1 ? 0 : 2) + (UnitType == EGameUnitType::Sniper ? 0 : 1);
 }
@@ -0,0 +1,485 @@
+#include "GridBenchmark.h"
+#include "StrategicNonsense.h"
+#include "GridManager.h"
+#include "GridBitboard.h"
+#include "GridConnectivity.h"
+#include "GridDistanceField.h"
+#include "GridObstacleLayout.h"
+#include "CombatManager.h"
+#include "SniperUnit.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "BattleActorPool.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/Package.h"
+
+namespace
+{
+    // PlaceObstacles needs a fresh grid per sample, so it is sampled this many times less often
+    constexpr int32 LayoutSampleDivisor = 40;
+    constexpr int32 AttackSampleDivisor = 4;
+
+    // Slowdowns smaller than this are treated as timer noise when comparing against a baseline
+    constexpr double MinRegressionMicroseconds = 1.0;
+
+    // Allocation counts are deterministic for a seed; this only absorbs the odd log flush
+    constexpr double MinRegressionAllocations = 0.5;
+
+    /**
+     * Forwards to the real allocator, counting allocations made by the benchmark thread. Installed
+     * as GMalloc between Begin/EndAllocationCounting so per-call heap traffic shows up in the report.
+     */
+    class FAllocationCountingMalloc final : public FMalloc
+    {
+    public:
+        explicit FAllocationCountingMalloc(FMalloc* InInner)
+            : Inner(InInner)
+            , OwnerThreadId(FPlatformTLS::GetCurrentThreadId())
+        {
+        }
+
+        FMalloc* GetInner() const { return Inner; }
+        uint64 GetNumAllocations() const { return NumAllocations; }
+
+        /** Counts allocations made by the calling thread from now on. */
+        void SetOwnerThread() { OwnerThreadId = FPlatformTLS::GetCurrentThreadId(); }
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override { CountAllocation(); return Inner->Malloc(Count, Alignment); }
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override { CountAllocation(); return Inner->TryMalloc(Count, Alignment); }
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override { if (Count > 0) CountAllocation(); return Inner->Realloc(Original, Count, Alignment); }
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override { if (Count > 0) CountAllocation(); return Inner->TryRealloc(Original, Count, Alignment); }
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual void UpdateStats() override { Inner->UpdateStats(); }
+        virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+        virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+        virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+    private:
+        void CountAllocation()
+        {
+            if (FPlatformTLS::GetCurrentThreadId() == OwnerThreadId)
+            {
+                ++NumAllocations;
+            }
+        }
+
+        FMalloc* Inner;
+        uint32 OwnerThreadId;
+        uint64 NumAllocations = 0;
+    };
+
+    FAllocationCountingMalloc* GAllocationCounter = nullptr;
+
+    /** Times one call and adds its heap allocations to the result. */
+    template <typename FunctionType>
+    void Measure(FGridBenchmarkResult& Result, FunctionType&& Function)
+    {
+        const uint64 StartAllocations = GAllocationCounter ? GAllocationCounter->GetNumAllocations() : 0;
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        Function();
+        const uint64 EndCycles = FPlatformTime::Cycles64();
+
+        Result.Microseconds.Add(FPlatformTime::ToMilliseconds64(EndCycles - StartCycles) * 1000.0);
+        Result.Allocations += GAllocationCounter ? GAllocationCounter->GetNumAllocations() - StartAllocations : 0;
+    }
+
+    /** Picks a random footprint of free cells: a mountain where one fits, otherwise a single tree. */
+    void PickFootprint(const FGridOccupancy& Occupancy, const TArray<FIntPoint>& FreeCells, FRandomStream& Stream, bool bMountain, TArray<FIntPoint>& OutFootprint)
+    {
+        OutFootprint.Reset();
+
+        const FIntPoint Origin = FreeCells[Stream.RandRange(0, FreeCells.Num() - 1)];
+        if (bMountain)
+        {
+            for (const FIntPoint& Offset : FGridObstacleLayout::GetMountainShape())
+            {
+                const FIntPoint Cell = Origin + Offset;
+                if (!Occupancy.IsValidCell(Cell) || Occupancy.IsBlocked(Cell))
+                {
+                    OutFootprint.Reset();
+                    break;
+                }
+                OutFootprint.Add(Cell);
+            }
+        }
+
+        if (OutFootprint.IsEmpty())
+        {
+            OutFootprint.Add(Origin);
+        }
+    }
+}
+
+double FGridBenchmarkResult::GetPercentile(double Fraction) const
+{
+    if (Microseconds.IsEmpty())
+        return 0.0;
+
+    TArray<double> Sorted = Microseconds;
+    Sorted.Sort();
+    return Sorted[FMath::Min(Sorted.Num() - 1, static_cast<int32>(Sorted.Num() * Fraction))];
+}
+
+double FGridBenchmarkResult::GetMean() const
+{
+    double Total = 0.0;
+    for (double Value : Microseconds)
+    {
+        Total += Value;
+    }
+    return Microseconds.IsEmpty() ? 0.0 : Total / Microseconds.Num();
+}
+
+/**
+ * @brief Routes GMalloc through the allocation counter, counting allocations made by the calling thread.
+ *
+ * The counter is never deleted: other threads may still be inside it after the original allocator
+ * is restored, so one instance is kept and reused by later runs.
+ */
+void FGridBenchmark::BeginAllocationCounting()
+{
+    if (GMalloc == GAllocationCounter)
+        return;
+
+    if (!GAllocationCounter || GAllocationCounter->GetInner() != GMalloc)
+    {
+        GAllocationCounter = new FAllocationCountingMalloc(GMalloc);
+    }
+
+    GAllocationCounter->SetOwnerThread();
+    GMalloc = GAllocationCounter;
+}
+
+/**
+ * @brief Restores the allocator that was active before BeginAllocationCounting.
+ */
+void FGridBenchmark::EndAllocationCounting()
+{
+    if (GAllocationCounter && GMalloc == GAllocationCounter)
+    {
+        GMalloc = GAllocationCounter->GetInner();
+    }
+}
+
+/**
+ * @brief Spawns a grid manager in a transient world and times every hot path on it.
+ *
+ * The random streams are seeded from Seed, so a configuration always sees the same layout.
+ *
+ * @param GridSize Width and height of the grid.
+ * @param Density Obstacle percentage.
+ * @param NumSamples Calls per benchmark; layout and attack benchmarks take fewer.
+ * @param Seed Seed for the layout, the sampled cells and the combat rolls.
+ * @param OutResults Receives one result per benchmark.
+ */
+void FGridBenchmark::RunConfiguration(int32 GridSize, int32 Density, int32 NumSamples, int32 Seed, TArray<FGridBenchmarkResult>& OutResults)
+{
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("GridBenchmark"));
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+    World->InitializeActorsForPlay(FURL());
+
+    // Keeps the references handed out by AddResult stable
+    OutResults.Reserve(OutResults.Num() + 13);
+
+    auto AddResult = [&OutResults, GridSize, Density](const TCHAR* Name) -> FGridBenchmarkResult&
+    {
+        FGridBenchmarkResult& Result = OutResults.AddDefaulted_GetRef();
+        Result.Name = Name;
+        Result.GridSize = GridSize;
+        Result.Density = Density;
+        return Result;
+    };
+
+    // Layouts and combat rolls get their own streams, so the sampling sequence below stays the same
+    FRandomStream Stream(Seed);
+    FRandomStream MapStream(Seed);
+    FRandomStream CombatStream(Seed);
+
+    AGridManager* Grid = World->SpawnActor<AGridManager>();
+    Grid->SetGridSize(GridSize, GridSize);
+    Grid->SetObstaclePercentage(static_cast<float>(Density));
+
+    FGridBenchmarkResult& PlaceObstacles = AddResult(TEXT("PlaceObstacles"));
+    for (int32 Sample = 0; Sample < FMath::Max(1, NumSamples / LayoutSampleDivisor); ++Sample)
+    {
+        Grid->GenerateGrid();
+        Measure(PlaceObstacles, [Grid, &MapStream]() { Grid->PlaceObstacles(MapStream); });
+    }
+
+    // The remaining benchmarks run on the layout left by the last PlaceObstacles sample
+    const FGridOccupancy& Occupancy = Grid->GetOccupancy();
+
+    TArray<FIntPoint> FreeCells;
+    Occupancy.ForEachFreeCell([&FreeCells](const FIntPoint& Cell) { FreeCells.Add(Cell); });
+
+    if (!FreeCells.IsEmpty())
+    {
+        FGridBenchmarkResult& Reachable = AddResult(TEXT("FindReachableCellsBFS"));
+        int32 TotalReached = 0;
+        for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+        {
+            // Alternate between Sniper and Brawler movement ranges
+            const FIntPoint Start = FreeCells[Stream.RandRange(0, FreeCells.Num() - 1)];
+            const int32 Range = (Sample % 2 == 0) ? 3 : 6;
+            Measure(Reachable, [&]() { TotalReached += Grid->FindReachableCellsBFS(Start, Range).Num(); });
+        }
+
+        // The allocation-free variants; one warm-up query sizes their scratch first
+        TArray<FIntPoint> ReachableCells;
+        ReachableCells.SetNumUninitialized(FGridReachability::GetMaxReachableCells(6, Occupancy.GetNumCells()));
+        TArray<uint64> ReachableMask;
+        ReachableMask.SetNumUninitialized(Occupancy.GetBlockedWords().Num());
+        Grid->FindReachableCells(FreeCells[0], 6, ReachableCells);
+
+        FGridBenchmarkResult& ReachableSpan = AddResult(TEXT("FindReachableCells"));
+        for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+        {
+            const FIntPoint Start = FreeCells[Stream.RandRange(0, FreeCells.Num() - 1)];
+            const int32 Range = (Sample % 2 == 0) ? 3 : 6;
+            Measure(ReachableSpan, [&]() { TotalReached += Grid->FindReachableCells(Start, Range, ReachableCells); });
+        }
+
+        FGridBenchmarkResult& ReachableBits = AddResult(TEXT("FindReachableMask"));
+        for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+        {
+            const FIntPoint Start = FreeCells[Stream.RandRange(0, FreeCells.Num() - 1)];
+            const int32 Range = (Sample % 2 == 0) ? 3 : 6;
+            Measure(ReachableBits, [&]() { TotalReached += Grid->FindReachableMask(Start, Range, ReachableMask); });
+        }
+
+        // The cell-at-a-time BFS the bitboard dilation replaced, kept for comparison
+        FGridBenchmarkResult& ReachableBitsBFS = AddResult(TEXT("FindReachableMaskBFS"));
+        FGridReachability BreadthFirst;
+        BreadthFirst.FindReachableMask(Occupancy, FreeCells[0], 6, ReachableMask);
+        for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+        {
+            const FIntPoint Start = FreeCells[Stream.RandRange(0, FreeCells.Num() - 1)];
+            const int32 Range = (Sample % 2 == 0) ? 3 : 6;
+            Measure(ReachableBitsBFS, [&]() { TotalReached += BreadthFirst.FindReachableMask(Occupancy, Start, Range, ReachableMask); });
+        }
+
+        // Repeated range checks for a handful of units, as hover and click do within a turn
+        FGridBenchmarkResult& CachedDistance = AddResult(TEXT("GetReachableDistance"));
+        for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+        {
+            const FIntPoint Start = FreeCells[(Sample % 4) * (FreeCells.Num() / 4)];
+            const FIntPoint Target = Start + FIntPoint(Stream.RandRange(-6, 6), Stream.RandRange(-6, 6));
+            Measure(CachedDistance, [&]() { TotalReached += Grid->GetReachableDistance(Start, 6, Target); });
+        }
+
+        // Shots from a handful of units at cells within Sniper range, so most queries hit the cache
+        FGridBenchmarkResult& Sight = AddResult(TEXT("HasLineOfSight"));
+        for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+        {
+            const FIntPoint From = FreeCells[(Sample % 4) * (FreeCells.Num() / 4)];
+            const FIntPoint To = From + FIntPoint(Stream.RandRange(-5, 5), Stream.RandRange(-5, 5));
+            Measure(Sight, [&]() { TotalReached += Grid->HasLineOfSight(From, To); });
+        }
+
+        FGridBenchmarkResult& Path = AddResult(TEXT("FindPath"));
+        TArray<FIntPoint> Steps;
+        for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+        {
+            const FIntPoint Start = FreeCells[Stream.RandRange(0, FreeCells.Num() - 1)];
+            const FIntPoint Goal = FreeCells[Stream.RandRange(0, FreeCells.Num() - 1)];
+            Measure(Path, [&]() { TotalReached += Grid->FindPath(Start, Goal, Occupancy.GetNumCells(), Steps) ? Steps.Num() : 0; });
+        }
+
+        // Four enemy units as sources, then one of them moving, as during an AI turn
+        FGridBenchmarkResult& FieldCompute = AddResult(TEXT("ComputeDistanceField"));
+        FGridBenchmarkResult& FieldUpdate = AddResult(TEXT("MoveDistanceFieldSource"));
+        FGridDistanceField Field;
+        TArray<FIntPoint> FieldSources = { FreeCells[0] };
+        Field.Compute(Occupancy, FieldSources);
+        Field.MoveSource(Occupancy, FreeCells[0], FreeCells.Last());
+        for (int32 Sample = 0; Sample < FMath::Max(1, NumSamples / LayoutSampleDivisor); ++Sample)
+        {
+            FieldSources.Reset();
+            for (int32 Source = 0; Source < 4; ++Source)
+            {
+                FieldSources.Add(FreeCells[Stream.RandRange(0, FreeCells.Num() - 1)]);
+            }
+            Measure(FieldCompute, [&]() { Field.Compute(Occupancy, FieldSources); });
+
+            const FIntPoint From = FieldSources[0];
+            const FIntPoint To = FreeCells[Stream.RandRange(0, FreeCells.Num() - 1)];
+            Measure(FieldUpdate, [&]() { Field.MoveSource(Occupancy, From, To); });
+            TotalReached += Field.GetLastNumRepaired();
+        }
+
+        FGridBenchmarkResult& Connectivity = AddResult(TEXT("WouldDisconnect"));
+        FGridConnectivity Checker;
+        TArray<FIntPoint> Footprint;
+        bool bDisconnected = false;
+        for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+        {
+            PickFootprint(Occupancy, FreeCells, Stream, Sample % 2 == 0, Footprint);
+            Measure(Connectivity, [&]() { bDisconnected |= Checker.WouldDisconnect(Occupancy, Footprint); });
+        }
+
+        FGridBenchmarkResult& Placement = AddResult(TEXT("GetRandomValidPlacementLocation"));
+        FVector Location = FVector::ZeroVector;
+        for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+        {
+            Measure(Placement, [&]() { Grid->GetRandomValidPlacementLocation(Location, MapStream); });
+        }
+
+        // Sniper against Sniper always takes the counterattack path, the most expensive one
+        FGridBenchmarkResult& Attack = AddResult(TEXT("ExecuteAttack"));
+        UCombatManager* CombatManager = NewObject<UCombatManager>(GetTransientPackage());
+        CombatManager->Initialise(Grid, CombatStream);
+
+        for (int32 Sample = 0; Sample < FMath::Max(1, NumSamples / AttackSampleDivisor); ++Sample)
+        {
+            const FIntPoint AttackerCell = FreeCells[Stream.RandRange(0, FreeCells.Num() - 1)];
+            const TArray<FIntPoint> TargetCells = Grid->FindReachableCellsBFS(AttackerCell, 3).Array();
+            if (TargetCells.IsEmpty())
+                continue;
+
+            AUnitActor* Attacker = Grid->SpawnAndPlaceUnit(AttackerCell, ASniperUnit::StaticClass());
+            AUnitActor* Target = Grid->SpawnAndPlaceUnit(TargetCells[Stream.RandRange(0, TargetCells.Num() - 1)], ASniperUnit::StaticClass());
+
+            if (Attacker && Target)
+            {
+                Measure(Attack, [&]() { CombatManager->ExecuteAttack(Attacker, Target); });
+            }
+
+            // Survivors go back to the pool like the fallen, so later samples reuse both
+            for (AUnitActor* Unit : { Attacker, Target })
+            {
+                if (IsValid(Unit) && !Unit->IsDead())
+                {
+                    Grid->SetUnitAtCell(Unit->GetGridPosition(), nullptr);
+                    UBattleActorPool::Get(World)->Release(Unit);
+                }
+            }
+        }
+
+        UE_LOG(LogSNGrid, Verbose, TEXT("Checksum %d %d %s"), TotalReached, bDisconnected, *Location.ToString());
+    }
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+/**
+ * @brief Writes results as a JSON report, tagged with the label, build configuration and CPU.
+ * @return False if the file could not be written.
+ */
+bool FGridBenchmark::SaveReport(const TArray<FGridBenchmarkResult>& Results, const FString& Label, int32 Seed, const FString& Path)
+{
+    TArray<TSharedPtr<FJsonValue>> Entries;
+    for (const FGridBenchmarkResult& Result : Results)
+    {
+        TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("Name"), Result.Name);
+        Entry->SetNumberField(TEXT("GridSize"), Result.GridSize);
+        Entry->SetNumberField(TEXT("Density"), Result.Density);
+        Entry->SetNumberField(TEXT("Samples"), Result.Microseconds.Num());
+        Entry->SetNumberField(TEXT("MinUs"), Result.GetPercentile(0.0));
+        Entry->SetNumberField(TEXT("MedianUs"), Result.GetPercentile(0.5));
+        Entry->SetNumberField(TEXT("MeanUs"), Result.GetMean());
+        Entry->SetNumberField(TEXT("P95Us"), Result.GetPercentile(0.95));
+        Entry->SetNumberField(TEXT("AllocationsPerCall"), Result.GetAllocationsPerCall());
+        Entries.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("Label"), Label);
+    Root->SetStringField(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+    Root->SetStringField(TEXT("Configuration"), LexToString(FApp::GetBuildConfiguration()));
+    Root->SetStringField(TEXT("CPU"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+    Root->SetNumberField(TEXT("Seed"), Seed);
+    Root->SetStringField(TEXT("BitboardBackend"), FGridBitboard::GetBackendName());
+    Root->SetArrayField(TEXT("Results"), Entries);
+
+    FString Json;
+    FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json));
+    return FFileHelper::SaveStringToFile(Json, *Path);
+}
+
+/**
+ * @brief Reads a previous report, keyed like FGridBenchmarkResult::GetKey.
+ * @return False if the file is missing or is not a report.
+ */
+bool FGridBenchmark::LoadBaseline(const FString& Path, TMap<FString, FGridBenchmarkBaseline>& OutEntries)
+{
+    FString Json;
+    if (!FFileHelper::LoadFileToString(Json, *Path))
+        return false;
+
+    TSharedPtr<FJsonObject> Root;
+    if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+        return false;
+
+    const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+    if (!Root->TryGetArrayField(TEXT("Results"), Entries))
+        return false;
+
+    for (const TSharedPtr<FJsonValue>& Value : *Entries)
+    {
+        const TSharedPtr<FJsonObject> Entry = Value->AsObject();
+        if (!Entry.IsValid())
+            continue;
+
+        const FString Key = FString::Printf(TEXT("%s/%d/%d"), *Entry->GetStringField(TEXT("Name")),
+            static_cast<int32>(Entry->GetNumberField(TEXT("GridSize"))), static_cast<int32>(Entry->GetNumberField(TEXT("Density"))));
+        FGridBenchmarkBaseline& Baseline = OutEntries.Add(Key);
+        Baseline.MedianUs = Entry->GetNumberField(TEXT("MedianUs"));
+        Entry->TryGetNumberField(TEXT("AllocationsPerCall"), Baseline.AllocationsPerCall);
+    }
+    return true;
+}
+
+/**
+ * @brief Compares results against a baseline report.
+ *
+ * A benchmark regresses when its median is slower than the baseline by more than Tolerance (and
+ * by more than timer noise), or when it allocates more per call.
+ *
+ * @param OutMessages Receives one line per regression.
+ * @return The number of regressions.
+ */
+int32 FGridBenchmark::FindRegressions(const TArray<FGridBenchmarkResult>& Results, const TMap<FString, FGridBenchmarkBaseline>& Baseline,
+    float Tolerance, TArray<FString>& OutMessages)
+{
+    const int32 NumMessages = OutMessages.Num();
+    for (const FGridBenchmarkResult& Result : Results)
+    {
+        const FGridBenchmarkBaseline* Entry = Baseline.Find(Result.GetKey());
+        if (!Entry)
+            continue;
+
+        const double Median = Result.GetPercentile(0.5);
+        if (Median > Entry->MedianUs * (1.0 + Tolerance) && Median - Entry->MedianUs > MinRegressionMicroseconds)
+        {
+            OutMessages.Add(FString::Printf(TEXT("Regression: %s median %.2f us, baseline %.2f us"), *Result.GetKey(), Median, Entry->MedianUs));
+        }
+
+        if (Result.GetAllocationsPerCall() > Entry->AllocationsPerCall + MinRegressionAllocations)
+        {
+            OutMessages.Add(FString::Printf(TEXT("Regression: %s makes %.2f allocations per call, baseline %.2f"), *Result.GetKey(),
+                Result.GetAllocationsPerCall(), Entry->AllocationsPerCall));
+        }
+    }
+    return OutMessages.Num() - NumMessages;
+}
@@ -0,0 +1,120 @@
+#include "GridBenchmarkCommandlet.h"
+#include "StrategicNonsense.h"
+#include "GridBenchmark.h"
+#include "Engine/Engine.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    TArray<int32> ParseIntList(const FString& Params, const TCHAR* Key, const TArray<int32>& Default)
+    {
+        FString Value;
+        if (!FParse::Value(*Params, Key, Value, /*bShouldStopOnSeparator*/ false))
+            return Default;
+
+        TArray<FString> Parts;
+        Value.ParseIntoArray(Parts, TEXT(","));
+
+        TArray<int32> Result;
+        for (const FString& Part : Parts)
+        {
+            Result.Add(FCString::Atoi(*Part));
+        }
+        return Result;
+    }
+}
+
+UGridBenchmarkCommandlet::UGridBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+/**
+ * @brief Runs every benchmark for each size and density, writes the JSON report and checks the baseline.
+ * @param Params Command line parameters (see the class comment).
+ * @return 0 on success, 1 on bad parameters or I/O failure, 2 if a benchmark regressed against the baseline.
+ */
+int32 UGridBenchmarkCommandlet::Main(const FString& Params)
+{
+    const TArray<int32> Sizes = ParseIntList(Params, TEXT("Sizes="), FGridBenchmark::GetDefaultSizes());
+    const TArray<int32> Densities = ParseIntList(Params, TEXT("Densities="), FGridBenchmark::GetDefaultDensities());
+
+    int32 NumSamples = FGridBenchmark::DefaultNumSamples;
+    int32 Seed = 0;
+    float Tolerance = FGridBenchmark::DefaultTolerance;
+    FString Label;
+    FString BaselinePath;
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks/GridBenchmark.json");
+
+    FParse::Value(*Params, TEXT("Samples="), NumSamples);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+    FParse::Value(*Params, TEXT("Label="), Label);
+    FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    if (NumSamples <= 0 || Sizes.IsEmpty() || Densities.IsEmpty() || !GEngine)
+    {
+        UE_LOG(LogSNGrid, Error, TEXT("GridBenchmark needs a positive sample count, at least one size and density, and an engine."));
+        return 1;
+    }
+
+    FGridBenchmark::BeginAllocationCounting();
+
+    TArray<FGridBenchmarkResult> Results;
+    int32 ConfigIndex = 0;
+
+    for (int32 GridSize : Sizes)
+    {
+        for (int32 Density : Densities)
+        {
+            if (GridSize <= 0 || Density < 0 || Density > 100)
+            {
+                UE_LOG(LogSNGrid, Warning, TEXT("Skipping invalid configuration %dx%d at %d%%"), GridSize, GridSize, Density);
+                continue;
+            }
+
+            UE_LOG(LogSNGrid, Display, TEXT("Benchmarking %dx%d at %d%% obstacles"), GridSize, GridSize, Density);
+            FGridBenchmark::RunConfiguration(GridSize, Density, NumSamples, Seed + ConfigIndex++, Results);
+        }
+    }
+
+    FGridBenchmark::EndAllocationCounting();
+
+    for (const FGridBenchmarkResult& Result : Results)
+    {
+        UE_LOG(LogSNGrid, Display, TEXT("%-32s %4dx%-4d %3d%%  median %10.2f us  p95 %10.2f us  %6.2f allocs/call"), *Result.Name,
+            Result.GridSize, Result.GridSize, Result.Density, Result.GetPercentile(0.5), Result.GetPercentile(0.95), Result.GetAllocationsPerCall());
+    }
+
+    if (!FGridBenchmark::SaveReport(Results, Label, Seed, OutputPath))
+    {
+        UE_LOG(LogSNGrid, Error, TEXT("Failed to write benchmark results to %s"), *OutputPath);
+        return 1;
+    }
+    UE_LOG(LogSNGrid, Display, TEXT("Benchmark results written to %s"), *OutputPath);
+
+    if (BaselinePath.IsEmpty())
+        return 0;
+
+    // Regression check
+    TMap<FString, FGridBenchmarkBaseline> BaselineEntries;
+    if (!FGridBenchmark::LoadBaseline(BaselinePath, BaselineEntries))
+    {
+        UE_LOG(LogSNGrid, Error, TEXT("Failed to read baseline %s"), *BaselinePath);
+        return 1;
+    }
+
+    TArray<FString> Regressions;
+    const int32 NumRegressions = FGridBenchmark::FindRegressions(Results, BaselineEntries, Tolerance, Regressions);
+    for (const FString& Regression : Regressions)
+    {
+        UE_LOG(LogSNGrid, Error, TEXT("%s"), *Regression);
+    }
+
+    UE_LOG(LogSNGrid, Display, TEXT("%d regression(s) against %s"), NumRegressions, *BaselinePath);
+    return NumRegressions > 0 ? 2 : 0;
+}
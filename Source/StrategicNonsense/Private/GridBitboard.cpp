@@ -0,0 +1,483 @@
+#include "GridBitboard.h"
+#include "GridOccupancy.h"
+
+// Word loops use the widest integer SIMD the target is always compiled for
+#if PLATFORM_CPU_X86_FAMILY && defined(PLATFORM_ALWAYS_HAS_AVX_2) && PLATFORM_ALWAYS_HAS_AVX_2
+    #include <immintrin.h>
+    #define GRID_BITBOARD_AVX2 1
+#elif PLATFORM_CPU_X86_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS
+    #include <emmintrin.h>
+    #define GRID_BITBOARD_SSE2 1
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+    #include <arm_neon.h>
+    #define GRID_BITBOARD_NEON 1
+#endif
+
+#ifndef GRID_BITBOARD_AVX2
+    #define GRID_BITBOARD_AVX2 0
+#endif
+#ifndef GRID_BITBOARD_SSE2
+    #define GRID_BITBOARD_SSE2 0
+#endif
+#ifndef GRID_BITBOARD_NEON
+    #define GRID_BITBOARD_NEON 0
+#endif
+
+namespace
+{
+    /** One 64-bit word at a time; also handles the tail of every vector loop. */
+    struct FScalarWords
+    {
+        using Type = uint64;
+        static constexpr int32 Lanes = 1;
+
+        static Type Load(const uint64* Words) { return *Words; }
+        static void Store(uint64* Words, Type Value) { *Words = Value; }
+        static Type And(Type A, Type B) { return A & B; }
+        static Type Or(Type A, Type B) { return A | B; }
+        static Type AndNot(Type A, Type B) { return A & ~B; }
+        template <int32 Bits> static Type ShiftLeft(Type Value) { return Value << Bits; }
+        template <int32 Bits> static Type ShiftRight(Type Value) { return Value >> Bits; }
+        static bool IsZero(Type Value) { return Value == 0; }
+    };
+
+#if GRID_BITBOARD_AVX2
+    struct FVectorWords
+    {
+        using Type = __m256i;
+        static constexpr int32 Lanes = 4;
+
+        static Type Load(const uint64* Words) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Words)); }
+        static void Store(uint64* Words, Type Value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(Words), Value); }
+        static Type And(Type A, Type B) { return _mm256_and_si256(A, B); }
+        static Type Or(Type A, Type B) { return _mm256_or_si256(A, B); }
+        static Type AndNot(Type A, Type B) { return _mm256_andnot_si256(B, A); }
+        template <int32 Bits> static Type ShiftLeft(Type Value) { return _mm256_slli_epi64(Value, Bits); }
+        template <int32 Bits> static Type ShiftRight(Type Value) { return _mm256_srli_epi64(Value, Bits); }
+        static bool IsZero(Type Value) { return _mm256_testz_si256(Value, Value) != 0; }
+    };
+#elif GRID_BITBOARD_SSE2
+    struct FVectorWords
+    {
+        using Type = __m128i;
+        static constexpr int32 Lanes = 2;
+
+        static Type Load(const uint64* Words) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(Words)); }
+        static void Store(uint64* Words, Type Value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(Words), Value); }
+        static Type And(Type A, Type B) { return _mm_and_si128(A, B); }
+        static Type Or(Type A, Type B) { return _mm_or_si128(A, B); }
+        static Type AndNot(Type A, Type B) { return _mm_andnot_si128(B, A); }
+        template <int32 Bits> static Type ShiftLeft(Type Value) { return _mm_slli_epi64(Value, Bits); }
+        template <int32 Bits> static Type ShiftRight(Type Value) { return _mm_srli_epi64(Value, Bits); }
+        static bool IsZero(Type Value) { return _mm_movemask_epi8(_mm_cmpeq_epi8(Value, _mm_setzero_si128())) == 0xFFFF; }
+    };
+#elif GRID_BITBOARD_NEON
+    struct FVectorWords
+    {
+        using Type = uint64x2_t;
+        static constexpr int32 Lanes = 2;
+
+        static Type Load(const uint64* Words) { return vld1q_u64(Words); }
+        static void Store(uint64* Words, Type Value) { vst1q_u64(Words, Value); }
+        static Type And(Type A, Type B) { return vandq_u64(A, B); }
+        static Type Or(Type A, Type B) { return vorrq_u64(A, B); }
+        static Type AndNot(Type A, Type B) { return vbicq_u64(A, B); }
+        template <int32 Bits> static Type ShiftLeft(Type Value) { return vshlq_n_u64(Value, Bits); }
+        template <int32 Bits> static Type ShiftRight(Type Value) { return vshrq_n_u64(Value, Bits); }
+        static bool IsZero(Type Value) { return (vgetq_lane_u64(Value, 0) | vgetq_lane_u64(Value, 1)) == 0; }
+    };
+#endif
+
+    /** Calls Kernel(Ops, Word) over [0, NumWords), a vector of words at a time where the backend allows. */
+    template <typename KernelType>
+    FORCEINLINE void ForEachWordBlock(int32 NumWords, KernelType&& Kernel)
+    {
+        int32 Word = 0;
+#if GRID_BITBOARD_AVX2 || GRID_BITBOARD_SSE2 || GRID_BITBOARD_NEON
+        for (; Word + FVectorWords::Lanes <= NumWords; Word += FVectorWords::Lanes)
+        {
+            Kernel(FVectorWords(), Word);
+        }
+#endif
+        for (; Word < NumWords; ++Word)
+        {
+            Kernel(FScalarWords(), Word);
+        }
+    }
+
+    /** Grows Seeds through the runs of Open bits they sit in, towards higher bits (Kogge-Stone). */
+    template <typename Ops>
+    FORCEINLINE typename Ops::Type FillUp(typename Ops::Type Seeds, typename Ops::Type Open)
+    {
+        Seeds = Ops::Or(Seeds, Ops::And(Open, Ops::template ShiftLeft<1>(Seeds)));
+        Open = Ops::And(Open, Ops::template ShiftLeft<1>(Open));
+        Seeds = Ops::Or(Seeds, Ops::And(Open, Ops::template ShiftLeft<2>(Seeds)));
+        Open = Ops::And(Open, Ops::template ShiftLeft<2>(Open));
+        Seeds = Ops::Or(Seeds, Ops::And(Open, Ops::template ShiftLeft<4>(Seeds)));
+        Open = Ops::And(Open, Ops::template ShiftLeft<4>(Open));
+        Seeds = Ops::Or(Seeds, Ops::And(Open, Ops::template ShiftLeft<8>(Seeds)));
+        Open = Ops::And(Open, Ops::template ShiftLeft<8>(Open));
+        Seeds = Ops::Or(Seeds, Ops::And(Open, Ops::template ShiftLeft<16>(Seeds)));
+        Open = Ops::And(Open, Ops::template ShiftLeft<16>(Open));
+        return Ops::Or(Seeds, Ops::And(Open, Ops::template ShiftLeft<32>(Seeds)));
+    }
+
+    /** As FillUp, towards lower bits. */
+    template <typename Ops>
+    FORCEINLINE typename Ops::Type FillDown(typename Ops::Type Seeds, typename Ops::Type Open)
+    {
+        Seeds = Ops::Or(Seeds, Ops::And(Open, Ops::template ShiftRight<1>(Seeds)));
+        Open = Ops::And(Open, Ops::template ShiftRight<1>(Open));
+        Seeds = Ops::Or(Seeds, Ops::And(Open, Ops::template ShiftRight<2>(Seeds)));
+        Open = Ops::And(Open, Ops::template ShiftRight<2>(Open));
+        Seeds = Ops::Or(Seeds, Ops::And(Open, Ops::template ShiftRight<4>(Seeds)));
+        Open = Ops::And(Open, Ops::template ShiftRight<4>(Open));
+        Seeds = Ops::Or(Seeds, Ops::And(Open, Ops::template ShiftRight<8>(Seeds)));
+        Open = Ops::And(Open, Ops::template ShiftRight<8>(Open));
+        Seeds = Ops::Or(Seeds, Ops::And(Open, Ops::template ShiftRight<16>(Seeds)));
+        Open = Ops::And(Open, Ops::template ShiftRight<16>(Open));
+        return Ops::Or(Seeds, Ops::And(Open, Ops::template ShiftRight<32>(Seeds)));
+    }
+
+    /**
+     * Copies the free bits of occupancy rows [FirstRow, FirstRow + NumRows) and words
+     * [FirstWord, FirstWord + NumWords) into a padded scratch grid with row stride NumWords + 2.
+     */
+    void ExtractFreeWords(const FGridOccupancy& Occupancy, int32 FirstRow, int32 NumRows, int32 FirstWord, int32 NumWords, TArray<uint64>& OutFree)
+    {
+        const int32 Stride = NumWords + 2;
+        const int32 WordsPerRow = Occupancy.GetWordsPerRow();
+        const int32 LastRowBits = Occupancy.GetWidth() & 63;
+        const uint64 LastWordMask = LastRowBits ? ((1ull << LastRowBits) - 1) : ~0ull;
+        const uint64* Blocked = Occupancy.GetBlockedWords().GetData();
+
+        OutFree.SetNumUninitialized((NumRows + 2) * Stride, EAllowShrinking::No);
+        FMemory::Memzero(OutFree.GetData(), OutFree.Num() * sizeof(uint64));
+
+        for (int32 Row = 0; Row < NumRows; ++Row)
+        {
+            const uint64* Source = Blocked + (FirstRow + Row) * WordsPerRow + FirstWord;
+            uint64* Dest = OutFree.GetData() + (Row + 1) * Stride + 1;
+            for (int32 Word = 0; Word < NumWords; ++Word)
+            {
+                Dest[Word] = ~Source[Word];
+            }
+
+            if (FirstWord + NumWords == WordsPerRow)
+            {
+                Dest[NumWords - 1] &= LastWordMask;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Marks every free cell within MaxRange steps of Start, as FGridReachability::FindReachableMask does.
+ * @param Occupancy The occupancy layer; blocked cells (obstacles and units) stop movement.
+ * @param Start The cell to search from; may be blocked by the moving unit.
+ * @param MaxRange Maximum number of steps.
+ * @param OutMask Row-padded bitmask with as many words as the occupancy layer; cleared first.
+ * @return The number of reachable cells, excluding Start.
+ */
+int32 FGridBitboard::FindReachableMask(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, TArrayView<uint64> OutMask)
+{
+    check(OutMask.Num() >= Occupancy.GetBlockedWords().Num());
+    FMemory::Memzero(OutMask.GetData(), OutMask.Num() * sizeof(uint64));
+
+    const int32 NumReached = Dilate(Occupancy, Start, MaxRange, [](const FIntPoint&, int32) {});
+    if (NumReached == 0)
+        return 0;
+
+    const int32 WordsPerRow = Occupancy.GetWordsPerRow();
+    const int32 NumRows = Visited.Num() / BoxStride - 2;
+    for (int32 Row = 0; Row < NumRows; ++Row)
+    {
+        const uint64* Source = Visited.GetData() + (Row + 1) * BoxStride + 1;
+        uint64* Dest = OutMask.GetData() + (BoxFirstRow + Row) * WordsPerRow + BoxFirstWord;
+        FMemory::Memcpy(Dest, Source, (BoxStride - 2) * sizeof(uint64));
+    }
+
+    OutMask[Start.Y * WordsPerRow + (Start.X >> 6)] &= ~(1ull << (Start.X & 63));
+    return NumReached;
+}
+
+/**
+ * @brief Lists every free cell within MaxRange steps of Start, nearest first.
+ * @param Occupancy The occupancy layer; blocked cells (obstacles and units) stop movement.
+ * @param Start The cell to search from; may be blocked by the moving unit.
+ * @param MaxRange Maximum number of steps.
+ * @param OutCells Receives the reachable cells, excluding Start.
+ * @return The number of reachable cells, which may exceed OutCells.Num().
+ */
+int32 FGridBitboard::FindReachableCells(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, TArrayView<FIntPoint> OutCells)
+{
+    int32 NumWritten = 0;
+    return Dilate(Occupancy, Start, MaxRange, [&OutCells, &NumWritten](const FIntPoint& Cell, int32 Distance)
+    {
+        if (NumWritten < OutCells.Num())
+        {
+            OutCells[NumWritten++] = Cell;
+        }
+    });
+}
+
+/**
+ * @brief Lists every free cell within MaxRange steps of Start with its step count, nearest first.
+ *
+ * Cells within one distance come out in row-major order rather than BFS order.
+ *
+ * @param Occupancy The occupancy layer; blocked cells (obstacles and units) stop movement.
+ * @param Start The cell to search from; may be blocked by the moving unit.
+ * @param MaxRange Maximum number of steps.
+ * @param OutCells Receives the reachable cells, excluding Start.
+ * @param OutDistances Receives each cell's step count; at least as long as OutCells.
+ * @return The number of reachable cells, which may exceed OutCells.Num().
+ */
+int32 FGridBitboard::FindReachableCells(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, TArrayView<FIntPoint> OutCells, TArrayView<uint16> OutDistances)
+{
+    check(OutDistances.Num() >= OutCells.Num());
+
+    int32 NumWritten = 0;
+    return Dilate(Occupancy, Start, MaxRange, [&OutCells, &OutDistances, &NumWritten](const FIntPoint& Cell, int32 Distance)
+    {
+        if (NumWritten < OutCells.Num())
+        {
+            OutCells[NumWritten] = Cell;
+            OutDistances[NumWritten] = static_cast<uint16>(Distance);
+            ++NumWritten;
+        }
+    });
+}
+
+/**
+ * @brief Checks whether all of Cells lie in one free region once ExtraBlocked is blocked as well.
+ * @param Occupancy The occupancy layer.
+ * @param ExtraBlocked Cells to treat as blocked on top of the occupancy layer; invalid cells are ignored.
+ * @param Cells The cells that must connect; any blocked or invalid cell makes the answer false.
+ * @return true if every cell in Cells can reach every other.
+ */
+bool FGridBitboard::AreCellsConnected(const FGridOccupancy& Occupancy, TConstArrayView<FIntPoint> ExtraBlocked, TConstArrayView<FIntPoint> Cells)
+{
+    if (Cells.Num() == 0)
+        return true;
+
+    const int32 Height = Occupancy.GetHeight();
+    const int32 WordsPerRow = Occupancy.GetWordsPerRow();
+    const int32 Stride = WordsPerRow + 2;
+
+    ExtractFreeWords(Occupancy, 0, Height, 0, WordsPerRow, Free);
+    for (const FIntPoint& Cell : ExtraBlocked)
+    {
+        if (Occupancy.IsValidCell(Cell))
+        {
+            Free[(Cell.Y + 1) * Stride + 1 + (Cell.X >> 6)] &= ~(1ull << (Cell.X & 63));
+        }
+    }
+
+    auto IsSet = [Stride](const TArray<uint64>& Words, const FIntPoint& Cell)
+    {
+        return (Words[(Cell.Y + 1) * Stride + 1 + (Cell.X >> 6)] >> (Cell.X & 63)) & 1ull;
+    };
+
+    for (const FIntPoint& Cell : Cells)
+    {
+        if (!Occupancy.IsValidCell(Cell) || !IsSet(Free, Cell))
+            return false;
+    }
+
+    Visited.SetNumUninitialized(Free.Num(), EAllowShrinking::No);
+    FMemory::Memzero(Visited.GetData(), Visited.Num() * sizeof(uint64));
+    Visited[(Cells[0].Y + 1) * Stride + 1 + (Cells[0].X >> 6)] |= 1ull << (Cells[0].X & 63);
+
+    // Grows the row's seeds through the free runs they touch, then carries across word boundaries
+    auto FillRow = [this, WordsPerRow](int32 RowStart, bool bFromNeighbours) -> bool
+    {
+        const uint64* Above = Visited.GetData() + RowStart - (WordsPerRow + 2);
+        const uint64* Below = Visited.GetData() + RowStart + (WordsPerRow + 2);
+        const uint64* Open = Free.GetData() + RowStart;
+        uint64* Row = Visited.GetData() + RowStart;
+
+        bool bGrew = !bFromNeighbours;
+        ForEachWordBlock(WordsPerRow, [&](auto Ops, int32 Word)
+        {
+            using OpsType = decltype(Ops);
+            const auto Current = OpsType::Load(Row + Word);
+            const auto FreeWords = OpsType::Load(Open + Word);
+            const auto Seeds = OpsType::Or(Current, OpsType::And(OpsType::Or(OpsType::Load(Above + Word), OpsType::Load(Below + Word)), FreeWords));
+            if (!OpsType::IsZero(OpsType::AndNot(Seeds, Current)))
+            {
+                bGrew = true;
+            }
+            OpsType::Store(Row + Word, Seeds);
+        });
+
+        if (!bGrew)
+            return false;
+
+        ForEachWordBlock(WordsPerRow, [&](auto Ops, int32 Word)
+        {
+            using OpsType = decltype(Ops);
+            const auto Seeds = OpsType::Load(Row + Word);
+            const auto FreeWords = OpsType::Load(Open + Word);
+            OpsType::Store(Row + Word, OpsType::Or(FillUp<OpsType>(Seeds, FreeWords), FillDown<OpsType>(Seeds, FreeWords)));
+        });
+
+        for (int32 Word = 1; Word < WordsPerRow; ++Word)
+        {
+            if ((Row[Word - 1] >> 63) && (Open[Word] & 1ull) && !(Row[Word] & 1ull))
+            {
+                Row[Word] = FillUp<FScalarWords>(Row[Word] | 1ull, Open[Word]);
+            }
+        }
+        for (int32 Word = WordsPerRow - 2; Word >= 0; --Word)
+        {
+            if ((Row[Word + 1] & 1ull) && (Open[Word] >> 63) && !(Row[Word] >> 63))
+            {
+                Row[Word] = FillDown<FScalarWords>(Row[Word] | (1ull << 63), Open[Word]);
+            }
+        }
+
+        return true;
+    };
+
+    FillRow((Cells[0].Y + 1) * Stride + 1, false);
+
+    for (;;)
+    {
+        bool bChanged = false;
+        for (int32 Row = 0; Row < Height; ++Row)
+        {
+            bChanged |= FillRow((Row + 1) * Stride + 1, true);
+        }
+        for (int32 Row = Height - 1; Row >= 0; --Row)
+        {
+            bChanged |= FillRow((Row + 1) * Stride + 1, true);
+        }
+
+        bool bAllReached = true;
+        for (const FIntPoint& Cell : Cells)
+        {
+            if (!IsSet(Visited, Cell))
+            {
+                bAllReached = false;
+                break;
+            }
+        }
+
+        if (bAllReached)
+            return true;
+
+        if (!bChanged)
+            return false;
+    }
+}
+
+/**
+ * @brief Name of the instruction set the word loops were compiled for.
+ */
+const TCHAR* FGridBitboard::GetBackendName()
+{
+#if GRID_BITBOARD_AVX2
+    return TEXT("AVX2");
+#elif GRID_BITBOARD_SSE2
+    return TEXT("SSE2");
+#elif GRID_BITBOARD_NEON
+    return TEXT("NEON");
+#else
+    return TEXT("Scalar");
+#endif
+}
+
+/**
+ * @brief Layered dilation from Start inside the bounding box of the range diamond.
+ *
+ * Calls Visitor(Cell, Distance) for every newly reached cell, one distance layer at a time.
+ * Leaves the box's reached cells (including Start) in Visited.
+ *
+ * @return The number of cells reached, excluding Start.
+ */
+template <typename VisitorType>
+int32 FGridBitboard::Dilate(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, VisitorType&& Visitor)
+{
+    if (MaxRange <= 0 || !Occupancy.IsValidCell(Start))
+        return 0;
+
+    const int32 LastRow = FMath::Min(Start.Y + MaxRange, Occupancy.GetHeight() - 1);
+    const int32 LastWord = FMath::Min(Start.X + MaxRange, Occupancy.GetWidth() - 1) >> 6;
+    BoxFirstRow = FMath::Max(Start.Y - MaxRange, 0);
+    BoxFirstWord = FMath::Max(Start.X - MaxRange, 0) >> 6;
+
+    const int32 NumRows = LastRow - BoxFirstRow + 1;
+    const int32 NumWords = LastWord - BoxFirstWord + 1;
+    BoxStride = NumWords + 2;
+
+    ExtractFreeWords(Occupancy, BoxFirstRow, NumRows, BoxFirstWord, NumWords, Free);
+
+    for (TArray<uint64>* Buffer : { &Visited, &Frontier, &Next })
+    {
+        Buffer->SetNumUninitialized(Free.Num(), EAllowShrinking::No);
+        FMemory::Memzero(Buffer->GetData(), Buffer->Num() * sizeof(uint64));
+    }
+
+    const int32 StartRow = Start.Y - BoxFirstRow;
+    const int32 StartWord = (StartRow + 1) * BoxStride + 1 + (Start.X >> 6) - BoxFirstWord;
+    Visited[StartWord] = Frontier[StartWord] = 1ull << (Start.X & 63);
+
+    int32 NumReached = 0;
+    for (int32 Distance = 1; Distance <= MaxRange; ++Distance)
+    {
+        // Layer Distance can only touch rows within Distance of Start
+        const int32 FirstLayerRow = FMath::Max(StartRow - Distance, 0);
+        const int32 LastLayerRow = FMath::Min(StartRow + Distance, NumRows - 1);
+
+        bool bGrew = false;
+        for (int32 Row = FirstLayerRow; Row <= LastLayerRow; ++Row)
+        {
+            const int32 RowStart = (Row + 1) * BoxStride + 1;
+            const uint64* Front = Frontier.GetData() + RowStart;
+            const uint64* Open = Free.GetData() + RowStart;
+            uint64* Seen = Visited.GetData() + RowStart;
+            uint64* Layer = Next.GetData() + RowStart;
+
+            ForEachWordBlock(NumWords, [&](auto Ops, int32 Word)
+            {
+                using OpsType = decltype(Ops);
+                const auto Centre = OpsType::Load(Front + Word);
+                const auto Sideways = OpsType::Or(
+                    OpsType::Or(OpsType::template ShiftLeft<1>(Centre), OpsType::template ShiftRight<63>(OpsType::Load(Front + Word - 1))),
+                    OpsType::Or(OpsType::template ShiftRight<1>(Centre), OpsType::template ShiftLeft<63>(OpsType::Load(Front + Word + 1))));
+                const auto Vertical = OpsType::Or(OpsType::Load(Front + Word - BoxStride), OpsType::Load(Front + Word + BoxStride));
+                const auto SeenWords = OpsType::Load(Seen + Word);
+                const auto Reached = OpsType::AndNot(OpsType::And(OpsType::Or(Sideways, Vertical), OpsType::Load(Open + Word)), SeenWords);
+
+                OpsType::Store(Layer + Word, Reached);
+                OpsType::Store(Seen + Word, OpsType::Or(SeenWords, Reached));
+                if (!OpsType::IsZero(Reached))
+                {
+                    bGrew = true;
+                }
+            });
+        }
+
+        if (!bGrew)
+            break;
+
+        for (int32 Row = FirstLayerRow; Row <= LastLayerRow; ++Row)
+        {
+            const uint64* Layer = Next.GetData() + (Row + 1) * BoxStride + 1;
+            for (int32 Word = 0; Word < NumWords; ++Word)
+            {
+                for (uint64 Bits = Layer[Word]; Bits; Bits &= Bits - 1)
+                {
+                    const int32 X = (BoxFirstWord + Word) * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+                    Visitor(FIntPoint(X, BoxFirstRow + Row), Distance);
+                    ++NumReached;
+                }
+            }
+        }
+
+        Swap(Frontier, Next);
+    }
+
+    return NumReached;
+}
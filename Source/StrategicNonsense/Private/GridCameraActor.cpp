@@ -1,5 +1,6 @@
 // GridCameraActor.cpp
 #include "GridCameraActor.h"
+#include "StrategicNonsense.h"
 #include "GridManager.h"
 #include "Camera/CameraComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -32,13 +33,13 @@ void AGridCameraActor::BeginPlay()
     APlayerController* PlayerController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
     if (PlayerController)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Forcing Camera View Target!"));
+        UE_LOG(LogSNGame, Log, TEXT("Forcing Camera View Target!"));
         PlayerController->SetViewTarget(this);
 
     }
     else
     {
-        UE_LOG(LogTemp, Error, TEXT("No Player Controller Found!"));
+        UE_LOG(LogSNGame, Error, TEXT("No Player Controller Found!"));
     }
 
     ConfigureCamera();
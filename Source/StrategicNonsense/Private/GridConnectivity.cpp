@@ -0,0 +1,192 @@
+#include "GridConnectivity.h"
+#include "StrategicNonsense.h"
+#include "GridOccupancy.h"
+
+DECLARE_CYCLE_STAT(TEXT("WouldDisconnect"), STAT_SNWouldDisconnect, STATGROUP_StrategicNonsense);
+
+namespace
+{
+    const FIntPoint GConnectivityDirections[] = {
+        FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1)
+    };
+}
+
+/**
+ * @brief Checks whether blocking the given cells would split the free region of the grid.
+ *
+ * Footprint cells that are already blocked or out of bounds are ignored; repeated cells count once.
+ *
+ * @param Occupancy The current occupancy layer (free cells assumed connected).
+ * @param Footprint The cells the proposed obstacle would occupy.
+ * @return true if the placement would disconnect the free cells or leave none; false otherwise.
+ */
+bool FGridConnectivity::WouldDisconnect(const FGridOccupancy& Occupancy, TConstArrayView<FIntPoint> Footprint)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FGridConnectivity::WouldDisconnect);
+    SCOPE_CYCLE_COUNTER(STAT_SNWouldDisconnect);
+
+    PrepareScratch(Occupancy.GetNumCells());
+    ++Generation;
+
+    int32 NumNewlyBlocked = 0;
+    for (const FIntPoint& Cell : Footprint)
+    {
+        if (IsOpen(Occupancy, Cell) && FootprintStamp[Occupancy.ToIndex(Cell)] != Generation)
+        {
+            FootprintStamp[Occupancy.ToIndex(Cell)] = Generation;
+            ++NumNewlyBlocked;
+        }
+    }
+
+    if (Occupancy.GetNumFree() - NumNewlyBlocked <= 0)
+        return true; // No free cells left
+
+    if (NumNewlyBlocked == 0)
+        return false; // Nothing changes
+
+    // Seed one search from every free cell bordering the footprint
+    int32 NumSeeds = 0;
+    for (const FIntPoint& Cell : Footprint)
+    {
+        for (const FIntPoint& Dir : GConnectivityDirections)
+        {
+            const FIntPoint Neighbour = Cell + Dir;
+            if (!IsOpen(Occupancy, Neighbour)) continue;
+
+            const int32 NeighbourIndex = Occupancy.ToIndex(Neighbour);
+            if (FootprintStamp[NeighbourIndex] == Generation) continue;
+            if (OwnerStamp[NeighbourIndex] == Generation) continue;
+
+            if (SeedQueues.Num() <= NumSeeds)
+            {
+                SeedQueues.AddDefaulted(NumSeeds + 1 - SeedQueues.Num());
+            }
+
+            OwnerStamp[NeighbourIndex] = Generation;
+            Owner[NeighbourIndex] = NumSeeds;
+            SeedQueues[NumSeeds].Reset();
+            SeedQueues[NumSeeds].Add(Neighbour);
+            ++NumSeeds;
+        }
+    }
+
+    // Free cells remain but none border the footprint: the region was already split
+    if (NumSeeds == 0)
+        return true;
+
+    SeedHeads.SetNumUninitialized(NumSeeds);
+    GroupParent.SetNumUninitialized(NumSeeds);
+    GroupActiveQueues.SetNumUninitialized(NumSeeds);
+    for (int32 Seed = 0; Seed < NumSeeds; ++Seed)
+    {
+        SeedHeads[Seed] = 0;
+        GroupParent[Seed] = Seed;
+        GroupActiveQueues[Seed] = 1;
+    }
+
+    int32 NumGroups = NumSeeds;
+    int32 ExpansionBudget = FMath::Max(MinExpansionBudget, Occupancy.GetNumCells() / ExpansionBudgetDivisor);
+
+    // Expand every live search by one cell per round until all meet or one group is sealed off
+    while (NumGroups > 1)
+    {
+        for (int32 Seed = 0; Seed < NumSeeds && NumGroups > 1; ++Seed)
+        {
+            TArray<FIntPoint>& Queue = SeedQueues[Seed];
+            if (SeedHeads[Seed] >= Queue.Num()) continue;
+
+            // Both sides of the cut are large; flooding the whole grid a word at a time is cheaper from here
+            if (--ExpansionBudget < 0)
+            {
+                SeedCells.Reset();
+                for (int32 Other = 0; Other < NumSeeds; ++Other)
+                {
+                    SeedCells.Add(SeedQueues[Other][0]);
+                }
+                return !Bitboard.AreCellsConnected(Occupancy, Footprint, SeedCells);
+            }
+
+            const FIntPoint Current = Queue[SeedHeads[Seed]++];
+
+            for (const FIntPoint& Dir : GConnectivityDirections)
+            {
+                const FIntPoint Neighbour = Current + Dir;
+                if (!IsOpen(Occupancy, Neighbour)) continue;
+
+                const int32 NeighbourIndex = Occupancy.ToIndex(Neighbour);
+                if (FootprintStamp[NeighbourIndex] == Generation) continue;
+
+                if (OwnerStamp[NeighbourIndex] != Generation)
+                {
+                    OwnerStamp[NeighbourIndex] = Generation;
+                    Owner[NeighbourIndex] = Seed;
+                    Queue.Add(Neighbour);
+                    continue;
+                }
+
+                const int32 GroupA = FindGroup(Seed);
+                const int32 GroupB = FindGroup(Owner[NeighbourIndex]);
+                if (GroupA != GroupB)
+                {
+                    GroupParent[GroupB] = GroupA;
+                    GroupActiveQueues[GroupA] += GroupActiveQueues[GroupB];
+                    --NumGroups;
+                }
+            }
+
+            if (SeedHeads[Seed] >= Queue.Num())
+            {
+                const int32 Group = FindGroup(Seed);
+                if (--GroupActiveQueues[Group] == 0 && NumGroups > 1)
+                {
+                    return true; // This group's component is enclosed; connectivity broken
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Grows the stamp and owner buffers to cover the grid; resets stamps when they would wrap.
+ * @param NumCells Number of cells in the grid.
+ */
+void FGridConnectivity::PrepareScratch(int32 NumCells)
+{
+    if (FootprintStamp.Num() != NumCells || Generation == MAX_uint32)
+    {
+        FootprintStamp.Reset();
+        FootprintStamp.SetNumZeroed(NumCells);
+        OwnerStamp.Reset();
+        OwnerStamp.SetNumZeroed(NumCells);
+        Owner.SetNumUninitialized(NumCells);
+        Generation = 0;
+    }
+}
+
+/**
+ * @brief Checks whether a cell is inside the grid and not blocked by an existing obstacle or unit.
+ * @param Occupancy The occupancy layer.
+ * @param Cell The grid coordinate.
+ * @return true if the cell is currently free.
+ */
+bool FGridConnectivity::IsOpen(const FGridOccupancy& Occupancy, const FIntPoint& Cell) const
+{
+    return Occupancy.IsValidCell(Cell) && !Occupancy.IsBlocked(Cell);
+}
+
+/**
+ * @brief Finds the representative of a seed's merged group, compressing the path on the way.
+ * @param Seed Index of the seed search.
+ * @return Index of the group's root seed.
+ */
+int32 FGridConnectivity::FindGroup(int32 Seed)
+{
+    while (GroupParent[Seed] != Seed)
+    {
+        GroupParent[Seed] = GroupParent[GroupParent[Seed]];
+        Seed = GroupParent[Seed];
+    }
+    return Seed;
+}
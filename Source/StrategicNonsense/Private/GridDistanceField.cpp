@@ -0,0 +1,379 @@
+#include "GridDistanceField.h"
+#include "GridOccupancy.h"
+
+namespace
+{
+    const FIntPoint NeighbourOffsets[] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+}
+
+/**
+ * @brief Fills the field with a multi-source BFS from InSources over the current occupancy.
+ *
+ * Sources outside the grid are ignored; duplicates are allowed and counted, so a cell stays a
+ * source until every copy is removed.
+ *
+ * @param Occupancy The blocked layer to search over.
+ * @param InSources Cells at distance zero.
+ * @param InBlocked Optional extra blocked cells, empty or laid out like Occupancy.GetBlockedWords().
+ *                  Sources pass even when masked.
+ */
+void FGridDistanceField::Compute(const FGridOccupancy& Occupancy, TConstArrayView<FIntPoint> InSources, TConstArrayView<uint64> InBlocked)
+{
+    Width = Occupancy.GetWidth();
+    Height = Occupancy.GetHeight();
+    WordsPerRow = Occupancy.GetWordsPerRow();
+    const int32 NumCells = Occupancy.GetNumCells();
+
+    check(InBlocked.IsEmpty() || InBlocked.Num() == Occupancy.GetBlockedWords().Num());
+    BlockedMask.Reset();
+    BlockedMask.Append(InBlocked.GetData(), InBlocked.Num());
+
+    Distances.SetNumUninitialized(NumCells, EAllowShrinking::No);
+    for (int16& Distance : Distances)
+    {
+        Distance = Unreachable;
+    }
+
+    SourceCounts.SetNumUninitialized(NumCells, EAllowShrinking::No);
+    FMemory::Memzero(SourceCounts.GetData(), NumCells * sizeof(uint16));
+
+    Sources.Reset();
+    Queue.Reset();
+    for (const FIntPoint& Source : InSources)
+    {
+        if (!Occupancy.IsValidCell(Source))
+            continue;
+
+        const int32 Index = Occupancy.ToIndex(Source);
+        if (SourceCounts[Index] == MaxSourceCopies)
+            continue;
+
+        Sources.Add(Source);
+        if (SourceCounts[Index]++ == 0)
+        {
+            Distances[Index] = 0;
+            Queue.Add(Index);
+        }
+    }
+
+    for (int32 Head = 0; Head < Queue.Num(); ++Head)
+    {
+        const int32 Index = Queue[Head];
+        const int32 NextDistance = Distances[Index] + 1;
+        if (NextDistance >= Unreachable)
+            break;
+
+        const FIntPoint Cell = Occupancy.ToCell(Index);
+        for (const FIntPoint& Offset : NeighbourOffsets)
+        {
+            const FIntPoint Next = Cell + Offset;
+            if (!Occupancy.IsValidCell(Next))
+                continue;
+
+            const int32 NextIndex = Occupancy.ToIndex(Next);
+            if (Distances[NextIndex] != Unreachable || !IsPassable(Occupancy, NextIndex))
+                continue;
+
+            Distances[NextIndex] = static_cast<int16>(NextDistance);
+            Queue.Add(NextIndex);
+        }
+    }
+
+    LastNumRepaired = Queue.Num();
+}
+
+/**
+ * @brief Rebuilds the field from its current sources and mask, e.g. after the grid was regenerated.
+ *
+ * A mask made for a grid of a different size is dropped.
+ *
+ * @param Occupancy The blocked layer to search over.
+ */
+void FGridDistanceField::Recompute(const FGridOccupancy& Occupancy)
+{
+    TArray<FIntPoint> CurrentSources = MoveTemp(Sources);
+    TArray<uint64> CurrentMask = MoveTemp(BlockedMask);
+    if (CurrentMask.Num() != Occupancy.GetBlockedWords().Num())
+    {
+        CurrentMask.Reset();
+    }
+    Compute(Occupancy, CurrentSources, CurrentMask);
+}
+
+/**
+ * @brief Repairs the field after Cell became blocked or free.
+ * @param Occupancy The blocked layer, already updated.
+ * @param Cell The cell whose blocked state changed.
+ */
+void FGridDistanceField::OnCellChanged(const FGridOccupancy& Occupancy, const FIntPoint& Cell)
+{
+    if (Occupancy.GetWidth() != Width || Occupancy.GetHeight() != Height)
+    {
+        Recompute(Occupancy);
+        return;
+    }
+
+    if (Occupancy.IsValidCell(Cell))
+    {
+        Repair(Occupancy, Occupancy.ToIndex(Cell));
+    }
+}
+
+/**
+ * @brief Adds a source and lowers the distances around it.
+ * @param Occupancy The blocked layer the field was computed over.
+ * @param Cell The new source cell.
+ */
+void FGridDistanceField::AddSource(const FGridOccupancy& Occupancy, const FIntPoint& Cell)
+{
+    if (!Occupancy.IsValidCell(Cell) || Occupancy.GetNumCells() != Distances.Num())
+        return;
+
+    const int32 Index = Occupancy.ToIndex(Cell);
+    if (SourceCounts[Index] == MaxSourceCopies)
+        return;
+
+    Sources.Add(Cell);
+    if (SourceCounts[Index]++ == 0)
+    {
+        Repair(Occupancy, Index);
+    }
+}
+
+/**
+ * @brief Removes one copy of a source and raises the distances that depended on it.
+ * @param Occupancy The blocked layer the field was computed over.
+ * @param Cell The source cell to remove; ignored if it is not a source.
+ */
+void FGridDistanceField::RemoveSource(const FGridOccupancy& Occupancy, const FIntPoint& Cell)
+{
+    if (!Occupancy.IsValidCell(Cell) || Occupancy.GetNumCells() != Distances.Num())
+        return;
+
+    const int32 Index = Occupancy.ToIndex(Cell);
+    if (SourceCounts[Index] == 0)
+        return;
+
+    Sources.RemoveSingleSwap(Cell, EAllowShrinking::No);
+    if (--SourceCounts[Index] == 0)
+    {
+        Repair(Occupancy, Index);
+    }
+}
+
+/**
+ * @brief Moves a source, e.g. when the enemy unit it stands for moves.
+ * @param Occupancy The blocked layer the field was computed over.
+ * @param From The source's old cell.
+ * @param To The source's new cell.
+ */
+void FGridDistanceField::MoveSource(const FGridOccupancy& Occupancy, const FIntPoint& From, const FIntPoint& To)
+{
+    if (From == To)
+        return;
+
+    AddSource(Occupancy, To);
+    RemoveSource(Occupancy, From);
+}
+
+/**
+ * @brief Steps from Cell to the nearest source.
+ *
+ * A blocked cell that is not a source (typically the asking unit's own cell) is one step beyond
+ * its nearest free neighbour.
+ *
+ * @param Occupancy The blocked layer the field was computed over.
+ * @param Cell The cell to look up.
+ * @return The step count, or INDEX_NONE if no source can be reached.
+ */
+int32 FGridDistanceField::GetDistance(const FGridOccupancy& Occupancy, const FIntPoint& Cell) const
+{
+    if (!Occupancy.IsValidCell(Cell) || Occupancy.GetNumCells() != Distances.Num())
+        return INDEX_NONE;
+
+    const int32 Index = Occupancy.ToIndex(Cell);
+    if (IsPassable(Occupancy, Index))
+        return (Distances[Index] == Unreachable) ? INDEX_NONE : Distances[Index];
+
+    int32 Best = Unreachable;
+    for (const FIntPoint& Offset : NeighbourOffsets)
+    {
+        const FIntPoint Next = Cell + Offset;
+        if (Occupancy.IsValidCell(Next))
+        {
+            Best = FMath::Min<int32>(Best, Distances[Occupancy.ToIndex(Next)]);
+        }
+    }
+
+    return (Best >= Unreachable - 1) ? INDEX_NONE : Best + 1;
+}
+
+/**
+ * @brief Sources always pass; other cells pass when they are neither blocked nor masked.
+ */
+bool FGridDistanceField::IsPassable(const FGridOccupancy& Occupancy, int32 Index) const
+{
+    return SourceCounts[Index] > 0 || (!Occupancy.IsBlocked(Occupancy.ToCell(Index)) && !IsMasked(Index));
+}
+
+/**
+ * @brief True if the mask given to Compute blocks the cell at Index.
+ */
+bool FGridDistanceField::IsMasked(int32 Index) const
+{
+    if (BlockedMask.IsEmpty())
+        return false;
+
+    const int32 X = Index % Width;
+    const int32 Y = Index / Width;
+    return (BlockedMask[Y * WordsPerRow + (X >> 6)] >> (X & 63)) & 1ull;
+}
+
+/**
+ * @brief Incremental update after the passability or source state of one cell changed.
+ *
+ * Raise: the changed cell is invalidated, then cells one step further out are checked in order of
+ * their old distance; a cell with no valid neighbour one step closer (and that is not a source)
+ * lost its shortest path and is invalidated too. Processing by old distance guarantees every
+ * closer cell has already been settled when a cell is checked.
+ *
+ * Lower: every invalidated cell and the changed cell take the best distance offered by their valid
+ * neighbours (zero for sources), and the improvements are relaxed outward with a min-heap. This
+ * also covers a cell that became free or a new source, which only lowers distances.
+ */
+void FGridDistanceField::Repair(const FGridOccupancy& Occupancy, int32 ChangedIndex)
+{
+    const int32 NumCells = Distances.Num();
+    if (InvalidStamp.Num() != NumCells)
+    {
+        InvalidStamp.SetNumUninitialized(NumCells, EAllowShrinking::No);
+        FMemory::Memzero(InvalidStamp.GetData(), NumCells * sizeof(uint32));
+        Generation = 0;
+    }
+
+    if (++Generation == 0)
+    {
+        FMemory::Memzero(InvalidStamp.GetData(), NumCells * sizeof(uint32));
+        Generation = 1;
+    }
+
+    Invalidated.Reset();
+    Heap.Reset();
+
+    // Raise
+    InvalidStamp[ChangedIndex] = Generation;
+    Invalidated.Add(ChangedIndex);
+    if (Distances[ChangedIndex] != Unreachable)
+    {
+        Heap.HeapPush(MakeHeapKey(Distances[ChangedIndex], ChangedIndex));
+    }
+
+    while (Heap.Num() > 0)
+    {
+        uint64 Key;
+        Heap.HeapPop(Key, EAllowShrinking::No);
+        const int32 Index = static_cast<int32>(Key & MAX_uint32);
+        const int32 OldDistance = static_cast<int32>(Key >> 32);
+        const FIntPoint Cell = Occupancy.ToCell(Index);
+
+        if (Index != ChangedIndex)
+        {
+            if (InvalidStamp[Index] == Generation)
+                continue;
+
+            bool bSupported = (SourceCounts[Index] > 0 && OldDistance == 0);
+            for (int32 Dir = 0; Dir < 4 && !bSupported; ++Dir)
+            {
+                const FIntPoint Next = Cell + NeighbourOffsets[Dir];
+                if (Occupancy.IsValidCell(Next))
+                {
+                    const int32 NextIndex = Occupancy.ToIndex(Next);
+                    bSupported = (InvalidStamp[NextIndex] != Generation && Distances[NextIndex] == OldDistance - 1);
+                }
+            }
+
+            if (bSupported)
+                continue;
+
+            InvalidStamp[Index] = Generation;
+            Invalidated.Add(Index);
+        }
+
+        for (const FIntPoint& Offset : NeighbourOffsets)
+        {
+            const FIntPoint Next = Cell + Offset;
+            if (!Occupancy.IsValidCell(Next))
+                continue;
+
+            const int32 NextIndex = Occupancy.ToIndex(Next);
+            if (InvalidStamp[NextIndex] != Generation && Distances[NextIndex] == OldDistance + 1)
+            {
+                Heap.HeapPush(MakeHeapKey(OldDistance + 1, NextIndex));
+            }
+        }
+    }
+
+    for (const int32 Index : Invalidated)
+    {
+        Distances[Index] = Unreachable;
+    }
+
+    // Lower
+    for (const int32 Index : Invalidated)
+    {
+        if (!IsPassable(Occupancy, Index))
+            continue;
+
+        int32 Best = Unreachable;
+        if (SourceCounts[Index] > 0)
+        {
+            Best = 0;
+        }
+        else
+        {
+            const FIntPoint Cell = Occupancy.ToCell(Index);
+            for (const FIntPoint& Offset : NeighbourOffsets)
+            {
+                const FIntPoint Next = Cell + Offset;
+                if (Occupancy.IsValidCell(Next))
+                {
+                    Best = FMath::Min<int32>(Best, Distances[Occupancy.ToIndex(Next)] + 1);
+                }
+            }
+        }
+
+        if (Best < Unreachable)
+        {
+            Distances[Index] = static_cast<int16>(Best);
+            Heap.HeapPush(MakeHeapKey(Best, Index));
+        }
+    }
+
+    LastNumRepaired = Invalidated.Num();
+
+    while (Heap.Num() > 0)
+    {
+        uint64 Key;
+        Heap.HeapPop(Key, EAllowShrinking::No);
+        const int32 Index = static_cast<int32>(Key & MAX_uint32);
+        const int32 Distance = static_cast<int32>(Key >> 32);
+        if (Distance != Distances[Index] || Distance + 1 >= Unreachable)
+            continue;
+
+        const FIntPoint Cell = Occupancy.ToCell(Index);
+        for (const FIntPoint& Offset : NeighbourOffsets)
+        {
+            const FIntPoint Next = Cell + Offset;
+            if (!Occupancy.IsValidCell(Next))
+                continue;
+
+            const int32 NextIndex = Occupancy.ToIndex(Next);
+            if (Distance + 1 < Distances[NextIndex] && IsPassable(Occupancy, NextIndex))
+            {
+                Distances[NextIndex] = static_cast<int16>(Distance + 1);
+                Heap.HeapPush(MakeHeapKey(Distance + 1, NextIndex));
+                ++LastNumRepaired;
+            }
+        }
+    }
+}
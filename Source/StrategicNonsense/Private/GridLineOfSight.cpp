@@ -0,0 +1,164 @@
+#include "GridLineOfSight.h"
+#include "GridOccupancy.h"
+
+static_assert((FGridLineOfSight::NumSlots & (FGridLineOfSight::NumSlots - 1)) == 0 && FGridLineOfSight::NumSlots == (1 << 10), "GetSlot keeps the top 10 bits of the hash");
+
+/**
+ * @brief Sets the radius covered by each cached visibility set and empties the cache.
+ * @param InCachedRange Longest distance (in Manhattan steps) answered from the cache.
+ */
+void FGridLineOfSight::SetCachedRange(int32 InCachedRange)
+{
+    CachedRange = FMath::Max(InCachedRange, 0);
+    SlotWordsPerRow = (2 * CachedRange + 1 + 63) / 64;
+
+    SlotSources.Init(FIntPoint::NoneValue, NumSlots);
+    SlotBits.SetNumZeroed(NumSlots * (2 * CachedRange + 1) * SlotWordsPerRow);
+}
+
+/**
+ * @brief Whether a shot from the centre of From reaches the centre of To.
+ * @param Blockers Layer whose blocked cells stop sight.
+ * @param From The shooter's cell.
+ * @param To The target's cell.
+ * @return true if no blocker lies between the two cells; false if either cell is off the grid.
+ */
+bool FGridLineOfSight::HasLineOfSight(const FGridOccupancy& Blockers, const FIntPoint& From, const FIntPoint& To)
+{
+    if (!Blockers.IsValidCell(From) || !Blockers.IsValidCell(To))
+        return false;
+
+    if (From == To)
+        return true;
+
+    const FIntPoint Offset = To - From;
+    if (FMath::Abs(Offset.X) + FMath::Abs(Offset.Y) > CachedRange)
+        return TraceLine(Blockers, From, To);
+
+    const int32 Slot = GetSlot(Blockers.ToIndex(From));
+    if (SlotSources[Slot] != From)
+    {
+        BuildSlot(Blockers, Slot, From);
+        ++NumMisses;
+    }
+    else
+    {
+        ++NumHits;
+    }
+
+    const int32 BoxX = Offset.X + CachedRange;
+    const int32 BoxY = Offset.Y + CachedRange;
+    const int32 SlotWords = (2 * CachedRange + 1) * SlotWordsPerRow;
+    return (SlotBits[Slot * SlotWords + BoxY * SlotWordsPerRow + (BoxX >> 6)] >> (BoxX & 63)) & 1ull;
+}
+
+/**
+ * @brief Drops every cached set whose lines could pass through a cell whose blocker state changed.
+ * @param Cell The cell that started or stopped blocking sight.
+ */
+void FGridLineOfSight::InvalidateCell(const FIntPoint& Cell)
+{
+    for (FIntPoint& Source : SlotSources)
+    {
+        if (Source != FIntPoint::NoneValue && FMath::Abs(Cell.X - Source.X) + FMath::Abs(Cell.Y - Source.Y) <= CachedRange)
+        {
+            Source = FIntPoint::NoneValue;
+        }
+    }
+}
+
+/**
+ * @brief Drops every cached set; used when the grid or its obstacle layout is regenerated.
+ */
+void FGridLineOfSight::InvalidateAll()
+{
+    for (FIntPoint& Source : SlotSources)
+    {
+        Source = FIntPoint::NoneValue;
+    }
+}
+
+/**
+ * @brief Walks the supercover of the segment between two cell centres.
+ *
+ * Steps one cell at a time along whichever axis the segment crosses first; when it crosses both
+ * at once (an exact corner) it steps diagonally and checks the two cells beside the corner. The
+ * end cells themselves never block.
+ *
+ * @param Blockers Layer whose blocked cells stop sight.
+ * @param From The shooter's cell (must be valid).
+ * @param To The target's cell (must be valid).
+ * @return true if the line is clear.
+ */
+bool FGridLineOfSight::TraceLine(const FGridOccupancy& Blockers, const FIntPoint& From, const FIntPoint& To)
+{
+    const int32 NumX = FMath::Abs(To.X - From.X);
+    const int32 NumY = FMath::Abs(To.Y - From.Y);
+    const int32 StepX = (To.X > From.X) ? 1 : -1;
+    const int32 StepY = (To.Y > From.Y) ? 1 : -1;
+
+    FIntPoint Cell = From;
+    int32 IndexX = 0;
+    int32 IndexY = 0;
+
+    while (IndexX < NumX || IndexY < NumY)
+    {
+        // Compares where the segment crosses the next vertical and horizontal cell edges
+        const int32 Decision = (1 + 2 * IndexX) * NumY - (1 + 2 * IndexY) * NumX;
+        if (Decision == 0)
+        {
+            if (Blockers.IsBlocked(FIntPoint(Cell.X + StepX, Cell.Y)) && Blockers.IsBlocked(FIntPoint(Cell.X, Cell.Y + StepY)))
+                return false;
+
+            Cell.X += StepX;
+            Cell.Y += StepY;
+            ++IndexX;
+            ++IndexY;
+        }
+        else if (Decision < 0)
+        {
+            Cell.X += StepX;
+            ++IndexX;
+        }
+        else
+        {
+            Cell.Y += StepY;
+            ++IndexY;
+        }
+
+        if (Cell != To && Blockers.IsBlocked(Cell))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Fills a slot with the visibility of every cell within CachedRange of Source.
+ */
+void FGridLineOfSight::BuildSlot(const FGridOccupancy& Blockers, int32 Slot, const FIntPoint& Source)
+{
+    const int32 SlotWords = (2 * CachedRange + 1) * SlotWordsPerRow;
+    uint64* Bits = SlotBits.GetData() + Slot * SlotWords;
+    FMemory::Memzero(Bits, SlotWords * sizeof(uint64));
+
+    for (int32 DY = -CachedRange; DY <= CachedRange; ++DY)
+    {
+        const int32 SpanX = CachedRange - FMath::Abs(DY);
+        for (int32 DX = -SpanX; DX <= SpanX; ++DX)
+        {
+            const FIntPoint Target = Source + FIntPoint(DX, DY);
+            if (!Blockers.IsValidCell(Target))
+                continue;
+
+            // Neighbours share an edge, so nothing can stand between them
+            if ((FMath::Abs(DX) + FMath::Abs(DY) <= 1) || TraceLine(Blockers, Source, Target))
+            {
+                const int32 BoxX = DX + CachedRange;
+                Bits[(DY + CachedRange) * SlotWordsPerRow + (BoxX >> 6)] |= 1ull << (BoxX & 63);
+            }
+        }
+    }
+
+    SlotSources[Slot] = Source;
+}
@@ -1,42 +1,210 @@
 #include "GridManager.h"
+#include "StrategicNonsense.h"
 #include "SniperUnit.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
 #include "Containers/Array.h"
 #include "DrawDebugHelpers.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "UObject/ConstructorHelpers.h"
+#include "GridObstacleLayout.h"
+#include "Obstacle.h"
+#include "Math/RandomStream.h"
+#include "BattleActorPool.h"
+
+DECLARE_CYCLE_STAT(TEXT("GenerateGrid"), STAT_SNGenerateGrid, STATGROUP_StrategicNonsense);
+DECLARE_CYCLE_STAT(TEXT("PlaceObstacles"), STAT_SNPlaceObstacles, STATGROUP_StrategicNonsense);
+DECLARE_DWORD_COUNTER_STAT(TEXT("BFS nodes expanded"), STAT_SNBFSNodesExpanded, STATGROUP_StrategicNonsense);
+TRACE_DECLARE_INT_COUNTER(SNBFSNodesExpanded, TEXT("StrategicNonsense/BFS nodes expanded"));
+
+namespace
+{
+    // Per-instance custom data layout for instanced grid cells
+    constexpr int32 CellDataHighlight = 0;
+    constexpr int32 CellDataColourR = 1;
+    constexpr int32 CellDataNumFloats = 4;
+
+    // Reachability expansions visit each reachable cell once, so the result size is the node count
+    void CountNodesExpanded(int32 NumNodes)
+    {
+        INC_DWORD_STAT_BY(STAT_SNBFSNodesExpanded, NumNodes);
+        TRACE_COUNTER_ADD(SNBFSNodesExpanded, NumNodes);
+    }
+}
 
 /**
  * @brief Constructor for the grid manager.
  *
- * Disables ticking and attempts to load required blueprints for grid cells and obstacles.
+ * Disables ticking, creates the instanced cell component, and attempts to load
+ * required blueprints for grid cells and obstacles.
  */
 AGridManager::AGridManager()
 {
     PrimaryActorTick.bCanEverTick = false;
+
+    CellInstances = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(TEXT("CellInstances"));
+    RootComponent = CellInstances;
+    CellInstances->NumCustomDataFloats = CellDataNumFloats;
+    CellInstances->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+    CellInstances->SetCollisionResponseToAllChannels(ECR_Block);
+    CellInstances->SetCastShadow(false);
+
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> PlaneMesh(TEXT("/Engine/BasicShapes/Plane.Plane"));
+    if (PlaneMesh.Succeeded()) CellMesh = PlaneMesh.Object;
+
     SetBlueprints();
 }
 
 /**
  * @brief Called when the game starts.
+ *
+ * Allocates the occupancy layer unless the grid has already been generated.
  */
 void AGridManager::BeginPlay()
 {
     Super::BeginPlay();
+
+    if (Occupancy.GetNumCells() == 0)
+    {
+        Occupancy.Initialise(GridSizeX, GridSizeY);
+    }
 }
 
 /**
- * @brief Generates a 2D grid of cell actors based on size and spacing parameters.
+ * @brief Generates the visual grid and (re)allocates the occupancy layer to match the grid size.
  *
- * Cells are placed in a folder named "Grid" for organisation.
+ * Grids above InstancedCellThreshold cells are drawn through a single instanced mesh component;
+ * smaller grids spawn one cell actor per cell as before. Regenerating returns the previous
+ * match's cells, obstacles and units to the actor pool first.
  */
 void AGridManager::GenerateGrid()
 {
-    if (!CellBlueprint)
+    TRACE_CPUPROFILER_EVENT_SCOPE(AGridManager::GenerateGrid);
+    SCOPE_CYCLE_COUNTER(STAT_SNGenerateGrid);
+
+    ReleaseMatchActors();
+
+    Occupancy.Initialise(GridSizeX, GridSizeY);
+    ReachabilityCache.InvalidateAll();
+    RecomputeDistanceFields();
+    SightBlockers.Initialise(GridSizeX, GridSizeY);
+    LineOfSight.SetCachedRange(LineOfSightCacheRange);
+    PlacedUnits.Reset();
+    UnitRegistry.Initialise(GridSizeX, GridSizeY);
+
+    const int32 NumCells = GridSizeX * GridSizeY;
+    bInstancedCellsActive = InstancedCellThreshold <= 0 || NumCells > InstancedCellThreshold;
+
+    if (bInstancedCellsActive)
+    {
+        GenerateInstancedCells();
+    }
+    else
+    {
+        GenerateCellActors();
+    }
+}
+
+/**
+ * @brief Returns every cell, obstacle and unit actor this grid spawned to the actor pool.
+ */
+void AGridManager::ReleaseMatchActors()
+{
+    for (AUnitActor* Unit : PlacedUnits)
     {
-        UE_LOG(LogTemp, Error, TEXT("CellBlueprint is null"));
+        if (Unit)
+        {
+            Unit->UnbindFromRegistry();
+        }
+    }
+
+    UBattleActorPool* Pool = UBattleActorPool::Get(this);
+    if (!Pool)
         return;
+
+    for (AActor* Cell : CellActors)
+    {
+        Pool->Release(Cell);
+    }
+    for (AActor* Obstacle : ObstacleActors)
+    {
+        Pool->Release(Obstacle);
+    }
+    for (AUnitActor* Unit : PlacedUnits)
+    {
+        Pool->Release(Unit);
     }
 
+    CellActors.Reset();
+    ObstacleActors.Reset();
+    PlacedUnits.Reset();
+}
+
+/**
+ * @brief Adds one mesh instance per cell to the instanced cell component.
+ *
+ * Instances are added in row-major order, so an instance index equals the cell's occupancy index.
+ * Custom data starts with no highlight and a white colour.
+ */
+void AGridManager::GenerateInstancedCells()
+{
+    if (!CellInstances || !CellMesh)
+    {
+        UE_LOG(LogSNGrid, Error, TEXT("CellMesh is null - cannot draw instanced grid"));
+        bInstancedCellsActive = false;
+        return;
+    }
+
+    CellInstances->ClearInstances();
+    CellInstances->SetStaticMesh(CellMesh);
+    if (CellMaterial)
+    {
+        CellInstances->SetMaterial(0, CellMaterial);
+    }
+
+    const float MeshScale = (CellSize / 100.0f) * InstancedCellScale;
+    const float GroundHeightOffset = 0.0f;
+
+    TArray<FTransform> Transforms;
+    Transforms.Reserve(GridSizeX * GridSizeY);
+
+    for (int32 Y = 0; Y < GridSizeY; ++Y)
+    {
+        for (int32 X = 0; X < GridSizeX; ++X)
+        {
+            const FVector Location((X + 0.5f) * CellSize, (Y + 0.5f) * CellSize, GroundHeightOffset);
+            Transforms.Emplace(FRotator::ZeroRotator, Location, FVector(MeshScale, MeshScale, 1.0f));
+        }
+    }
+
+    CellInstances->AddInstances(Transforms, /*bShouldReturnIndices*/ false, /*bWorldSpace*/ true);
+
+    const TArray<float> DefaultData = { 0.0f, 1.0f, 1.0f, 1.0f };
+    for (int32 Index = 0; Index < Transforms.Num(); ++Index)
+    {
+        CellInstances->SetCustomData(Index, DefaultData, false);
+    }
+    CellInstances->MarkRenderStateDirty();
+}
+
+/**
+ * @brief Takes one cell blueprint actor per cell from the actor pool.
+ *
+ * Cells are placed in a folder named "Grid" for organisation.
+ */
+void AGridManager::GenerateCellActors()
+{
+    UBattleActorPool* Pool = UBattleActorPool::Get(this);
+    if (!CellBlueprint || !Pool)
+    {
+        UE_LOG(LogSNGrid, Error, TEXT("CellBlueprint or actor pool is null"));
+        return;
+    }
+
+    CellActors.Reserve(GridSizeX * GridSizeY);
+
     float GroundHeightOffset = 0.0f;
 
     for (int32 X = 0; X < GridSizeX; ++X)
@@ -49,15 +217,16 @@ void AGridManager::GenerateGrid()
                 GroundHeightOffset
             );
 
-            AActor* NewCell = GetWorld()->SpawnActor<AActor>(CellBlueprint, Location, FRotator::ZeroRotator);
+            AActor* NewCell = Pool->Acquire<AActor>(CellBlueprint, FTransform(FRotator::ZeroRotator, Location));
 
             if (NewCell)
             {
+                CellActors.Add(NewCell);
                 NewCell->SetFolderPath(FName("Grid"));
             }
             else
             {
-                UE_LOG(LogTemp, Error, TEXT("Failed to spawn cell at X=%d Y=%d"), X, Y);
+                UE_LOG(LogSNGrid, Error, TEXT("Failed to spawn cell at X=%d Y=%d"), X, Y);
             }
         }
     }
@@ -77,11 +246,11 @@ void AGridManager::SetBlueprints()
 
     if (!GridManagerClass)
     {
-        UE_LOG(LogTemp, Error, TEXT("FAILED to load GridManagerClass from path: %s"), *GridManagerPath);
+        UE_LOG(LogSNGrid, Error, TEXT("FAILED to load GridManagerClass from path: %s"), *GridManagerPath);
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("Successfully loaded GridManagerClass!"));
+        UE_LOG(LogSNGrid, Verbose, TEXT("Successfully loaded GridManagerClass!"));
     }
 
     if (CellBP.Succeeded()) CellBlueprint = CellBP.Class;
@@ -94,113 +263,57 @@ void AGridManager::SetBlueprints()
  * @brief Randomly places obstacles on the grid based on a configured percentage.
  *
  * Ensures obstacle shapes (e.g., mountains) dont isolate sections of the grid.
+ *
+ * Obstacle actors come from the actor pool, so a regenerated grid reuses the previous layout's actors.
+ *
+ * @param Stream The match's map stream; the same stream state always gives the same layout and textures.
  */
-void AGridManager::PlaceObstacles()
+void AGridManager::PlaceObstacles(FRandomStream& Stream)
 {
-    if (!BP_Mountain && !BP_Tree1 && !BP_Tree2) return;
-
-    int32 TotalCells = GridSizeX * GridSizeY;
-    int32 NumObstacles = FMath::RoundToInt(TotalCells * (ObstaclePercentage / 100.0f));
+    TRACE_CPUPROFILER_EVENT_SCOPE(AGridManager::PlaceObstacles);
+    SCOPE_CYCLE_COUNTER(STAT_SNPlaceObstacles);
 
-    TArray<TSubclassOf<AActor>> ObstacleTypes = { BP_Mountain, BP_Tree1, BP_Tree2 };
+    UBattleActorPool* Pool = UBattleActorPool::Get(this);
+    if ((!BP_Mountain && !BP_Tree1 && !BP_Tree2) || !Pool) return;
 
-    TMap<TSubclassOf<AActor>, FIntPoint> ObstacleSizes;
-    ObstacleSizes.Add(BP_Mountain, FIntPoint(8, 8));
-    ObstacleSizes.Add(BP_Tree1, FIntPoint(1, 1));
-    ObstacleSizes.Add(BP_Tree2, FIntPoint(1, 1));
-
-    TArray<FIntPoint> MountainShape = {
-    {1, 0}, {2, 0}, {3, 1},
-    {1, 1}, {2, 1}, {3, 1}, {4, 1}, {5, 1}, {6, 1},
-    {1, 2}, {2, 2}, {3, 2}, {4, 2}, {5, 2}, {6, 2},
-    {0, 3}, {1, 3}, {2, 3}, {3, 3}, {4, 3}, {5, 3}, {6, 3}, {7, 3},
-    {1, 4}, {2, 4}, {3, 4}, {4, 4}, {5, 4}, {6, 4}, {7, 4},
-    {1, 5}, {2, 5}, {3, 5}, {4, 5}, {5, 5}, {6, 5},
-    {2, 6}, {3, 6}, {4, 6}, {5, 6}, {6, 6},
-    {3, 7}, {4, 7}, {5, 7}
-    };
+    TArray<FGridObstacle> Obstacles;
+    FGridObstacleLayout::Generate(Occupancy, Connectivity, ObstaclePercentage, Stream, Obstacles);
+    ReachabilityCache.InvalidateAll();
+    RecomputeDistanceFields();
+    RebuildSightBlockers();
 
+    const TSubclassOf<AActor> ObstacleClasses[] = { BP_Mountain, BP_Tree1, BP_Tree2 };
+    static_assert(UE_ARRAY_COUNT(ObstacleClasses) == static_cast<int32>(EGridObstacleType::Count), "Missing class for an obstacle type");
 
     float GroundHeightOffset = 50.0f;
 
-    while (OccupiedCells.Num() < NumObstacles)
+    for (const FGridObstacle& Obstacle : Obstacles)
     {
-        TSubclassOf<AActor> ChosenObstacle = ObstacleTypes[FMath::RandRange(0, ObstacleTypes.Num() - 1)];
-        FIntPoint ObstacleSize = ObstacleSizes[ChosenObstacle];
-
-        // Estimate how many cells it would occupy
-        int32 EstimatedNewCells = (ChosenObstacle == BP_Mountain)
-            ? MountainShape.Num()
-            : ObstacleSize.X * ObstacleSize.Y;
-
-        int32 MaxOccupiedCells = FMath::RoundToInt(GridSizeX * GridSizeY * (ObstaclePercentage / 100.0f));
-        if (OccupiedCells.Num() + EstimatedNewCells > MaxOccupiedCells)
-        {
-            // Replace with small tree to avoid overshooting
-            TArray<TSubclassOf<AActor>> TreeOptions = { BP_Tree1, BP_Tree2 };
-            ChosenObstacle = TreeOptions[FMath::RandRange(0, TreeOptions.Num() - 1)];
-            ObstacleSize = ObstacleSizes[ChosenObstacle];
-        }
-
-        int32 OriginX = FMath::RandRange(0, GridSizeX - ObstacleSize.X);
-        int32 OriginY = FMath::RandRange(0, GridSizeY - ObstacleSize.Y);
-        FIntPoint OriginCell(OriginX, OriginY);
-
-        bool CanPlace = true;
-        TArray<FIntPoint> CellsToOccupy;
-
-        if (ChosenObstacle == BP_Mountain)
-        {
-            for (const FIntPoint& Offset : MountainShape)
-            {
-                FIntPoint TestCell = OriginCell + Offset;
-                if (!IsCellValid(TestCell) || OccupiedCells.Contains(TestCell))
-                {
-                    CanPlace = false;
-                    break;
-                }
-                CellsToOccupy.Add(TestCell);
-            }
-        }
-        else
-        {
-            for (int32 i = 0; i < ObstacleSize.X; ++i)
-            {
-                for (int32 j = 0; j < ObstacleSize.Y; ++j)
-                {
-                    FIntPoint TestCell(OriginX + i, OriginY + j);
-                    if (OccupiedCells.Contains(TestCell))
-                    {
-                        CanPlace = false;
-                        break;
-                    }
-                    CellsToOccupy.Add(TestCell);
-                }
-                if (!CanPlace) break;
-            }
-        }
-
-        if (!CanPlace || WouldBlockConnectivity(CellsToOccupy)) continue;
-
         FVector SpawnLocation = FVector(
-            (OriginX + ObstacleSize.X / 2.0f) * CellSize,
-            (OriginY + ObstacleSize.Y / 2.0f) * CellSize,
+            (Obstacle.Origin.X + Obstacle.Size.X / 2.0f) * CellSize,
+            (Obstacle.Origin.Y + Obstacle.Size.Y / 2.0f) * CellSize,
             GroundHeightOffset
         );
 
         FRotator SpawnRotation(0, 0, 90);
-        AActor* SpawnedObstacle = GetWorld()->SpawnActor<AActor>(ChosenObstacle, SpawnLocation, SpawnRotation);
+        // The texture seed is set before BeginPlay (or the pool's reactivation) picks the texture
+        const int32 TextureSeed = static_cast<int32>(Stream.GetUnsignedInt());
+        AActor* SpawnedObstacle = Pool->Acquire(ObstacleClasses[static_cast<int32>(Obstacle.Type)], FTransform(SpawnRotation, SpawnLocation),
+            [TextureSeed](AActor* Actor)
+            {
+                if (AObstacle* TexturedObstacle = Cast<AObstacle>(Actor))
+                {
+                    TexturedObstacle->SetTextureSeed(TextureSeed);
+                }
+            });
 
         if (SpawnedObstacle)
         {
+            ObstacleActors.Add(SpawnedObstacle);
             SpawnedObstacle->SetFolderPath(FName("Obstacle"));
-            for (const FIntPoint& Cell : CellsToOccupy)
-            {
-                OccupiedCells.Add(Cell);
-            }
 
-            UE_LOG(LogTemp, Warning, TEXT("Spawned obstacle at Grid (%d, %d) -> World (%f, %f)"),
-                OriginX, OriginY, SpawnLocation.X, SpawnLocation.Y);
+            UE_LOG(LogSNGrid, VeryVerbose, TEXT("Spawned obstacle at Grid (%d, %d) -> World (%f, %f)"),
+                Obstacle.Origin.X, Obstacle.Origin.Y, SpawnLocation.X, SpawnLocation.Y);
         }
     }
 }
@@ -218,21 +331,22 @@ void AGridManager::PlaceObstacles()
 bool AGridManager::TryPlaceUnitAtLocation(const FVector& ClickLocation, TSubclassOf<AUnitActor> UnitToPlace)
 {
     FIntPoint GridCoord = WorldToGrid(ClickLocation);
-    if (!IsCellValid(GridCoord) || OccupiedCells.Contains(GridCoord))
+    if (!IsCellValid(GridCoord) || Occupancy.IsBlocked(GridCoord))
         return false;
 
     FVector SpawnLocation = GridToWorld(GridCoord);
     FRotator Rotation = FRotator(0.f, 0.f, 90.f);
 
-    AUnitActor* NewUnit = GetWorld()->SpawnActor<AUnitActor>(UnitToPlace, SpawnLocation, Rotation);
+    UBattleActorPool* Pool = UBattleActorPool::Get(this);
+    AUnitActor* NewUnit = Pool ? Pool->Acquire<AUnitActor>(UnitToPlace, FTransform(Rotation, SpawnLocation)) : nullptr;
     if (!NewUnit)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to spawn unit at (%d, %d)"), GridCoord.X, GridCoord.Y);
+        UE_LOG(LogSNGrid, Error, TEXT("Failed to spawn unit at (%d, %d)"), GridCoord.X, GridCoord.Y);
         return false;
     }
 
     // Mark the cell as used
-    OccupiedCells.Add(GridCoord);
+    BlockCell(GridCoord, NewUnit);
     NewUnit->SetGridPosition(GridCoord);
 
     // Scale the unit based on cell size
@@ -243,7 +357,7 @@ bool AGridManager::TryPlaceUnitAtLocation(const FVector& ClickLocation, TSubclas
     // Folder for organisation
     NewUnit->SetFolderPath(FName("Units"));
 
-    UE_LOG(LogTemp, Warning, TEXT("Spawned and scaled %s at (%d, %d)"), *NewUnit->GetName(), GridCoord.X, GridCoord.Y);
+    UE_LOG(LogSNGrid, Verbose, TEXT("Spawned and scaled %s at (%d, %d)"), *NewUnit->GetName(), GridCoord.X, GridCoord.Y);
     return true;
 }
 
@@ -254,7 +368,126 @@ bool AGridManager::TryPlaceUnitAtLocation(const FVector& ClickLocation, TSubclas
  */
 bool AGridManager::IsCellValid(const FIntPoint& Cell) const
 {
-    return Cell.X >= 0 && Cell.X < GridSizeX && Cell.Y >= 0 && Cell.Y < GridSizeY;
+    return Occupancy.IsValidCell(Cell);
+}
+
+/**
+ * @brief Marks a cell as blocked in the occupancy layer and records the unit standing on it.
+ * @param Cell The grid coordinate (must be valid).
+ * @param Unit The unit occupying the cell, or nullptr for obstacles.
+ */
+void AGridManager::BlockCell(const FIntPoint& Cell, AUnitActor* Unit)
+{
+    SetCellBlocked(Cell, true);
+    Occupancy.SetUnitIndex(Cell, Unit ? RegisterUnit(Unit, Cell) : INDEX_NONE);
+}
+
+/**
+ * @brief Moves a registered unit to a cell, or registers a newly placed one there.
+ * @param Unit The unit standing on the cell.
+ * @param Cell The grid coordinate (must be valid).
+ * @return The unit's ID in UnitRegistry and PlacedUnits.
+ */
+int32 AGridManager::RegisterUnit(AUnitActor* Unit, const FIntPoint& Cell)
+{
+    const int32 ExistingId = Unit->GetRegistryId();
+    if (PlacedUnits.IsValidIndex(ExistingId) && PlacedUnits[ExistingId] == Unit)
+    {
+        UnitRegistry.SetCell(ExistingId, Cell);
+        return ExistingId;
+    }
+
+    const int32 UnitId = UnitRegistry.AddUnit(Unit->GetArchetype(), Cell);
+    PlacedUnits.Add(Unit);
+    check(PlacedUnits.Num() == UnitRegistry.Num());
+
+    Unit->BindToRegistry(&UnitRegistry, UnitId);
+    return UnitId;
+}
+
+/**
+ * @brief Clears the turn flags of a team's units in the registry, then mirrors them onto the living units' actors.
+ * @param Team 0 or 1.
+ */
+void AGridManager::ResetTeamForNewTurn(uint8 Team)
+{
+    UnitRegistry.ResetTeamForNewTurn(Team);
+    for (int32 UnitId : UnitRegistry.GetTeamUnits(Team))
+    {
+        if (UnitRegistry.IsAlive(UnitId) && PlacedUnits[UnitId])
+        {
+            PlacedUnits[UnitId]->SyncFlagsFromRegistry();
+        }
+    }
+}
+
+/**
+ * @brief Sets a cell's blocked bit, invalidating cached reachability only if the bit actually changes.
+ * @param Cell The grid coordinate (must be valid).
+ * @param bBlocked True to block the cell, false to free it.
+ */
+void AGridManager::SetCellBlocked(const FIntPoint& Cell, bool bBlocked)
+{
+    if (Occupancy.IsBlocked(Cell) == bBlocked)
+        return;
+
+    Occupancy.SetBlocked(Cell, bBlocked);
+    ReachabilityCache.InvalidateCell(Cell);
+
+    for (int32 Index = TrackedDistanceFields.Num() - 1; Index >= 0; --Index)
+    {
+        if (const TSharedPtr<FGridDistanceField> Field = TrackedDistanceFields[Index].Pin())
+        {
+            Field->OnCellChanged(Occupancy, Cell);
+        }
+        else
+        {
+            TrackedDistanceFields.RemoveAtSwap(Index);
+        }
+    }
+}
+
+/**
+ * @brief Copies the obstacle cells (blocked cells without a unit) into the sight layer and drops cached visibility.
+ */
+void AGridManager::RebuildSightBlockers()
+{
+    SightBlockers.Initialise(Occupancy.GetWidth(), Occupancy.GetHeight());
+    for (int32 Y = 0; Y < Occupancy.GetHeight(); ++Y)
+    {
+        for (int32 X = 0; X < Occupancy.GetWidth(); ++X)
+        {
+            const FIntPoint Cell(X, Y);
+            if (Occupancy.IsBlocked(Cell) && Occupancy.GetUnitIndex(Cell) == INDEX_NONE)
+            {
+                SightBlockers.SetBlocked(Cell, true);
+            }
+        }
+    }
+
+    if (LineOfSight.GetCachedRange() != LineOfSightCacheRange)
+    {
+        LineOfSight.SetCachedRange(LineOfSightCacheRange);
+    }
+    LineOfSight.InvalidateAll();
+}
+
+/**
+ * @brief Rebuilds every live distance field after a bulk occupancy change (new grid or obstacle layout).
+ */
+void AGridManager::RecomputeDistanceFields()
+{
+    for (int32 Index = TrackedDistanceFields.Num() - 1; Index >= 0; --Index)
+    {
+        if (const TSharedPtr<FGridDistanceField> Field = TrackedDistanceFields[Index].Pin())
+        {
+            Field->Recompute(Occupancy);
+        }
+        else
+        {
+            TrackedDistanceFields.RemoveAtSwap(Index);
+        }
+    }
 }
 
 /**
@@ -286,27 +519,18 @@ FVector AGridManager::GridToWorld(const FIntPoint& Cell) const
 /**
  * @brief Retrieves a random valid, unoccupied grid cell.
  * @param OutLocation The world-space location of the chosen cell.
+ * @param Stream The stream the cell is drawn from.
  * @return true if a valid location was found; false otherwise.
  */
-bool AGridManager::GetRandomValidPlacementLocation(FVector& OutLocation)
+bool AGridManager::GetRandomValidPlacementLocation(FVector& OutLocation, FRandomStream& Stream)
 {
     TArray<FIntPoint> FreeCells;
-
-    for (int32 X = 0; X < GridSizeX; ++X)
-    {
-        for (int32 Y = 0; Y < GridSizeY; ++Y)
-        {
-            FIntPoint Cell(X, Y);
-            if (!OccupiedCells.Contains(Cell))
-            {
-                FreeCells.Add(Cell);
-            }
-        }
-    }
+    FreeCells.Reserve(Occupancy.GetNumFree());
+    Occupancy.ForEachFreeCell([&FreeCells](const FIntPoint& Cell) { FreeCells.Add(Cell); });
 
     if (FreeCells.IsEmpty()) return false;
 
-    int32 Index = FMath::RandRange(0, FreeCells.Num() - 1);
+    int32 Index = Stream.RandRange(0, FreeCells.Num() - 1);
     FIntPoint Chosen = FreeCells[Index];
     OutLocation = GridToWorld(Chosen);
     return true;
@@ -322,7 +546,7 @@ bool AGridManager::IsCellWalkable(const FIntPoint& Cell) const
     if (!IsCellValid(Cell))
         return false;
 
-    return !OccupiedCells.Contains(Cell);
+    return !Occupancy.IsBlocked(Cell);
 }
 
 /**
@@ -340,63 +564,285 @@ void AGridManager::SetUnitAtCell(const FIntPoint& Cell, AUnitActor* Unit)
 
     if (Unit)
     {
-        OccupiedCells.Add(Cell);
-        UE_LOG(LogTemp, Warning, TEXT("Set unit at cell (%d, %d)"), Cell.X, Cell.Y);
+        BlockCell(Cell, Unit);
+        UE_LOG(LogSNGrid, VeryVerbose, TEXT("Set unit at cell (%d, %d)"), Cell.X, Cell.Y);
     }
     else
     {
-        OccupiedCells.Remove(Cell);
-        UE_LOG(LogTemp, Warning, TEXT("Cleared unit at cell (%d, %d)"), Cell.X, Cell.Y);
+        SetCellBlocked(Cell, false);
+        Occupancy.SetUnitIndex(Cell, INDEX_NONE);
+        UnitRegistry.ClearCell(Cell);
+        UE_LOG(LogSNGrid, VeryVerbose, TEXT("Cleared unit at cell (%d, %d)"), Cell.X, Cell.Y);
+    }
+}
+
+/**
+ * @brief Looks up the unit standing on a cell via the unit registry's cell-to-unit index.
+ * @param Cell The grid coordinate.
+ * @return The unit on the cell, or nullptr if the cell is empty, an obstacle, or out of bounds.
+ */
+AUnitActor* AGridManager::GetUnitAtCell(const FIntPoint& Cell) const
+{
+    return GetRegisteredUnit(UnitRegistry.GetUnitAt(Cell));
+}
+
+/**
+ * @brief Sets the highlight intensity of an instanced cell (e.g. for movement range display).
+ *
+ * Has no effect when the grid is drawn with cell actors.
+ *
+ * @param Cell The grid coordinate.
+ * @param Highlight Highlight intensity passed to the cell material (0 = none).
+ */
+void AGridManager::SetCellHighlight(const FIntPoint& Cell, float Highlight)
+{
+    if (!bInstancedCellsActive || !IsCellValid(Cell))
+        return;
+
+    CellInstances->SetCustomDataValue(Occupancy.ToIndex(Cell), CellDataHighlight, Highlight, true);
+}
+
+/**
+ * @brief Sets the tint colour of an instanced cell.
+ *
+ * Has no effect when the grid is drawn with cell actors.
+ *
+ * @param Cell The grid coordinate.
+ * @param Colour The tint passed to the cell material.
+ */
+void AGridManager::SetCellColour(const FIntPoint& Cell, const FLinearColor& Colour)
+{
+    if (!bInstancedCellsActive || !IsCellValid(Cell))
+        return;
+
+    const int32 Index = Occupancy.ToIndex(Cell);
+    CellInstances->SetCustomDataValue(Index, CellDataColourR, Colour.R, false);
+    CellInstances->SetCustomDataValue(Index, CellDataColourR + 1, Colour.G, false);
+    CellInstances->SetCustomDataValue(Index, CellDataColourR + 2, Colour.B, true);
+}
+
+/**
+ * @brief Removes the highlight from every instanced cell in a single render state update.
+ */
+void AGridManager::ClearCellHighlights()
+{
+    if (!bInstancedCellsActive)
+        return;
+
+    const int32 NumCells = Occupancy.GetNumCells();
+    for (int32 Index = 0; Index < NumCells; ++Index)
+    {
+        CellInstances->SetCustomDataValue(Index, CellDataHighlight, 0.0f, false);
     }
+    CellInstances->MarkRenderStateDirty();
 }
 
 /**
  * @brief Performs a breadth-first search (BFS) to find all cells reachable from a starting cell within a range.
+ *
+ * Convenience wrapper over GetReachableCells for callers that want a set; only the returned set allocates.
+ *
  * @param StartCell The starting grid coordinate.
  * @param MaxRange Maximum movement range.
  * @return Set of reachable grid cells.
  */
 TSet<FIntPoint> AGridManager::FindReachableCellsBFS(FIntPoint StartCell, int32 MaxRange) const
 {
-    TSet<FIntPoint> Visited;
-    TQueue<TPair<FIntPoint, int32>> Frontier;
+    TSet<FIntPoint> Reachable;
+    Reachable.Append(GetReachableCells(StartCell, MaxRange));
+    return Reachable;
+}
 
-    Visited.Add(StartCell);
-    Frontier.Enqueue(TPair<FIntPoint, int32>(StartCell, 0));
+/**
+ * @brief Finds the cells reachable within a range without allocating, writing them to a caller-provided span.
+ * @param StartCell The starting grid coordinate.
+ * @param MaxRange Maximum movement range.
+ * @param OutCells Receives the reachable cells nearest first; GetMaxReachableCells entries always suffice.
+ * @return The number of reachable cells, which may exceed OutCells.Num().
+ */
+int32 AGridManager::FindReachableCells(const FIntPoint& StartCell, int32 MaxRange, TArrayView<FIntPoint> OutCells) const
+{
+    const int32 NumReachable = Bitboard.FindReachableCells(Occupancy, StartCell, MaxRange, OutCells);
+    CountNodesExpanded(NumReachable);
+    return NumReachable;
+}
 
-    const TArray<FIntPoint> Directions = {
-        FIntPoint(1, 0),
-        FIntPoint(-1, 0),
-        FIntPoint(0, 1),
-        FIntPoint(0, -1)
-    };
+/**
+ * @brief Finds the cells reachable within a range without allocating, marking them in a caller-provided bitmask.
+ * @param StartCell The starting grid coordinate.
+ * @param MaxRange Maximum movement range.
+ * @param OutMask Row-padded bitmask with as many words as the occupancy layer; cleared first.
+ * @return The number of reachable cells.
+ */
+int32 AGridManager::FindReachableMask(const FIntPoint& StartCell, int32 MaxRange, TArrayView<uint64> OutMask) const
+{
+    const int32 NumReachable = Bitboard.FindReachableMask(Occupancy, StartCell, MaxRange, OutMask);
+    CountNodesExpanded(NumReachable);
+    return NumReachable;
+}
 
-    while (!Frontier.IsEmpty())
+/**
+ * @brief Cached reachable cells for a unit standing on StartCell.
+ *
+ * Repeated queries for the same cell and range are lookups until a cell within MaxRange steps of
+ * StartCell changes. The view is invalidated by the next reachability query or occupancy change.
+ *
+ * @param StartCell The starting grid coordinate.
+ * @param MaxRange Maximum movement range.
+ * @return The reachable cells, nearest first, excluding StartCell.
+ */
+TConstArrayView<FIntPoint> AGridManager::GetReachableCells(const FIntPoint& StartCell, int32 MaxRange) const
+{
+    const uint64 NumMisses = ReachabilityCache.GetNumMisses();
+    TConstArrayView<FIntPoint> Cells = ReachabilityCache.GetReachableCells(Occupancy, StartCell, MaxRange);
+    if (ReachabilityCache.GetNumMisses() != NumMisses)
     {
-        TPair<FIntPoint, int32> Current;
-        Frontier.Dequeue(Current);
+        CountNodesExpanded(Cells.Num());
+    }
+    return Cells;
+}
 
-        FIntPoint Cell = Current.Key;
-        int32 Distance = Current.Value;
+/**
+ * @brief Cached number of steps from StartCell to Cell within a movement range.
+ * @param StartCell The starting grid coordinate.
+ * @param MaxRange Maximum movement range.
+ * @param Cell The cell to look up.
+ * @return The step count, or INDEX_NONE if Cell cannot be reached within MaxRange.
+ */
+int32 AGridManager::GetReachableDistance(const FIntPoint& StartCell, int32 MaxRange, const FIntPoint& Cell) const
+{
+    return ReachabilityCache.GetDistance(Occupancy, StartCell, MaxRange, Cell);
+}
+
+/**
+ * @brief Finds a shortest route between two cells with A*.
+ *
+ * Unlike FindReachableCellsBFS this returns the actual steps, so callers can animate movement
+ * along them or plan routes longer than one turn's range.
+ *
+ * @param StartCell The cell to path from; may hold the moving unit itself.
+ * @param GoalCell The cell to path to; must be free.
+ * @param MaxCost Longest route accepted, in steps.
+ * @param OutPath Receives the cells from the first step to GoalCell inclusive.
+ * @return true if GoalCell can be reached within MaxCost steps.
+ */
+bool AGridManager::FindPath(const FIntPoint& StartCell, const FIntPoint& GoalCell, int32 MaxCost, TArray<FIntPoint>& OutPath) const
+{
+    return Pathfinder.FindPath(Occupancy, StartCell, GoalCell, MaxCost, OutPath);
+}
+
+/**
+ * @brief Whether a shot from From to To clears every obstacle, answered from the cached visibility sets.
+ *
+ * Only obstacles block sight, not units. Lines within LineOfSightCacheRange are one bit read once
+ * the source cell's set has been built; the sets are dropped whenever the obstacle layout changes.
+ *
+ * @param From The shooter's cell.
+ * @param To The target's cell.
+ * @return true if the line between the cell centres is clear.
+ */
+bool AGridManager::HasLineOfSight(const FIntPoint& From, const FIntPoint& To) const
+{
+    return LineOfSight.HasLineOfSight(SightBlockers, From, To);
+}
+
+/**
+ * @brief Full attack check: the target cell is within the attacker's range and, for attack types
+ *        listed in LineOfSightAttackTypes, visible from the attacking cell.
+ * @param Attacker The attacking unit.
+ * @param From The cell the attacker would attack from (its own cell or a planned destination).
+ * @param TargetCell The cell of the unit being attacked.
+ * @return true if the attack is allowed.
+ */
+bool AGridManager::CanAttackFrom(const AUnitActor* Attacker, const FIntPoint& From, const FIntPoint& TargetCell) const
+{
+    const int32 Distance = FMath::Abs(From.X - TargetCell.X) + FMath::Abs(From.Y - TargetCell.Y);
+    if (Distance > Attacker->GetAttackRange())
+        return false;
+
+    return !RequiresLineOfSight(Attacker->GetAttackType()) || HasLineOfSight(From, TargetCell);
+}
+
+/**
+ * @brief Steps from every cell to the nearest of Sources, as one multi-source BFS.
+ *
+ * Compute it once per turn (e.g. with every enemy unit as a source) and share it between all AI
+ * units instead of pathfinding from each unit to each target. The grid keeps the field in sync
+ * while the caller holds the reference: cells becoming blocked or free are repaired incrementally,
+ * and when a source unit moves the caller reports it with MoveSource.
+ *
+ * @param Sources Cells at distance zero; they may be occupied (e.g. by the enemy units themselves).
+ * @param Blocked Optional cells to treat as blocked on top of the occupancy, laid out like
+ *                GetOccupancy().GetBlockedWords(); they stay blocked for the field's lifetime.
+ * @return The field; dropping the last reference stops the updates.
+ */
+TSharedRef<FGridDistanceField> AGridManager::ComputeDistanceField(TConstArrayView<FIntPoint> Sources, TConstArrayView<uint64> Blocked)
+{
+    TSharedRef<FGridDistanceField> Field = MakeShared<FGridDistanceField>();
+    Field->Compute(Occupancy, Sources, Blocked);
+    TrackedDistanceFields.Add(Field);
+    return Field;
+}
+
+/**
+ * @brief Steps from every cell to the nearest cell from which one of Targets is within AttackRange.
+ *
+ * Sources are the cells CanAttackFrom accepts for a target: within AttackRange (Manhattan) and,
+ * if AttackType needs line of sight, visible from the target. Obstacles and the targets' own cells
+ * are excluded. Cells held by units stay sources, so a unit already in range reads zero on its own
+ * cell. Only obstacles block sight, so unit moves never invalidate the sources.
+ *
+ * @param Targets Cells of the units to attack.
+ * @param AttackRange Attack range of the unit(s) the field is for.
+ * @param AttackType Attack type of the unit(s) the field is for.
+ * @param Blocked Optional extra blocked cells, as for ComputeDistanceField.
+ * @return The field; tracked like ComputeDistanceField.
+ */
+TSharedRef<FGridDistanceField> AGridManager::ComputeAttackPositionField(TConstArrayView<FIntPoint> Targets, int32 AttackRange, EAttackType AttackType, TConstArrayView<uint64> Blocked)
+{
+    const bool bNeedsSight = RequiresLineOfSight(AttackType);
 
-        if (Distance >= MaxRange)
-            continue;
+    // Targets' own cells are marked up front so they never become sources
+    TBitArray<> Seen(false, Occupancy.GetNumCells());
+    for (const FIntPoint& Target : Targets)
+    {
+        if (Occupancy.IsValidCell(Target))
+        {
+            Seen[Occupancy.ToIndex(Target)] = true;
+        }
+    }
 
-        for (const FIntPoint& Dir : Directions)
+    TArray<FIntPoint> Sources;
+    for (const FIntPoint& Target : Targets)
+    {
+        for (int32 DY = -AttackRange; DY <= AttackRange; ++DY)
         {
-            FIntPoint Neighbor = Cell + Dir;
+            const int32 SpanX = AttackRange - FMath::Abs(DY);
+            for (int32 DX = -SpanX; DX <= SpanX; ++DX)
+            {
+                const FIntPoint Cell = Target + FIntPoint(DX, DY);
+                if (!Occupancy.IsValidCell(Cell) || Seen[Occupancy.ToIndex(Cell)])
+                    continue;
+
+                // A cell hidden from this target may still see another one, so it is not marked yet
+                if (bNeedsSight && !HasLineOfSight(Cell, Target))
+                    continue;
+
+                Seen[Occupancy.ToIndex(Cell)] = true;
+
+                // Blocked without a unit means an obstacle, which nothing can stand on
+                if (Occupancy.IsBlocked(Cell) && Occupancy.GetUnitIndex(Cell) == INDEX_NONE)
+                    continue;
 
-            if (!IsCellValid(Neighbor)) continue;
-            if (OccupiedCells.Contains(Neighbor)) continue;
-            if (Visited.Contains(Neighbor)) continue;
+                if (!Blocked.IsEmpty() && ((Blocked[Cell.Y * Occupancy.GetWordsPerRow() + (Cell.X >> 6)] >> (Cell.X & 63)) & 1ull))
+                    continue;
 
-            Visited.Add(Neighbor);
-            Frontier.Enqueue(TPair<FIntPoint, int32>(Neighbor, Distance + 1));
+                Sources.Add(Cell);
+            }
         }
     }
 
-    Visited.Remove(StartCell); // Optional: don't count standing cell
-    return Visited;
+    return ComputeDistanceField(Sources, Blocked);
 }
 
 /**
@@ -410,20 +856,21 @@ TSet<FIntPoint> AGridManager::FindReachableCellsBFS(FIntPoint StartCell, int32 M
  */
 AUnitActor* AGridManager::SpawnAndPlaceUnit(const FIntPoint& GridCoord, TSubclassOf<AUnitActor> UnitClass)
 {
-    if (!IsCellValid(GridCoord) || OccupiedCells.Contains(GridCoord))
+    if (!IsCellValid(GridCoord) || Occupancy.IsBlocked(GridCoord))
         return nullptr;
 
     FVector SpawnLocation = GridToWorld(GridCoord);
     FRotator Rotation = FRotator(0.f, 0.f, 90.f);
 
-    AUnitActor* NewUnit = GetWorld()->SpawnActor<AUnitActor>(UnitClass, SpawnLocation, Rotation);
+    UBattleActorPool* Pool = UBattleActorPool::Get(this);
+    AUnitActor* NewUnit = Pool ? Pool->Acquire<AUnitActor>(UnitClass, FTransform(Rotation, SpawnLocation)) : nullptr;
     if (!NewUnit)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to spawn unit at (%d, %d)"), GridCoord.X, GridCoord.Y);
+        UE_LOG(LogSNGrid, Error, TEXT("Failed to spawn unit at (%d, %d)"), GridCoord.X, GridCoord.Y);
         return nullptr;
     }
 
-    OccupiedCells.Add(GridCoord);
+    BlockCell(GridCoord, NewUnit);
     NewUnit->SetGridPosition(GridCoord);
 
     float PaddingFactor = NewUnit->IsA(ASniperUnit::StaticClass()) ? 0.1f : 0.15f;
@@ -432,70 +879,6 @@ AUnitActor* AGridManager::SpawnAndPlaceUnit(const FIntPoint& GridCoord, TSubclas
 
     NewUnit->SetFolderPath(FName("Units"));
 
-    UE_LOG(LogTemp, Warning, TEXT("Spawned and placed %s at (%d, %d)"), *NewUnit->GetName(), GridCoord.X, GridCoord.Y);
+    UE_LOG(LogSNGrid, Verbose, TEXT("Spawned and placed %s at (%d, %d)"), *NewUnit->GetName(), GridCoord.X, GridCoord.Y);
     return NewUnit;
 }
-
-/**
- * @brief Simulates a proposed obstacle placement to check whether it would break grid connectivity.
- *
- * Uses a BFS to ensure that all remaining free cells are still connected.
- *
- * @param ProposedObstacle The list of cells the new obstacle would occupy.
- * @return true if the placement would block connectivity; false otherwise.
- */
-bool AGridManager::WouldBlockConnectivity(const TArray<FIntPoint>& ProposedObstacle)
-{
-    TSet<FIntPoint> SimulatedOccupied = OccupiedCells;
-    for (const FIntPoint& Cell : ProposedObstacle)
-    {
-        SimulatedOccupied.Add(Cell);
-    }
-
-    // Find a valid start cell
-    FIntPoint Start(-1, -1);
-    for (int32 X = 0; X < GridSizeX && Start.X == -1; ++X)
-    {
-        for (int32 Y = 0; Y < GridSizeY; ++Y)
-        {
-            FIntPoint Cell(X, Y);
-            if (!SimulatedOccupied.Contains(Cell))
-            {
-                Start = Cell;
-                break;
-            }
-        }
-    }
-
-    if (Start.X == -1) return true; // No free cells left
-
-    // Run BFS
-    TSet<FIntPoint> Visited;
-    TQueue<FIntPoint> Queue;
-    Queue.Enqueue(Start);
-    Visited.Add(Start);
-
-    const TArray<FIntPoint> Directions = {
-        FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1)
-    };
-
-    while (!Queue.IsEmpty())
-    {
-        FIntPoint Current;
-        Queue.Dequeue(Current);
-
-        for (const FIntPoint& Dir : Directions)
-        {
-            FIntPoint Neighbour = Current + Dir;
-            if (!IsCellValid(Neighbour)) continue;
-            if (SimulatedOccupied.Contains(Neighbour)) continue;
-            if (Visited.Contains(Neighbour)) continue;
-
-            Visited.Add(Neighbour);
-            Queue.Enqueue(Neighbour);
-        }
-    }
-
-    int32 TotalFreeCells = GridSizeX * GridSizeY - SimulatedOccupied.Num();
-    return Visited.Num() != TotalFreeCells; // true = connectivity broken
-}
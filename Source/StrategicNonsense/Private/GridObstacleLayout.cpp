@@ -0,0 +1,130 @@
+#include "GridObstacleLayout.h"
+#include "GridOccupancy.h"
+#include "GridConnectivity.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+    const FIntPoint GMountainShape[] = {
+        {1, 0}, {2, 0},
+        {1, 1}, {2, 1}, {3, 1}, {4, 1}, {5, 1}, {6, 1},
+        {1, 2}, {2, 2}, {3, 2}, {4, 2}, {5, 2}, {6, 2},
+        {0, 3}, {1, 3}, {2, 3}, {3, 3}, {4, 3}, {5, 3}, {6, 3}, {7, 3},
+        {1, 4}, {2, 4}, {3, 4}, {4, 4}, {5, 4}, {6, 4}, {7, 4},
+        {1, 5}, {2, 5}, {3, 5}, {4, 5}, {5, 5}, {6, 5},
+        {2, 6}, {3, 6}, {4, 6}, {5, 6}, {6, 6},
+        {3, 7}, {4, 7}, {5, 7}
+    };
+
+    // Random origins tried per cell before giving up on reaching the target density
+    constexpr int32 MaxAttemptsPerCell = 64;
+}
+
+/**
+ * @brief Randomly places obstacles until the requested share of cells is blocked.
+ *
+ * Each attempt picks a kind and a random origin; mountains fall back to a tree when they would
+ * overshoot the target. Placements that overlap blocked cells or would disconnect the free
+ * region are rejected. Gives up after a bounded number of attempts, which only matters for
+ * densities the connectivity rule cannot reach.
+ *
+ * @param Occupancy The occupancy layer; placed cells are marked blocked.
+ * @param Connectivity Checker used to keep the free region connected.
+ * @param ObstaclePercentage Target share of blocked cells, 0-100.
+ * @param Stream Random source; the same seed and grid give the same layout.
+ * @param OutObstacles Receives every obstacle placed, in placement order.
+ */
+void FGridObstacleLayout::Generate(FGridOccupancy& Occupancy, FGridConnectivity& Connectivity, float ObstaclePercentage,
+    FRandomStream& Stream, TArray<FGridObstacle>& OutObstacles)
+{
+    OutObstacles.Reset();
+
+    const int32 GridSizeX = Occupancy.GetWidth();
+    const int32 GridSizeY = Occupancy.GetHeight();
+    const int32 NumObstacles = FMath::RoundToInt(Occupancy.GetNumCells() * (ObstaclePercentage / 100.0f));
+    const int32 MountainCells = UE_ARRAY_COUNT(GMountainShape);
+
+    TArray<FIntPoint> CellsToOccupy;
+    int64 AttemptsLeft = static_cast<int64>(Occupancy.GetNumCells()) * MaxAttemptsPerCell;
+
+    while (Occupancy.GetNumBlocked() < NumObstacles && AttemptsLeft-- > 0)
+    {
+        EGridObstacleType Type = static_cast<EGridObstacleType>(Stream.RandRange(0, static_cast<int32>(EGridObstacleType::Count) - 1));
+        FIntPoint Size = GetSize(Type);
+
+        // Estimate how many cells it would occupy
+        const int32 EstimatedNewCells = (Type == EGridObstacleType::Mountain) ? MountainCells : Size.X * Size.Y;
+        if (Occupancy.GetNumBlocked() + EstimatedNewCells > NumObstacles)
+        {
+            // Replace with small tree to avoid overshooting
+            Type = Stream.RandBool() ? EGridObstacleType::Tree1 : EGridObstacleType::Tree2;
+            Size = GetSize(Type);
+        }
+
+        if (Size.X > GridSizeX || Size.Y > GridSizeY)
+            continue;
+
+        const FIntPoint Origin(Stream.RandRange(0, GridSizeX - Size.X), Stream.RandRange(0, GridSizeY - Size.Y));
+
+        bool bCanPlace = true;
+        CellsToOccupy.Reset();
+
+        if (Type == EGridObstacleType::Mountain)
+        {
+            for (const FIntPoint& Offset : GMountainShape)
+            {
+                const FIntPoint TestCell = Origin + Offset;
+                if (!Occupancy.IsValidCell(TestCell) || Occupancy.IsBlocked(TestCell))
+                {
+                    bCanPlace = false;
+                    break;
+                }
+                CellsToOccupy.Add(TestCell);
+            }
+        }
+        else
+        {
+            for (int32 i = 0; i < Size.X && bCanPlace; ++i)
+            {
+                for (int32 j = 0; j < Size.Y; ++j)
+                {
+                    const FIntPoint TestCell(Origin.X + i, Origin.Y + j);
+                    if (Occupancy.IsBlocked(TestCell))
+                    {
+                        bCanPlace = false;
+                        break;
+                    }
+                    CellsToOccupy.Add(TestCell);
+                }
+            }
+        }
+
+        if (!bCanPlace || Connectivity.WouldDisconnect(Occupancy, CellsToOccupy))
+            continue;
+
+        for (const FIntPoint& Cell : CellsToOccupy)
+        {
+            Occupancy.SetBlocked(Cell, true);
+        }
+
+        OutObstacles.Add({ Type, Origin, Size });
+    }
+}
+
+/**
+ * @brief Bounding box of an obstacle kind, in cells.
+ * @param Type The obstacle kind.
+ * @return Width and height in cells.
+ */
+FIntPoint FGridObstacleLayout::GetSize(EGridObstacleType Type)
+{
+    return (Type == EGridObstacleType::Mountain) ? FIntPoint(8, 8) : FIntPoint(1, 1);
+}
+
+/**
+ * @brief Cells covered by a mountain, relative to its origin.
+ */
+TConstArrayView<FIntPoint> FGridObstacleLayout::GetMountainShape()
+{
+    return MakeArrayView(GMountainShape);
+}
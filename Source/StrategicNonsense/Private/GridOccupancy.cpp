@@ -0,0 +1,67 @@
+#include "GridOccupancy.h"
+
+/**
+ * @brief Allocates the occupancy layer for a grid of the given size and clears it.
+ * @param InWidth Number of cells along X.
+ * @param InHeight Number of cells along Y.
+ */
+void FGridOccupancy::Initialise(int32 InWidth, int32 InHeight)
+{
+    Width = FMath::Max(InWidth, 0);
+    Height = FMath::Max(InHeight, 0);
+    WordsPerRow = (Width + 63) / 64;
+
+    BlockedWords.SetNumUninitialized(WordsPerRow * Height);
+    CellUnits.SetNumUninitialized(Width * Height);
+    Reset();
+}
+
+/**
+ * @brief Marks every cell as free and clears all unit indices.
+ */
+void FGridOccupancy::Reset()
+{
+    FMemory::Memzero(BlockedWords.GetData(), BlockedWords.Num() * sizeof(uint64));
+    for (int16& UnitIndex : CellUnits)
+    {
+        UnitIndex = INDEX_NONE;
+    }
+    NumBlocked = 0;
+}
+
+/**
+ * @brief Sets or clears the blocked bit for a cell, keeping the blocked count in sync.
+ * @param Cell The grid coordinate (must be valid).
+ * @param bBlocked True to block the cell, false to free it.
+ */
+void FGridOccupancy::SetBlocked(const FIntPoint& Cell, bool bBlocked)
+{
+    uint64& Word = BlockedWords[Cell.Y * WordsPerRow + (Cell.X >> 6)];
+    const uint64 Mask = 1ull << (Cell.X & 63);
+    const bool bWasBlocked = (Word & Mask) != 0;
+
+    if (bBlocked == bWasBlocked)
+        return;
+
+    if (bBlocked)
+    {
+        Word |= Mask;
+        ++NumBlocked;
+    }
+    else
+    {
+        Word &= ~Mask;
+        --NumBlocked;
+    }
+}
+
+/**
+ * @brief Records which unit (by index) stands on a cell.
+ * @param Cell The grid coordinate (must be valid).
+ * @param UnitIndex Index of the unit, or INDEX_NONE to clear.
+ */
+void FGridOccupancy::SetUnitIndex(const FIntPoint& Cell, int32 UnitIndex)
+{
+    check(UnitIndex >= INDEX_NONE && UnitIndex <= MAX_int16);
+    CellUnits[ToIndex(Cell)] = static_cast<int16>(UnitIndex);
+}
@@ -0,0 +1,126 @@
+#include "GridPathfinder.h"
+#include "GridOccupancy.h"
+#include "Algo/Reverse.h"
+
+namespace
+{
+    const FIntPoint GPathDirections[] = {
+        FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1)
+    };
+
+    int32 GetManhattanDistance(const FIntPoint& A, const FIntPoint& B)
+    {
+        return FMath::Abs(A.X - B.X) + FMath::Abs(A.Y - B.Y);
+    }
+}
+
+/**
+ * @brief Finds a shortest 4-connected path between two cells.
+ *
+ * The start cell may be blocked (it is usually the moving unit's own cell); every other cell on
+ * the path, including the goal, must be free. Nodes whose cost plus remaining distance exceeds
+ * MaxCost are never opened, so a tight budget also bounds the work done.
+ *
+ * @param Occupancy The occupancy layer.
+ * @param Start The cell to path from.
+ * @param Goal The cell to path to.
+ * @param MaxCost Longest path accepted, in steps.
+ * @param OutPath Receives the cells from the first step to Goal inclusive; empty when Start == Goal or no path exists.
+ * @return true if Goal is reachable within MaxCost steps.
+ */
+bool FGridPathfinder::FindPath(const FGridOccupancy& Occupancy, const FIntPoint& Start, const FIntPoint& Goal, int32 MaxCost, TArray<FIntPoint>& OutPath)
+{
+    OutPath.Reset();
+    LastNumExpanded = 0;
+
+    if (!Occupancy.IsValidCell(Start) || !Occupancy.IsValidCell(Goal))
+        return false;
+
+    if (Start == Goal)
+        return true;
+
+    if (Occupancy.IsBlocked(Goal) || GetManhattanDistance(Start, Goal) > MaxCost)
+        return false;
+
+    PrepareScratch(Occupancy.GetNumCells());
+    ++Generation;
+
+    const int32 StartIndex = Occupancy.ToIndex(Start);
+    const int32 GoalIndex = Occupancy.ToIndex(Goal);
+
+    Cells[StartIndex] = { Generation, 0, 0, INDEX_NONE };
+
+    Open.Reset();
+    Open.HeapPush({ MakePriority(GetManhattanDistance(Start, Goal), 0), StartIndex });
+
+    bool bFound = false;
+
+    while (!Open.IsEmpty())
+    {
+        FOpenNode Current;
+        Open.HeapPop(Current, EAllowShrinking::No);
+
+        // Stale entry left behind by a cheaper route to the same cell
+        FCellRecord& CurrentRecord = Cells[Current.Index];
+        if (CurrentRecord.ClosedStamp == Generation)
+            continue;
+
+        if (Current.Index == GoalIndex)
+        {
+            bFound = true;
+            break;
+        }
+
+        CurrentRecord.ClosedStamp = Generation;
+        ++LastNumExpanded;
+
+        const FIntPoint Cell = Occupancy.ToCell(Current.Index);
+        const int32 NextCost = CurrentRecord.Cost + 1;
+
+        for (const FIntPoint& Dir : GPathDirections)
+        {
+            const FIntPoint Neighbour = Cell + Dir;
+            if (!Occupancy.IsValidCell(Neighbour) || Occupancy.IsBlocked(Neighbour)) continue;
+
+            const int32 NeighbourIndex = Occupancy.ToIndex(Neighbour);
+            FCellRecord& Record = Cells[NeighbourIndex];
+            if (Record.ClosedStamp == Generation) continue;
+            if (Record.SeenStamp == Generation && Record.Cost <= NextCost) continue;
+
+            const int32 F = NextCost + GetManhattanDistance(Neighbour, Goal);
+            if (F > MaxCost) continue;
+
+            Record.SeenStamp = Generation;
+            Record.Cost = NextCost;
+            Record.Parent = Current.Index;
+            Open.HeapPush({ MakePriority(F, NextCost), NeighbourIndex });
+        }
+    }
+
+    if (!bFound)
+        return false;
+
+    // Walk the parents back from the goal, then flip into travel order
+    OutPath.Reserve(Cells[GoalIndex].Cost);
+    for (int32 Index = GoalIndex; Index != StartIndex; Index = Cells[Index].Parent)
+    {
+        OutPath.Add(Occupancy.ToCell(Index));
+    }
+    Algo::Reverse(OutPath);
+
+    return true;
+}
+
+/**
+ * @brief Sizes the stamped cell records to cover the grid; resets stamps when they would wrap.
+ * @param NumCells Number of cells in the grid.
+ */
+void FGridPathfinder::PrepareScratch(int32 NumCells)
+{
+    if (Cells.Num() != NumCells || Generation == MAX_uint32)
+    {
+        Cells.Reset();
+        Cells.SetNumZeroed(NumCells);
+        Generation = 0;
+    }
+}
@@ -0,0 +1,175 @@
+#include "GridReachability.h"
+#include "GridOccupancy.h"
+
+namespace
+{
+    const FIntPoint GReachDirections[] = {
+        FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1)
+    };
+}
+
+/**
+ * @brief Writes the cells reachable within MaxRange steps into a caller-provided span.
+ *
+ * Cells are written in BFS order (nearest first). If the span is too small the extra cells are
+ * counted but not written; a span of GetMaxReachableCells entries is always large enough.
+ *
+ * @param Occupancy The occupancy layer; blocked cells (obstacles and units) stop movement.
+ * @param Start The cell to search from.
+ * @param MaxRange Maximum number of steps.
+ * @param OutCells Receives the reachable cells, excluding Start.
+ * @return The number of reachable cells, which may exceed OutCells.Num().
+ */
+int32 FGridReachability::FindReachableCells(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, TArrayView<FIntPoint> OutCells)
+{
+    int32 NumWritten = 0;
+    return Search(Occupancy, Start, MaxRange, [&OutCells, &NumWritten](const FIntPoint& Cell, int32 Distance)
+    {
+        if (NumWritten < OutCells.Num())
+        {
+            OutCells[NumWritten++] = Cell;
+        }
+    });
+}
+
+/**
+ * @brief Same as the span overload, also writing each cell's step count to a parallel span.
+ * @param OutDistances Receives the distance of OutCells[i] at index i; must be at least as long as OutCells.
+ */
+int32 FGridReachability::FindReachableCells(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, TArrayView<FIntPoint> OutCells, TArrayView<uint16> OutDistances)
+{
+    check(OutDistances.Num() >= OutCells.Num() && MaxRange <= MAX_uint16);
+
+    int32 NumWritten = 0;
+    return Search(Occupancy, Start, MaxRange, [&OutCells, &OutDistances, &NumWritten](const FIntPoint& Cell, int32 Distance)
+    {
+        if (NumWritten < OutCells.Num())
+        {
+            OutDistances[NumWritten] = static_cast<uint16>(Distance);
+            OutCells[NumWritten++] = Cell;
+        }
+    });
+}
+
+/**
+ * @brief Sets one bit per cell reachable within MaxRange steps.
+ *
+ * The mask uses the occupancy layer's layout (Occupancy.GetWordsPerRow() words per row, bit X & 63
+ * of word X >> 6) and must hold at least as many words as Occupancy.GetBlockedWords(). It is
+ * cleared first, so it can be reused between queries.
+ *
+ * @param Occupancy The occupancy layer; blocked cells (obstacles and units) stop movement.
+ * @param Start The cell to search from.
+ * @param MaxRange Maximum number of steps.
+ * @param OutMask Receives the reachable cells, excluding Start.
+ * @return The number of reachable cells.
+ */
+int32 FGridReachability::FindReachableMask(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, TArrayView<uint64> OutMask)
+{
+    check(OutMask.Num() >= Occupancy.GetBlockedWords().Num());
+    FMemory::Memzero(OutMask.GetData(), OutMask.Num() * sizeof(uint64));
+
+    const int32 WordsPerRow = Occupancy.GetWordsPerRow();
+    return Search(Occupancy, Start, MaxRange, [&OutMask, WordsPerRow](const FIntPoint& Cell, int32 Distance)
+    {
+        OutMask[Cell.Y * WordsPerRow + (Cell.X >> 6)] |= 1ull << (Cell.X & 63);
+    });
+}
+
+/**
+ * @brief Runs the BFS and calls Visitor(Cell, Distance) once per reachable cell, nearest first.
+ * @return The number of cells visited, excluding Start.
+ */
+template <typename VisitorType>
+int32 FGridReachability::Search(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, VisitorType&& Visitor)
+{
+    if (MaxRange <= 0 || !Occupancy.IsValidCell(Start))
+        return 0;
+
+    PrepareScratch(Occupancy.GetNumCells(), MaxRange);
+    ++Generation;
+
+    uint32 QueueMask = static_cast<uint32>(Queue.Num() - 1);
+    uint32 Head = 0;
+    uint32 Tail = 0;
+
+    VisitStamp[Occupancy.ToIndex(Start)] = Generation;
+    Queue[Tail++ & QueueMask] = { Start, 0 };
+
+    int32 NumReached = 0;
+
+    while (Head != Tail)
+    {
+        const FQueueEntry Current = Queue[Head++ & QueueMask];
+        if (Current.Distance >= MaxRange)
+            continue;
+
+        for (const FIntPoint& Dir : GReachDirections)
+        {
+            const FIntPoint Neighbour = Current.Cell + Dir;
+            if (!Occupancy.IsValidCell(Neighbour) || Occupancy.IsBlocked(Neighbour)) continue;
+
+            const int32 NeighbourIndex = Occupancy.ToIndex(Neighbour);
+            if (VisitStamp[NeighbourIndex] == Generation) continue;
+
+            VisitStamp[NeighbourIndex] = Generation;
+
+            if (Tail - Head > QueueMask)
+            {
+                GrowQueue(Head, Tail);
+                QueueMask = static_cast<uint32>(Queue.Num() - 1);
+            }
+
+            Queue[Tail++ & QueueMask] = { Neighbour, Current.Distance + 1 };
+            Visitor(Neighbour, Current.Distance + 1);
+            ++NumReached;
+        }
+    }
+
+    return NumReached;
+}
+
+/**
+ * @brief Sizes the visit stamps to the grid and the ring buffer to the range; resets stamps when they would wrap.
+ * @param NumCells Number of cells in the grid.
+ * @param MaxRange Range of the coming query.
+ */
+void FGridReachability::PrepareScratch(int32 NumCells, int32 MaxRange)
+{
+    if (VisitStamp.Num() != NumCells || Generation == MAX_uint32)
+    {
+        VisitStamp.Reset();
+        VisitStamp.SetNumZeroed(NumCells);
+        Generation = 0;
+    }
+
+    // On open ground two consecutive distance layers hold at most 4d + 4(d + 1) cells
+    const int64 MaxFrontier = FMath::Min<int64>(8 * static_cast<int64>(MaxRange) + 4, NumCells);
+    const int32 Capacity = static_cast<int32>(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(MaxFrontier)));
+    if (Queue.Num() < Capacity)
+    {
+        Queue.SetNumUninitialized(Capacity);
+    }
+}
+
+/**
+ * @brief Doubles the ring buffer, unwrapping the live entries to the front.
+ * @param Head Read position; reset to 0.
+ * @param Tail Write position; reset to the number of live entries.
+ */
+void FGridReachability::GrowQueue(uint32& Head, uint32& Tail)
+{
+    const uint32 OldMask = static_cast<uint32>(Queue.Num() - 1);
+    const uint32 Count = Tail - Head;
+
+    TArray<FQueueEntry> Grown;
+    Grown.SetNumUninitialized(Queue.Num() * 2);
+    for (uint32 Offset = 0; Offset < Count; ++Offset)
+    {
+        Grown[Offset] = Queue[(Head + Offset) & OldMask];
+    }
+
+    Queue = MoveTemp(Grown);
+    Head = 0;
+    Tail = Count;
+}
@@ -0,0 +1,130 @@
+#include "GridReachabilityCache.h"
+#include "StrategicNonsense.h"
+#include "GridOccupancy.h"
+
+DECLARE_CYCLE_STAT(TEXT("Reachability BFS (cache miss)"), STAT_SNReachabilityBFS, STATGROUP_StrategicNonsense);
+
+/**
+ * @brief Cells reachable from Start within MaxRange steps, nearest first, excluding Start.
+ *
+ * The view stays valid until the next call on this cache.
+ *
+ * @param Occupancy The occupancy layer the cache is kept in sync with.
+ * @param Start The cell to search from.
+ * @param MaxRange Maximum number of steps.
+ * @return The cached cells.
+ */
+TConstArrayView<FIntPoint> FGridReachabilityCache::GetReachableCells(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange)
+{
+    return FindOrBuild(Occupancy, Start, MaxRange).Cells;
+}
+
+/**
+ * @brief Number of steps from Start to Cell, if Cell is reachable within MaxRange.
+ * @param Occupancy The occupancy layer the cache is kept in sync with.
+ * @param Start The cell to search from.
+ * @param MaxRange Maximum number of steps.
+ * @param Cell The cell to look up.
+ * @return The step count (0 for Start itself), or INDEX_NONE if Cell cannot be reached within MaxRange.
+ */
+int32 FGridReachabilityCache::GetDistance(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, const FIntPoint& Cell)
+{
+    const FEntry& Entry = FindOrBuild(Occupancy, Start, MaxRange);
+
+    const FIntPoint Local = Cell - Entry.BoxMin;
+    if (Local.X < 0 || Local.Y < 0 || Local.X >= Entry.BoxSize.X || Local.Y >= Entry.BoxSize.Y)
+        return INDEX_NONE;
+
+    const uint16 Distance = Entry.DistanceField[Local.Y * Entry.BoxSize.X + Local.X];
+    return (Distance == Unreachable) ? INDEX_NONE : Distance;
+}
+
+/**
+ * @brief Drops every entry whose search could pass through a cell whose blocked state changed.
+ * @param Cell The cell that became blocked or free.
+ */
+void FGridReachabilityCache::InvalidateCell(const FIntPoint& Cell)
+{
+    for (FEntry& Entry : Entries)
+    {
+        if (Entry.bValid && FMath::Abs(Cell.X - Entry.Start.X) + FMath::Abs(Cell.Y - Entry.Start.Y) <= Entry.MaxRange)
+        {
+            Entry.bValid = false;
+        }
+    }
+}
+
+/**
+ * @brief Drops every entry; used when the grid is regenerated or many cells change at once.
+ */
+void FGridReachabilityCache::InvalidateAll()
+{
+    for (FEntry& Entry : Entries)
+    {
+        Entry.bValid = false;
+    }
+}
+
+/**
+ * @brief Returns the entry for a query, running the BFS into the least recently used slot on a miss.
+ */
+FGridReachabilityCache::FEntry& FGridReachabilityCache::FindOrBuild(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange)
+{
+    MaxRange = FMath::Clamp(MaxRange, 0, static_cast<int32>(Unreachable) - 1);
+
+    FEntry* Victim = &Entries[0];
+    for (FEntry& Entry : Entries)
+    {
+        if (Entry.bValid && Entry.Start == Start && Entry.MaxRange == MaxRange)
+        {
+            Entry.LastUsed = ++UseCounter;
+            ++NumHits;
+            return Entry;
+        }
+
+        if (!Entry.bValid ? Victim->bValid : (Victim->bValid && Entry.LastUsed < Victim->LastUsed))
+        {
+            Victim = &Entry;
+        }
+    }
+
+    ++NumMisses;
+
+    // Hits are lookups; only the search behind a miss is worth timing
+    TRACE_CPUPROFILER_EVENT_SCOPE(FGridReachabilityCache::FindOrBuild);
+    SCOPE_CYCLE_COUNTER(STAT_SNReachabilityBFS);
+
+    FEntry& Entry = *Victim;
+    Entry.Start = Start;
+    Entry.MaxRange = MaxRange;
+    Entry.bValid = true;
+    Entry.LastUsed = ++UseCounter;
+
+    const int32 Capacity = FGridReachability::GetMaxReachableCells(MaxRange, Occupancy.GetNumCells());
+    Entry.Cells.SetNumUninitialized(Capacity, EAllowShrinking::No);
+    Entry.CellDistances.SetNumUninitialized(Capacity, EAllowShrinking::No);
+    const int32 NumReached = Search.FindReachableCells(Occupancy, Start, MaxRange, Entry.Cells, Entry.CellDistances);
+    Entry.Cells.SetNum(NumReached, EAllowShrinking::No);
+
+    // Distance field over the diamond's bounding box, clipped to the grid
+    const FIntPoint BoxMax(FMath::Min(Start.X + MaxRange, Occupancy.GetWidth() - 1), FMath::Min(Start.Y + MaxRange, Occupancy.GetHeight() - 1));
+    Entry.BoxMin = FIntPoint(FMath::Max(Start.X - MaxRange, 0), FMath::Max(Start.Y - MaxRange, 0));
+    Entry.BoxSize = FIntPoint(FMath::Max(BoxMax.X - Entry.BoxMin.X + 1, 0), FMath::Max(BoxMax.Y - Entry.BoxMin.Y + 1, 0));
+
+    Entry.DistanceField.SetNumUninitialized(Entry.BoxSize.X * Entry.BoxSize.Y, EAllowShrinking::No);
+    FMemory::Memset(Entry.DistanceField.GetData(), 0xFF, Entry.DistanceField.Num() * sizeof(uint16));
+
+    if (Occupancy.IsValidCell(Start))
+    {
+        const FIntPoint Local = Start - Entry.BoxMin;
+        Entry.DistanceField[Local.Y * Entry.BoxSize.X + Local.X] = 0;
+    }
+
+    for (int32 Index = 0; Index < NumReached; ++Index)
+    {
+        const FIntPoint Local = Entry.Cells[Index] - Entry.BoxMin;
+        Entry.DistanceField[Local.Y * Entry.BoxSize.X + Local.X] = Entry.CellDistances[Index];
+    }
+
+    return Entry;
+}
@@ -0,0 +1,77 @@
+#include "MatchRandom.h"
+#include "StrategicNonsense.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+    /** Command line switch that pins each sub-stream, indexed by EMatchRandomStream. */
+    const TCHAR* const GStreamSeedSwitches[] = { TEXT("MapSeed="), TEXT("CombatSeed="), TEXT("AISeed=") };
+    static_assert(UE_ARRAY_COUNT(GStreamSeedSwitches) == static_cast<int32>(EMatchRandomStream::Count), "Missing switch for a random stream");
+}
+
+/**
+ * @brief Seeds every sub-stream from one match seed.
+ * @param InMatchSeed The seed that reproduces the whole match.
+ */
+void FMatchRandom::Initialise(int32 InMatchSeed)
+{
+    MatchSeed = InMatchSeed;
+    for (int32 Index = 0; Index < static_cast<int32>(EMatchRandomStream::Count); ++Index)
+    {
+        Streams[Index].Initialize(DeriveStreamSeed(MatchSeed, static_cast<EMatchRandomStream>(Index)));
+    }
+}
+
+/**
+ * @brief Seeds the streams from -MatchSeed= and the per-stream switches, or from the clock.
+ * @param CommandLine The command line to parse (usually FCommandLine::Get()).
+ */
+void FMatchRandom::InitialiseFromCommandLine(const TCHAR* CommandLine)
+{
+    int32 Seed = 0;
+    if (!FParse::Value(CommandLine, TEXT("MatchSeed="), Seed))
+    {
+        Seed = static_cast<int32>(FPlatformTime::Cycles());
+    }
+    Initialise(Seed);
+
+    for (int32 Index = 0; Index < static_cast<int32>(EMatchRandomStream::Count); ++Index)
+    {
+        int32 StreamSeed = 0;
+        if (FParse::Value(CommandLine, GStreamSeedSwitches[Index], StreamSeed))
+        {
+            SetStreamSeed(static_cast<EMatchRandomStream>(Index), StreamSeed);
+        }
+    }
+
+    UE_LOG(LogSNGame, Log, TEXT("Match seed %d (map %d, combat %d, AI %d); rerun with -MatchSeed=%d"),
+        MatchSeed, GetStreamSeed(EMatchRandomStream::Map), GetStreamSeed(EMatchRandomStream::Combat),
+        GetStreamSeed(EMatchRandomStream::AI), MatchSeed);
+}
+
+/**
+ * @brief Restarts one sub-stream from an explicit seed, leaving the others untouched.
+ * @param Stream The sub-stream to reseed.
+ * @param Seed Its new initial seed.
+ */
+void FMatchRandom::SetStreamSeed(EMatchRandomStream Stream, int32 Seed)
+{
+    Streams[static_cast<int32>(Stream)].Initialize(Seed);
+}
+
+/**
+ * @brief Mixes the match seed with the stream index (SplitMix64 finaliser), so neighbouring
+ *        match seeds and neighbouring streams start from unrelated states.
+ * @param InMatchSeed The match seed.
+ * @param Stream The sub-stream.
+ * @return The sub-stream's seed.
+ */
+int32 FMatchRandom::DeriveStreamSeed(int32 InMatchSeed, EMatchRandomStream Stream)
+{
+    uint64 Mixed = ((static_cast<uint64>(static_cast<uint32>(InMatchSeed)) << 8) | static_cast<uint64>(Stream)) + 0x9E3779B97F4A7C15ull;
+    Mixed = (Mixed ^ (Mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+    Mixed = (Mixed ^ (Mixed >> 27)) * 0x94D049BB133111EBull;
+    Mixed ^= Mixed >> 31;
+    return static_cast<int32>(static_cast<uint32>(Mixed));
+}
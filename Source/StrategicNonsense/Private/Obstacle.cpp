@@ -1,5 +1,7 @@
 #include "Obstacle.h"
+#include "StrategicNonsense.h"
 #include "Components/StaticMeshComponent.h"
+#include "Math/RandomStream.h"
 #include "Materials/MaterialInstanceDynamic.h"
 
 /**
@@ -27,9 +29,21 @@ void AObstacle::BeginPlay()
     SetActorScale3D(ScaleOverride);
 }
 
+/**
+ * @brief Called when the actor pool reuses this obstacle.
+ *
+ * BeginPlay does not run again, so the texture and scale are applied here for the new seed and transform.
+ */
+void AObstacle::OnReactivated()
+{
+    ApplyRandomTexture();
+    SetActorScale3D(ScaleOverride);
+}
+
 /**
  * @brief Randomly selects and applies a texture from the ObstacleTextures array.
  *
+ * The pick is drawn from TextureSeed rather than the global random state, so it is reproducible.
  * Uses a dynamic material instance to assign the selected texture to the mesh.
  * Logs warnings if the texture array is empty or contains null entries.
  */
@@ -37,17 +51,18 @@ void AObstacle::ApplyRandomTexture()
 {
     if (ObstacleTextures.Num() == 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("No textures assigned to ObstacleTextures array!"));
+        UE_LOG(LogSNGrid, Warning, TEXT("No textures assigned to ObstacleTextures array!"));
         return;
     }
 
     // Pick a random texture from the array
-    int32 RandomIndex = FMath::RandRange(0, ObstacleTextures.Num() - 1);
+    FRandomStream Stream(TextureSeed);
+    int32 RandomIndex = Stream.RandRange(0, ObstacleTextures.Num() - 1);
     UTexture2D* SelectedTexture = ObstacleTextures[RandomIndex];
 
     if (!SelectedTexture)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Selected texture is null!"));
+        UE_LOG(LogSNGrid, Warning, TEXT("Selected texture is null!"));
         return;
     }
 
@@ -0,0 +1,190 @@
+#include "SelfPlayCommandlet.h"
+#include "StrategicNonsense.h"
+#include "BattleMatchSimulator.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    // Per-activation budgets used when -Seed= is given without -BudgetMs=
+    constexpr int64 DefaultSeededSearchNodes = 20000;
+    constexpr int32 DefaultSeededPlayouts = 1000;
+
+    /** Counts each damage value in a set of per-hit arrays, growing the histogram as needed. */
+    void AddToHistogram(TArray<int32>& Histogram, const TArray<uint8>& Values)
+    {
+        for (uint8 Value : Values)
+        {
+            if (Histogram.Num() <= Value)
+            {
+                Histogram.SetNumZeroed(Value + 1);
+            }
+            ++Histogram[Value];
+        }
+    }
+
+    bool ParseAgentParam(const FString& Params, const TCHAR* Key, EBattleAgent& OutAgent)
+    {
+        FString Name;
+        if (!FParse::Value(*Params, Key, Name))
+            return true;
+
+        if (FBattleMatchSimulator::ParseAgent(Name, OutAgent))
+            return true;
+
+        UE_LOG(LogSNAI, Error, TEXT("Unknown agent '%s' for %s (expected Random, Expectiminimax or MonteCarlo)."), *Name, Key);
+        return false;
+    }
+}
+
+USelfPlayCommandlet::USelfPlayCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+/**
+ * @brief Parses the batch settings, plays every match across the task graph and writes the CSV files.
+ * @param Params Command line parameters (see the class comment).
+ * @return 0 on success, 1 on bad parameters or if the output could not be written.
+ */
+int32 USelfPlayCommandlet::Main(const FString& Params)
+{
+    FBattleMatchConfig Config;
+    int32 NumMatches = 100;
+    float BudgetMs = static_cast<float>(Config.ActionBudgetSeconds * 1000.0);
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("SelfPlay/SelfPlay.csv");
+
+    FParse::Value(*Params, TEXT("Matches="), NumMatches);
+    FParse::Value(*Params, TEXT("GridX="), Config.GridSizeX);
+    FParse::Value(*Params, TEXT("GridY="), Config.GridSizeY);
+    FParse::Value(*Params, TEXT("Obstacles="), Config.ObstaclePercentage);
+    const bool bTimeBudgetGiven = FParse::Value(*Params, TEXT("BudgetMs="), BudgetMs);
+    FParse::Value(*Params, TEXT("Depth="), Config.SearchMaxDepth);
+    FParse::Value(*Params, TEXT("Nodes="), Config.ActionSearchNodes);
+    FParse::Value(*Params, TEXT("Playouts="), Config.ActionPlayouts);
+    FParse::Value(*Params, TEXT("MaxTurns="), Config.MaxTurns);
+    const bool bSeedGiven = FParse::Value(*Params, TEXT("Seed="), Config.Seed);
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    Config.ActionBudgetSeconds = BudgetMs / 1000.0;
+
+    if (!ParseAgentParam(Params, TEXT("Team0="), Config.Agents[0]) || !ParseAgentParam(Params, TEXT("Team1="), Config.Agents[1]))
+        return 1;
+
+    // A seeded batch is meant to be replayed, so the search agents count work instead of time
+    if (bSeedGiven && !bTimeBudgetGiven)
+    {
+        Config.ActionSearchNodes = (Config.ActionSearchNodes > 0) ? Config.ActionSearchNodes : DefaultSeededSearchNodes;
+        Config.ActionPlayouts = (Config.ActionPlayouts > 0) ? Config.ActionPlayouts : DefaultSeededPlayouts;
+    }
+
+    const bool bTimedSearch = (Config.ActionSearchNodes <= 0 && (Config.Agents[0] == EBattleAgent::Expectiminimax || Config.Agents[1] == EBattleAgent::Expectiminimax))
+        || (Config.ActionPlayouts <= 0 && (Config.Agents[0] == EBattleAgent::MonteCarlo || Config.Agents[1] == EBattleAgent::MonteCarlo));
+    if (bTimedSearch)
+    {
+        UE_LOG(LogSNAI, Warning, TEXT("Search agents run on a %.0f ms time budget, so results depend on machine load and are not reproducible. Pass -Nodes= and -Playouts= (or -Seed= without -BudgetMs=) to fix them."), BudgetMs);
+    }
+
+    if (NumMatches <= 0 || Config.GridSizeX <= 0 || Config.GridSizeY <= 0)
+    {
+        UE_LOG(LogSNAI, Error, TEXT("Matches, GridX and GridY must be positive."));
+        return 1;
+    }
+
+    UE_LOG(LogSNAI, Display, TEXT("Self-play: %d matches, %s vs %s on %dx%d (%.0f%% obstacles)"), NumMatches,
+        FBattleMatchSimulator::GetAgentName(Config.Agents[0]), FBattleMatchSimulator::GetAgentName(Config.Agents[1]),
+        Config.GridSizeX, Config.GridSizeY, Config.ObstaclePercentage);
+
+    TArray<FBattleMatchReport> Reports;
+    Reports.SetNum(NumMatches);
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    ParallelFor(NumMatches, [&Reports, &Config](int32 MatchIndex)
+    {
+        FBattleMatchConfig MatchConfig = Config;
+        MatchConfig.Seed = Config.Seed + MatchIndex;
+        Reports[MatchIndex] = FBattleMatchSimulator::RunMatch(MatchConfig);
+    }, EParallelForFlags::Unbalanced);
+
+    const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+
+    // Aggregate
+    int32 Wins[2] = { 0, 0 };
+    int32 Draws = 0;
+    int32 Unfinished = 0;
+    int64 TotalTurns = 0;
+    TArray<int32> AttackHistogram[2];
+    TArray<int32> CounterHistogram[2];
+
+    FString MatchRows = TEXT("Match,Seed,StartingTeam,Result,Turns,Activations,Team0Hits,Team1Hits,Seconds\n");
+
+    for (int32 MatchIndex = 0; MatchIndex < Reports.Num(); ++MatchIndex)
+    {
+        const FBattleMatchReport& Report = Reports[MatchIndex];
+
+        const TCHAR* ResultName = TEXT("Unfinished");
+        switch (Report.Result)
+        {
+        case EBattleResult::Team0Wins: ++Wins[0]; ResultName = TEXT("Team0"); break;
+        case EBattleResult::Team1Wins: ++Wins[1]; ResultName = TEXT("Team1"); break;
+        case EBattleResult::Draw: ++Draws; ResultName = TEXT("Draw"); break;
+        default: ++Unfinished; break;
+        }
+
+        TotalTurns += Report.Turns;
+        for (int32 Team = 0; Team < 2; ++Team)
+        {
+            AddToHistogram(AttackHistogram[Team], Report.AttackDamage[Team]);
+            AddToHistogram(CounterHistogram[Team], Report.CounterDamage[Team]);
+        }
+
+        MatchRows += FString::Printf(TEXT("%d,%d,%d,%s,%d,%d,%d,%d,%.4f\n"), MatchIndex, Config.Seed + MatchIndex,
+            Report.StartingTeam, ResultName, Report.Turns, Report.Activations,
+            Report.AttackDamage[0].Num(), Report.AttackDamage[1].Num(), Report.Seconds);
+    }
+
+    const double AverageTurns = static_cast<double>(TotalTurns) / NumMatches;
+
+    FString Summary = TEXT("Matches,Team0Agent,Team1Agent,GridX,GridY,Obstacles,BudgetMs,Depth,Team0Wins,Team1Wins,Draws,Unfinished,Team0WinRate,Team1WinRate,AverageTurns,WallSeconds,Nodes,Playouts\n");
+    Summary += FString::Printf(TEXT("%d,%s,%s,%d,%d,%.1f,%.1f,%d,%d,%d,%d,%d,%.4f,%.4f,%.2f,%.2f,%lld,%d\n"), NumMatches,
+        FBattleMatchSimulator::GetAgentName(Config.Agents[0]), FBattleMatchSimulator::GetAgentName(Config.Agents[1]),
+        Config.GridSizeX, Config.GridSizeY, Config.ObstaclePercentage, BudgetMs, Config.SearchMaxDepth,
+        Wins[0], Wins[1], Draws, Unfinished,
+        static_cast<double>(Wins[0]) / NumMatches, static_cast<double>(Wins[1]) / NumMatches, AverageTurns, WallSeconds,
+        Config.ActionSearchNodes, Config.ActionPlayouts);
+
+    int32 NumBins = 0;
+    for (int32 Team = 0; Team < 2; ++Team)
+    {
+        NumBins = FMath::Max3(NumBins, AttackHistogram[Team].Num(), CounterHistogram[Team].Num());
+    }
+
+    FString Damage = TEXT("Damage,Team0Attacks,Team1Attacks,Team0Counters,Team1Counters\n");
+    for (int32 Bin = 0; Bin < NumBins; ++Bin)
+    {
+        auto Count = [Bin](const TArray<int32>& Histogram) { return Histogram.IsValidIndex(Bin) ? Histogram[Bin] : 0; };
+        Damage += FString::Printf(TEXT("%d,%d,%d,%d,%d\n"), Bin,
+            Count(AttackHistogram[0]), Count(AttackHistogram[1]), Count(CounterHistogram[0]), Count(CounterHistogram[1]));
+    }
+
+    const FString BasePath = FPaths::GetBaseFilename(OutputPath, false);
+    const bool bSaved = FFileHelper::SaveStringToFile(Summary, *OutputPath) &&
+        FFileHelper::SaveStringToFile(MatchRows, *(BasePath + TEXT("_matches.csv"))) &&
+        FFileHelper::SaveStringToFile(Damage, *(BasePath + TEXT("_damage.csv")));
+
+    if (!bSaved)
+    {
+        UE_LOG(LogSNAI, Error, TEXT("Failed to write self-play results to %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogSNAI, Display, TEXT("Self-play done in %.1fs: team 0 %d, team 1 %d, draws %d, unfinished %d, %.1f turns on average. Results in %s"),
+        WallSeconds, Wins[0], Wins[1], Draws, Unfinished, AverageTurns, *OutputPath);
+
+    return 0;
+}
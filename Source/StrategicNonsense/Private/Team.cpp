@@ -1,35 +1,47 @@
 #include "Team.h"
+#include "StrategicNonsense.h"
 #include "UnitActor.h"
 #include "SniperUnit.h"
 #include "BrawlerUnit.h"
+#include "BattleAssetRegistry.h"
+#include "GridManager.h"
 
 /**
  * @brief Initialises the team with a colour and player/AI role.
  *
- * Loads blueprint classes for the team's Sniper and Brawler units based on the colour.
+ * The unit blueprints are not loaded here; they are streamed during the start message and
+ * picked up by ResolveUnitClasses.
  *
  * @param Colour The team's identifying colour (used for blueprint paths).
  * @param bIsPlayer True if the team is controlled by the player, false if AI.
+ * @param InTeamIndex The team's index in the unit registry (0 or 1).
+ * @param InGridManager The grid whose unit registry tracks the team's units.
  */
-void UTeam::Initialise(FName Colour, bool bIsPlayer)
+void UTeam::Initialise(FName Colour, bool bIsPlayer, uint8 InTeamIndex, AGridManager* InGridManager)
 {
     TeamColour = Colour;
     bPlayerControlled = bIsPlayer;
+    TeamIndex = InTeamIndex;
+    GridManager = InGridManager;
+}
 
-    FString SniperPath = FString::Printf(TEXT("/Game/Blueprints/BP_Sniper_%s.BP_Sniper_%s_C"), *TeamColour.ToString(), *TeamColour.ToString());
-    FString BrawlerPath = FString::Printf(TEXT("/Game/Blueprints/BP_Brawler_%s.BP_Brawler_%s_C"), *TeamColour.ToString(), *TeamColour.ToString());
-
-    SniperBlueprint = StaticLoadClass(AUnitActor::StaticClass(), nullptr, *SniperPath);
-    BrawlerBlueprint = StaticLoadClass(AUnitActor::StaticClass(), nullptr, *BrawlerPath);
+/**
+ * @brief Takes the team's Sniper and Brawler blueprint classes from the asset registry and queues them for placement.
+ */
+void UTeam::ResolveUnitClasses()
+{
+    UBattleAssetRegistry* Assets = UBattleAssetRegistry::Get(this);
+    SniperBlueprint = Assets ? Assets->GetUnitClass(TeamColour, EGameUnitType::Sniper) : nullptr;
+    BrawlerBlueprint = Assets ? Assets->GetUnitClass(TeamColour, EGameUnitType::Brawler) : nullptr;
 
     if (!SniperBlueprint)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to load Sniper blueprint for team: %s"), *TeamColour.ToString());
+        UE_LOG(LogSNPlacement, Error, TEXT("Failed to load Sniper blueprint for team: %s"), *TeamColour.ToString());
     }
 
     if (!BrawlerBlueprint)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to load Brawler blueprint for team: %s"), *TeamColour.ToString());
+        UE_LOG(LogSNPlacement, Error, TEXT("Failed to load Brawler blueprint for team: %s"), *TeamColour.ToString());
     }
 
     UnitsLeftToPlace = { SniperBlueprint, BrawlerBlueprint };
@@ -87,14 +99,7 @@ TArray<TSubclassOf<AUnitActor>>& UTeam::GetUnplacedUnits()
  */
 bool UTeam::HasTeamFinishedTurn() const
 {
-    for (AUnitActor* Unit : ControlledUnits)
-    {
-        if (Unit && !Unit->IsDead() && !Unit->HasMovedThisTurn())
-        {
-            return false;
-        }
-    }
-    return true;
+    return GridManager->GetUnitRegistry().HasTeamFinishedTurn(TeamIndex);
 }
 
 /**
@@ -106,6 +111,7 @@ void UTeam::AddUnit(AUnitActor* Unit)
     if (Unit)
     {
         ControlledUnits.Add(Unit);
+        Unit->SetTeamIndex(TeamIndex);
     }
 }
 
@@ -119,16 +125,25 @@ const TArray<AUnitActor*>& UTeam::GetControlledUnits() const
 }
 
 /**
- * @brief Resets all controlled units for a new turn (movement and attack).
+ * @brief Resets all living units of the team for a new turn (movement and attack), in the registry and on their actors.
  */
 void UTeam::ResetUnitsForNewTurn()
 {
-    for (AUnitActor* Unit : ControlledUnits)
+    GridManager->ResetTeamForNewTurn(TeamIndex);
+}
+
+/**
+ * @brief Marks every living unit of the team as having moved and attacked, ending its turn.
+ */
+void UTeam::MarkUnitsAsDone()
+{
+    const FBattleUnitRegistry& Registry = GridManager->GetUnitRegistry();
+    for (int32 UnitId : Registry.GetTeamUnits(TeamIndex))
     {
-        if (Unit)
+        AUnitActor* Unit = GridManager->GetRegisteredUnit(UnitId);
+        if (Unit && Registry.IsAlive(UnitId))
         {
-            Unit->ResetMovement();
-            Unit->ResetAttack();
+            Unit->MarkAsDone();
         }
     }
 }
@@ -136,11 +151,16 @@ void UTeam::ResetUnitsForNewTurn()
 /**
  * @brief Checks whether a given unit belongs to this team.
  * @param Unit The unit to check.
- * @return True if the unit is controlled by this team.
+ * @return True if the unit is controlled by this team. Units no longer on the grid answer from their own team index.
  */
 bool UTeam::OwnsUnit(const AUnitActor* Unit) const
 {
-    return ControlledUnits.Contains(Unit);
+    if (!Unit)
+        return false;
+
+    return Unit->GetRegistryId() != INDEX_NONE
+        ? GridManager->GetUnitRegistry().IsOwnedBy(Unit->GetRegistryId(), TeamIndex)
+        : Unit->GetTeamIndex() == TeamIndex;
 }
 
 /**
@@ -149,11 +169,6 @@ bool UTeam::OwnsUnit(const AUnitActor* Unit) const
  */
 bool UTeam::HasLivingUnits() const
 {
-    for (AUnitActor* Unit : ControlledUnits)
-    {
-        if (IsValid(Unit) && !Unit->IsDead())
-            return true;
-    }
-    return false;
+    return GridManager->GetUnitRegistry().GetNumLiving(TeamIndex) > 0;
 }
 
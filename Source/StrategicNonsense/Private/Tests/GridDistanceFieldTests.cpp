@@ -0,0 +1,143 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GridDistanceField.h"
+#include "GridOccupancy.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+    /** Compares an incrementally repaired field against one computed from scratch with the same sources and mask. */
+    bool MatchesRecompute(FAutomationTestBase& Test, const FGridOccupancy& Occupancy, const FGridDistanceField& Field,
+        TConstArrayView<uint64> Mask, const TCHAR* Step, int32 StepIndex)
+    {
+        FGridDistanceField Reference;
+        Reference.Compute(Occupancy, Field.GetSources(), Mask);
+
+        const TConstArrayView<int16> Expected = Reference.GetDistances();
+        const TConstArrayView<int16> Actual = Field.GetDistances();
+        for (int32 Index = 0; Index < Expected.Num(); ++Index)
+        {
+            if (Actual[Index] != Expected[Index])
+            {
+                const FIntPoint Cell = Occupancy.ToCell(Index);
+                Test.AddError(FString::Printf(TEXT("Step %d (%s): cell (%d, %d) is %d after repair, %d after recompute"),
+                    StepIndex, Step, Cell.X, Cell.Y, Actual[Index], Expected[Index]));
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+/**
+ * Applies random obstacle toggles and source adds, removes and moves to a field, and checks after
+ * every step that the incremental repair matches a full recompute. Runs with and without an extra
+ * blocked mask, on grids whose width spans several bitset words.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridDistanceFieldRepairTest, "StrategicNonsense.Grid.DistanceField.RepairMatchesRecompute",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FGridDistanceFieldRepairTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumSteps = 400;
+    const FIntPoint Sizes[] = { FIntPoint(25, 25), FIntPoint(70, 40) };
+
+    for (const FIntPoint& Size : Sizes)
+    {
+        for (const bool bMasked : { false, true })
+        {
+            FRandomStream Stream(Size.X * 31 + Size.Y + bMasked);
+
+            FGridOccupancy Occupancy;
+            Occupancy.Initialise(Size.X, Size.Y);
+            Occupancy.ForEachFreeCell([&Occupancy, &Stream](const FIntPoint& Cell)
+            {
+                if (Stream.FRand() < 0.2f)
+                {
+                    Occupancy.SetBlocked(Cell, true);
+                }
+            });
+
+            // The mask reuses the occupancy's word layout: a copy of an empty grid with a few cells set
+            TArray<uint64> Mask;
+            if (bMasked)
+            {
+                FGridOccupancy MaskLayer;
+                MaskLayer.Initialise(Size.X, Size.Y);
+                for (int32 Count = 0; Count < Occupancy.GetNumCells() / 10; ++Count)
+                {
+                    MaskLayer.SetBlocked(FIntPoint(Stream.RandRange(0, Size.X - 1), Stream.RandRange(0, Size.Y - 1)), true);
+                }
+                Mask = MaskLayer.GetBlockedWords();
+            }
+
+            const auto RandomCell = [&Stream, &Size]() { return FIntPoint(Stream.RandRange(0, Size.X - 1), Stream.RandRange(0, Size.Y - 1)); };
+
+            TArray<FIntPoint> Sources = { RandomCell(), RandomCell(), RandomCell() };
+            FGridDistanceField Field;
+            Field.Compute(Occupancy, Sources, Mask);
+
+            for (int32 Step = 0; Step < NumSteps; ++Step)
+            {
+                const TCHAR* StepName = nullptr;
+                switch (Stream.RandRange(0, 3))
+                {
+                case 0:
+                {
+                    const FIntPoint Cell = RandomCell();
+                    Occupancy.SetBlocked(Cell, !Occupancy.IsBlocked(Cell));
+                    Field.OnCellChanged(Occupancy, Cell);
+                    StepName = TEXT("toggle cell");
+                    break;
+                }
+                case 1:
+                    Field.AddSource(Occupancy, RandomCell());
+                    StepName = TEXT("add source");
+                    break;
+                case 2:
+                    if (!Field.GetSources().IsEmpty())
+                    {
+                        const FIntPoint Cell = Field.GetSources()[Stream.RandRange(0, Field.GetSources().Num() - 1)];
+                        Field.RemoveSource(Occupancy, Cell);
+                    }
+                    StepName = TEXT("remove source");
+                    break;
+                default:
+                    if (!Field.GetSources().IsEmpty())
+                    {
+                        const FIntPoint From = Field.GetSources()[Stream.RandRange(0, Field.GetSources().Num() - 1)];
+                        Field.MoveSource(Occupancy, From, RandomCell());
+                    }
+                    StepName = TEXT("move source");
+                    break;
+                }
+
+                if (!MatchesRecompute(*this, Occupancy, Field, Mask, StepName, Step))
+                    break;
+            }
+        }
+    }
+
+    // Copies of one source past the old 8-bit count must not wrap and drop the source
+    FGridOccupancy Occupancy;
+    Occupancy.Initialise(8, 8);
+    FGridDistanceField Field;
+    Field.Compute(Occupancy, {});
+    for (int32 Copy = 0; Copy < 300; ++Copy)
+    {
+        Field.AddSource(Occupancy, FIntPoint(2, 2));
+    }
+    for (int32 Copy = 0; Copy < 299; ++Copy)
+    {
+        Field.RemoveSource(Occupancy, FIntPoint(2, 2));
+    }
+    TestEqual(TEXT("Distance to a source with one copy left"), Field.GetDistance(Occupancy, FIntPoint(2, 2)), 0);
+    TestEqual(TEXT("Distance next to it"), Field.GetDistance(Occupancy, FIntPoint(3, 2)), 1);
+
+    return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,119 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GridPathfinder.h"
+#include "GridReachability.h"
+#include "GridOccupancy.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+    /** Checks that a path steps between 4-neighbouring free cells from Start and ends on Goal. */
+    bool IsValidPath(const FGridOccupancy& Occupancy, const FIntPoint& Start, const FIntPoint& Goal, const TArray<FIntPoint>& Path)
+    {
+        FIntPoint Previous = Start;
+        for (const FIntPoint& Cell : Path)
+        {
+            if (!Occupancy.IsValidCell(Cell) || Occupancy.IsBlocked(Cell))
+                return false;
+
+            if (FMath::Abs(Cell.X - Previous.X) + FMath::Abs(Cell.Y - Previous.Y) != 1)
+                return false;
+
+            Previous = Cell;
+        }
+        return Path.IsEmpty() ? Start == Goal : Path.Last() == Goal;
+    }
+}
+
+/**
+ * Runs random path queries on generated grids and checks every result against the BFS distances
+ * of FGridReachability: a path exists exactly when the goal is reachable, it is a chain of free
+ * neighbouring cells as long as the BFS distance, and a budget one step short of it fails.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridPathfinderTest, "StrategicNonsense.Grid.Pathfinder.MatchesBFSDistances",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FGridPathfinderTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumQueries = 200;
+    const FIntPoint Sizes[] = { FIntPoint(25, 25), FIntPoint(70, 40) };
+    const int32 Densities[] = { 0, 20, 40 };
+
+    for (const FIntPoint& Size : Sizes)
+    {
+        for (const int32 Density : Densities)
+        {
+            FRandomStream Stream(Size.X * 31 + Size.Y + Density);
+
+            FGridOccupancy Occupancy;
+            Occupancy.Initialise(Size.X, Size.Y);
+            Occupancy.ForEachFreeCell([&Occupancy, &Stream, Density](const FIntPoint& Cell)
+            {
+                if (Stream.RandRange(0, 99) < Density)
+                {
+                    Occupancy.SetBlocked(Cell, true);
+                }
+            });
+
+            // Any path is shorter than the number of cells, so this range reaches everything connected
+            const int32 NumCells = Occupancy.GetNumCells();
+            TArray<FIntPoint> Reached;
+            TArray<uint16> ReachedDistances;
+            Reached.SetNumUninitialized(NumCells);
+            ReachedDistances.SetNumUninitialized(NumCells);
+            TArray<int32> Distances;
+
+            FGridReachability Reachability;
+            FGridPathfinder Pathfinder;
+            TArray<FIntPoint> Path;
+
+            for (int32 Query = 0; Query < NumQueries; ++Query)
+            {
+                const FIntPoint Start(Stream.RandRange(0, Size.X - 1), Stream.RandRange(0, Size.Y - 1));
+                const FIntPoint Goal(Stream.RandRange(0, Size.X - 1), Stream.RandRange(0, Size.Y - 1));
+
+                Distances.Init(INDEX_NONE, NumCells);
+                Distances[Occupancy.ToIndex(Start)] = 0;
+                const int32 NumReached = Reachability.FindReachableCells(Occupancy, Start, NumCells, Reached, ReachedDistances);
+                for (int32 Index = 0; Index < NumReached; ++Index)
+                {
+                    Distances[Occupancy.ToIndex(Reached[Index])] = ReachedDistances[Index];
+                }
+
+                const int32 Expected = Distances[Occupancy.ToIndex(Goal)];
+                const bool bFound = Pathfinder.FindPath(Occupancy, Start, Goal, NumCells, Path);
+
+                const FString Where = FString::Printf(TEXT("%dx%d at %d%%, (%d, %d) to (%d, %d)"),
+                    Size.X, Size.Y, Density, Start.X, Start.Y, Goal.X, Goal.Y);
+
+                if (bFound != (Expected != INDEX_NONE))
+                {
+                    AddError(FString::Printf(TEXT("%s: path %s, BFS distance %d"), *Where, bFound ? TEXT("found") : TEXT("not found"), Expected));
+                    break;
+                }
+
+                if (!bFound)
+                    continue;
+
+                if (Path.Num() != Expected || !IsValidPath(Occupancy, Start, Goal, Path))
+                {
+                    AddError(FString::Printf(TEXT("%s: path of %d steps is invalid or differs from the BFS distance %d"), *Where, Path.Num(), Expected));
+                    break;
+                }
+
+                if (Expected > 0 && Pathfinder.FindPath(Occupancy, Start, Goal, Expected - 1, Path))
+                {
+                    AddError(FString::Printf(TEXT("%s: found a path within %d steps, one short of the BFS distance"), *Where, Expected - 1));
+                    break;
+                }
+            }
+        }
+    }
+
+    return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
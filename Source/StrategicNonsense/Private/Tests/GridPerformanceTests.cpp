@@ -0,0 +1,88 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GridBenchmark.h"
+#include "Engine/Engine.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+
+/**
+ * Times the grid, pathfinding and combat hot paths for every default grid size and obstacle
+ * density, one test per pair, and writes each pair's report to Saved/Benchmarks/Automation.
+ *
+ * Run headless with:
+ *   UnrealEditor-Cmd StrategicNonsense.uproject -nullrhi -unattended
+ *     -ExecCmds="Automation RunTests StrategicNonsense.Perf; Quit"
+ *     [-GridBenchmarkSamples=200] [-GridBenchmarkBaseline=<path>.json] [-GridBenchmarkTolerance=0.25]
+ *
+ * Configuration N uses seed N, matching a default UGridBenchmarkCommandlet run, so a commandlet
+ * report can serve as the baseline. With a baseline, each regression is reported as a test error.
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FGridPerformanceTest, "StrategicNonsense.Perf.Grid",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+void FGridPerformanceTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    int32 ConfigIndex = 0;
+    for (int32 GridSize : FGridBenchmark::GetDefaultSizes())
+    {
+        for (int32 Density : FGridBenchmark::GetDefaultDensities())
+        {
+            OutBeautifiedNames.Add(FString::Printf(TEXT("%dx%d_Density%d"), GridSize, GridSize, Density));
+            OutTestCommands.Add(FString::Printf(TEXT("%d %d %d"), GridSize, Density, ConfigIndex++));
+        }
+    }
+}
+
+bool FGridPerformanceTest::RunTest(const FString& Parameters)
+{
+    TArray<FString> Parts;
+    Parameters.ParseIntoArrayWS(Parts);
+    if (!TestEqual(TEXT("Test parameters"), Parts.Num(), 3) || !TestNotNull(TEXT("Engine"), GEngine))
+        return false;
+
+    const int32 GridSize = FCString::Atoi(*Parts[0]);
+    const int32 Density = FCString::Atoi(*Parts[1]);
+    const int32 Seed = FCString::Atoi(*Parts[2]);
+
+    int32 NumSamples = FGridBenchmark::DefaultNumSamples;
+    float Tolerance = FGridBenchmark::DefaultTolerance;
+    FString BaselinePath;
+    FParse::Value(FCommandLine::Get(), TEXT("GridBenchmarkSamples="), NumSamples);
+    FParse::Value(FCommandLine::Get(), TEXT("GridBenchmarkTolerance="), Tolerance);
+    FParse::Value(FCommandLine::Get(), TEXT("GridBenchmarkBaseline="), BaselinePath);
+
+    TArray<FGridBenchmarkResult> Results;
+    FGridBenchmark::BeginAllocationCounting();
+    FGridBenchmark::RunConfiguration(GridSize, Density, FMath::Max(1, NumSamples), Seed, Results);
+    FGridBenchmark::EndAllocationCounting();
+
+    for (const FGridBenchmarkResult& Result : Results)
+    {
+        AddInfo(FString::Printf(TEXT("%s: median %.2f us, p95 %.2f us, %.2f allocs/call"), *Result.Name,
+            Result.GetPercentile(0.5), Result.GetPercentile(0.95), Result.GetAllocationsPerCall()));
+    }
+
+    const FString OutputPath = FPaths::ProjectSavedDir() / FString::Printf(TEXT("Benchmarks/Automation/GridBenchmark_%d_%d.json"), GridSize, Density);
+    TestTrue(FString::Printf(TEXT("Report written to %s"), *OutputPath), FGridBenchmark::SaveReport(Results, TEXT("Automation"), Seed, OutputPath));
+
+    if (!BaselinePath.IsEmpty())
+    {
+        TMap<FString, FGridBenchmarkBaseline> Baseline;
+        if (TestTrue(FString::Printf(TEXT("Baseline %s read"), *BaselinePath), FGridBenchmark::LoadBaseline(BaselinePath, Baseline)))
+        {
+            TArray<FString> Regressions;
+            FGridBenchmark::FindRegressions(Results, Baseline, Tolerance, Regressions);
+            for (const FString& Regression : Regressions)
+            {
+                AddError(Regression);
+            }
+        }
+    }
+
+    return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,144 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GridReachability.h"
+#include "GridOccupancy.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+    /** Plain BFS with a per-cell distance array; the start may be blocked, like a unit's own cell. */
+    void ComputeReferenceDistances(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, TArray<int32>& OutDistances)
+    {
+        const FIntPoint Directions[] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+
+        OutDistances.Init(INDEX_NONE, Occupancy.GetNumCells());
+        OutDistances[Occupancy.ToIndex(Start)] = 0;
+
+        TArray<FIntPoint> Queue = { Start };
+        for (int32 Head = 0; Head < Queue.Num(); ++Head)
+        {
+            const FIntPoint Cell = Queue[Head];
+            const int32 Distance = OutDistances[Occupancy.ToIndex(Cell)];
+            if (Distance == MaxRange)
+                continue;
+
+            for (const FIntPoint& Dir : Directions)
+            {
+                const FIntPoint Neighbour = Cell + Dir;
+                if (!Occupancy.IsValidCell(Neighbour) || Occupancy.IsBlocked(Neighbour) || OutDistances[Occupancy.ToIndex(Neighbour)] != INDEX_NONE)
+                    continue;
+
+                OutDistances[Occupancy.ToIndex(Neighbour)] = Distance + 1;
+                Queue.Add(Neighbour);
+            }
+        }
+    }
+}
+
+/**
+ * Compares the span and bitmask queries of FGridReachability against a plain BFS for ranges 0-40
+ * from random start cells, on grids whose width spans several bitset words. The span must list
+ * every cell within range once, nearest first, with its exact distance; the mask must set exactly
+ * those cells. One searcher serves every query, so reused scratch state is covered as well.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridReachabilityTest, "StrategicNonsense.Grid.Reachability.MatchesReferenceBFS",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FGridReachabilityTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 MaxTestedRange = 40;
+    constexpr int32 StartsPerRange = 4;
+    const FIntPoint Sizes[] = { FIntPoint(25, 25), FIntPoint(130, 70) };
+    const int32 Densities[] = { 0, 20, 40 };
+
+    for (const FIntPoint& Size : Sizes)
+    {
+        for (const int32 Density : Densities)
+        {
+            FRandomStream Stream(Size.X * 31 + Size.Y + Density);
+
+            FGridOccupancy Occupancy;
+            Occupancy.Initialise(Size.X, Size.Y);
+            Occupancy.ForEachFreeCell([&Occupancy, &Stream, Density](const FIntPoint& Cell)
+            {
+                if (Stream.RandRange(0, 99) < Density)
+                {
+                    Occupancy.SetBlocked(Cell, true);
+                }
+            });
+
+            FGridReachability Reachability;
+            TArray<int32> Expected;
+            TArray<FIntPoint> Cells;
+            TArray<uint16> CellDistances;
+            TArray<uint64> Mask;
+            Mask.SetNumUninitialized(Occupancy.GetBlockedWords().Num());
+
+            bool bFailed = false;
+            for (int32 Range = 0; Range <= MaxTestedRange && !bFailed; ++Range)
+            {
+                for (int32 Attempt = 0; Attempt < StartsPerRange && !bFailed; ++Attempt)
+                {
+                    const FIntPoint Start(Stream.RandRange(0, Size.X - 1), Stream.RandRange(0, Size.Y - 1));
+                    const FString Where = FString::Printf(TEXT("%dx%d at %d%%, range %d from (%d, %d)"), Size.X, Size.Y, Density, Range, Start.X, Start.Y);
+
+                    ComputeReferenceDistances(Occupancy, Start, Range, Expected);
+                    int32 NumExpected = 0;
+                    for (int32 Distance : Expected)
+                    {
+                        NumExpected += (Distance > 0) ? 1 : 0;
+                    }
+
+                    const int32 Capacity = FGridReachability::GetMaxReachableCells(Range, Occupancy.GetNumCells());
+                    Cells.SetNumUninitialized(Capacity);
+                    CellDistances.SetNumUninitialized(Capacity);
+                    const int32 NumReached = Reachability.FindReachableCells(Occupancy, Start, Range, Cells, CellDistances);
+                    if (NumReached != NumExpected)
+                    {
+                        AddError(FString::Printf(TEXT("%s: %d cells reached, %d expected"), *Where, NumReached, NumExpected));
+                        bFailed = true;
+                        break;
+                    }
+
+                    // Equal counts plus an exact distance per cell, nearest first, means the same set
+                    for (int32 Index = 0; Index < NumReached; ++Index)
+                    {
+                        const int32 Distance = Expected[Occupancy.ToIndex(Cells[Index])];
+                        const bool bOrdered = Index == 0 || CellDistances[Index - 1] <= CellDistances[Index];
+                        if (Distance <= 0 || CellDistances[Index] != Distance || !bOrdered)
+                        {
+                            AddError(FString::Printf(TEXT("%s: cell (%d, %d) reported at distance %d, expected %d"),
+                                *Where, Cells[Index].X, Cells[Index].Y, CellDistances[Index], Distance));
+                            bFailed = true;
+                            break;
+                        }
+                    }
+
+                    const int32 NumMasked = Reachability.FindReachableMask(Occupancy, Start, Range, Mask);
+                    for (int32 Index = 0; Index < Occupancy.GetNumCells() && !bFailed; ++Index)
+                    {
+                        const FIntPoint Cell = Occupancy.ToCell(Index);
+                        if (FGridReachability::IsCellInMask(Mask, Occupancy.GetWordsPerRow(), Cell) != (Expected[Index] > 0))
+                        {
+                            AddError(FString::Printf(TEXT("%s: mask bit of cell (%d, %d) is wrong"), *Where, Cell.X, Cell.Y));
+                            bFailed = true;
+                        }
+                    }
+
+                    if (!bFailed && NumMasked != NumExpected)
+                    {
+                        AddError(FString::Printf(TEXT("%s: mask query reported %d cells, %d expected"), *Where, NumMasked, NumExpected));
+                        bFailed = true;
+                    }
+                }
+            }
+        }
+    }
+
+    return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
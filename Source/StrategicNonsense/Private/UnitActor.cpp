@@ -1,10 +1,12 @@
 #include "UnitActor.h"
+#include "StrategicNonsense.h"
+#include "BattleUnitRegistry.h"
 #include "PaperSpriteComponent.h"
 
 /**
  * @brief Base constructor for all unit types (Sniper, Brawler).
  *
- * Sets default values for movement, attack range, damage, and health.
+ * Stats come from the archetype table; health is filled in by BeginPlay.
  * Sprite component is expected to be assigned via Blueprint.
  */
 AUnitActor::AUnitActor()
@@ -13,20 +15,117 @@ AUnitActor::AUnitActor()
 
     // Let Blueprint define and attach SpriteComponent (dont override here)
     UnitType = EGameUnitType::Sniper;
-    MaxMovement = 0;
-    AttackType = EAttackType::ShortRange;
-    AttackRange = 0;
-    Damage = { 0, 0 };
+    ArchetypeId = static_cast<uint8>(EBattleArchetype::Sniper);
     Health = 0;
+    TeamIndex = FBattleUnitRegistry::NoTeam;
+}
+
+/**
+ * @brief Starts the unit at its archetype's full health.
+ */
+void AUnitActor::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (!FBattleArchetypeTable::Get().IsValid(ArchetypeId))
+    {
+        UE_LOG(LogSNGame, Error, TEXT("%s uses unknown archetype %d; falling back to Sniper."), *GetName(), ArchetypeId);
+        ArchetypeId = static_cast<uint8>(EBattleArchetype::Sniper);
+    }
+    Health = GetMaxHealth();
+}
+
+/**
+ * @brief Restores a recycled unit to its archetype's full health with no actions taken.
+ */
+void AUnitActor::OnReactivated()
+{
+    Health = GetMaxHealth();
+    GridPosition = FIntPoint::ZeroValue;
+    bHasMoved = false;
+    bHasAttacked = false;
+    TeamIndex = FBattleUnitRegistry::NoTeam;
+}
+
+/**
+ * @brief Drops the previous match's health listeners and registry entry before the unit is parked in the pool.
+ */
+void AUnitActor::OnDeactivated()
+{
+    OnHealthChanged.Clear();
+    UnbindFromRegistry();
+}
+
+/**
+ * @brief Links the unit to its registry entry and pushes its current state into it.
+ * @param InRegistry The grid's unit registry.
+ * @param InRegistryId The unit's ID in it.
+ */
+void AUnitActor::BindToRegistry(FBattleUnitRegistry* InRegistry, int32 InRegistryId)
+{
+    Registry = InRegistry;
+    RegistryId = InRegistryId;
+
+    Registry->SetHealth(RegistryId, Health);
+    SyncFlagsToRegistry();
+    if (TeamIndex != FBattleUnitRegistry::NoTeam)
+    {
+        Registry->SetTeam(RegistryId, TeamIndex);
+    }
+}
+
+/**
+ * @brief Stops writing through to the registry; the entry keeps the unit's last state.
+ */
+void AUnitActor::UnbindFromRegistry()
+{
+    Registry = nullptr;
+    RegistryId = INDEX_NONE;
+}
+
+/**
+ * @brief Records the team that owns the unit, here and in the registry.
+ * @param InTeamIndex 0 or 1.
+ */
+void AUnitActor::SetTeamIndex(uint8 InTeamIndex)
+{
+    TeamIndex = InTeamIndex;
+    if (Registry)
+    {
+        Registry->SetTeam(RegistryId, TeamIndex);
+    }
+}
+
+/**
+ * @brief Takes the turn flags from the unit's registry entry, for changes made to the registry directly.
+ */
+void AUnitActor::SyncFlagsFromRegistry()
+{
+    if (Registry)
+    {
+        const uint8 Flags = Registry->GetFlags(RegistryId);
+        bHasMoved = (Flags & FBattleUnit::Flag_Moved) != 0;
+        bHasAttacked = (Flags & FBattleUnit::Flag_Attacked) != 0;
+    }
+}
+
+void AUnitActor::SyncFlagsToRegistry()
+{
+    if (Registry)
+    {
+        Registry->SetFlags(RegistryId, (bHasMoved ? FBattleUnit::Flag_Moved : 0) | (bHasAttacked ? FBattleUnit::Flag_Attacked : 0));
+    }
 }
 
 /**
  * @brief Calculates and returns a random damage value within the unit's damage range.
- * @return A randomly selected integer between Damage.Min and Damage.Max.
+ * @param Stream The match's combat stream.
+ * @return A randomly selected integer within the archetype's damage range.
  */
-int32 AUnitActor::GetRandomDamage() const
+int32 AUnitActor::GetRandomDamage(FRandomStream& Stream) const
 {
-    return FMath::RandRange(Damage.Min, Damage.Max);
+    const FBattleUnitStats& Stats = GetStats();
+    return Stream.RandRange(Stats.DamageMin, Stats.DamageMax);
 }
 
 /**
@@ -36,16 +135,17 @@ int32 AUnitActor::GetRandomDamage() const
  * Skips damage if the target is already dead.
  *
  * @param Target The unit to attack.
+ * @param Stream The match's combat stream, used for the damage roll.
  */
-void AUnitActor::ApplyDamageTo(AUnitActor* Target)
+void AUnitActor::ApplyDamageTo(AUnitActor* Target, FRandomStream& Stream)
 {
     if (!Target || Target->IsDead())
         return;
 
-    int32 DamageDealt = GetRandomDamage();
+    int32 DamageDealt = GetRandomDamage(Stream);
     Target->ReceiveDamage(DamageDealt);
 
-    UE_LOG(LogTemp, Log, TEXT("%s dealt %d damage to %s"),
+    UE_LOG(LogSNCombat, Verbose, TEXT("%s dealt %d damage to %s"),
         *UEnum::GetValueAsString(UnitType),
         DamageDealt,
         *UEnum::GetValueAsString(Target->UnitType));
@@ -54,18 +154,28 @@ void AUnitActor::ApplyDamageTo(AUnitActor* Target)
 /**
  * @brief Reduces this units health by a specified amount.
  *
- * Prevents health from dropping below zero.
+ * Prevents health from dropping below zero, and broadcasts OnHealthChanged if health changed.
  *
  * @param Amount The amount of damage to apply.
  */
 void AUnitActor::ReceiveDamage(int32 Amount)
 {
+    const int32 PreviousHealth = Health;
     Health -= Amount;
 
     if (Health < 0)
         Health = 0;
 
-    UE_LOG(LogTemp, Log, TEXT("%s took %d damage. Remaining health: %d"),
+    if (Health != PreviousHealth)
+    {
+        if (Registry)
+        {
+            Registry->SetHealth(RegistryId, Health);
+        }
+        OnHealthChanged.Broadcast(this);
+    }
+
+    UE_LOG(LogSNCombat, Verbose, TEXT("%s took %d damage. Remaining health: %d"),
         *UEnum::GetValueAsString(UnitType),
         Amount,
         Health);
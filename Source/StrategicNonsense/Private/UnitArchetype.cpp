@@ -0,0 +1,31 @@
+#include "UnitArchetype.h"
+#include "BattleState.h"
+
+/**
+ * @brief Packs the row into the compact stats the battle core reads.
+ * @param OutStats Receives the stats; untouched if the row is out of range.
+ * @return false if a value does not fit its packed field or a damage range is reversed.
+ */
+bool FUnitArchetypeRow::ToStats(FBattleUnitStats& OutStats) const
+{
+    auto FitsByte = [](int32 Value) { return Value >= 0 && Value <= MAX_uint8; };
+
+    if (MaxHealth <= 0 || MaxHealth > MAX_int16 || !FitsByte(Movement) || !FitsByte(AttackRange) || !FitsByte(CounterRange) ||
+        !FitsByte(Damage.Min) || !FitsByte(Damage.Max) || Damage.Min > Damage.Max ||
+        !FitsByte(CounterDamage.Min) || !FitsByte(CounterDamage.Max) || CounterDamage.Min > CounterDamage.Max)
+    {
+        return false;
+    }
+
+    OutStats.MaxHealth = static_cast<int16>(MaxHealth);
+    OutStats.Movement = static_cast<uint8>(Movement);
+    OutStats.AttackRange = static_cast<uint8>(AttackRange);
+    OutStats.DamageMin = static_cast<uint8>(Damage.Min);
+    OutStats.DamageMax = static_cast<uint8>(Damage.Max);
+    OutStats.AttackType = static_cast<uint8>(AttackType);
+    OutStats.CounterRange = static_cast<uint8>(CounterRange);
+    OutStats.CounterDamageMin = static_cast<uint8>(CounterDamage.Min);
+    OutStats.CounterDamageMax = static_cast<uint8>(CounterDamage.Max);
+    OutStats.Flags = bProvokesCounters ? FBattleUnitStats::Flag_ProvokesCounters : 0;
+    return true;
+}
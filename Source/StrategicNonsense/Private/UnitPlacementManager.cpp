@@ -1,4 +1,5 @@
 #include "UnitPlacementManager.h"
+#include "StrategicNonsense.h"
 #include "BattleGameMode.h"
 #include "GridManager.h"
 #include "Team.h"
@@ -9,11 +10,13 @@
 #include "Blueprint/UserWidget.h"
 #include "TimerManager.h"
 #include "UnitSelectionWidget.h"
+#include "BattleAssetRegistry.h"
 
 /**
  * @brief Initialises the unit placement system with references to the game mode, grid, teams, and starter side.
  *
- * Displays the initial "who starts" message, then begins the alternating unit placement process.
+ * Displays the initial "who starts" message and streams the match's unit and widget blueprints
+ * while it is shown. The alternating placement begins once both the message and the assets are done.
  *
  * @param InGameMode Pointer to the game mode.
  * @param InGridManager Pointer to the grid manager.
@@ -34,16 +37,65 @@ void UUnitPlacementManager::Initialise(ABattleGameMode* InGameMode, AGridManager
 
     // Show the start message before starting placement
     ShowStartMessage();
+    GameMode->SetGamePhase(EGamePhase::Placement);
 
     // Delay the placement start to give room for the message
     FTimerHandle PlacementStartHandle;
     GridManager->GetWorld()->GetTimerManager().SetTimer(PlacementStartHandle, [this]()
         {
-            GameMode->SetGamePhase(EGamePhase::Placement);
-            StartNextPlacementStep();
+            bStartMessageDone = true;
+            TryBeginPlacement();
         }, 2.2f, false);  // Delay slightly longer than the message
 
-    GameMode->SetGamePhase(EGamePhase::Placement);
+    // Stream the unit blueprints while the message is up
+    TArray<FName> TeamColours;
+    for (const UTeam* Team : AllTeams)
+    {
+        TeamColours.Add(Team->GetTeamColour());
+    }
+
+    if (UBattleAssetRegistry* Assets = UBattleAssetRegistry::Get(this))
+    {
+        Assets->PreloadMatchAssets(TeamColours, FSimpleDelegate::CreateUObject(this, &UUnitPlacementManager::OnMatchAssetsLoaded));
+    }
+    else
+    {
+        OnMatchAssetsLoaded();
+    }
+}
+
+/**
+ * @brief Marks the match's blueprints as streamed in.
+ */
+void UUnitPlacementManager::OnMatchAssetsLoaded()
+{
+    bMatchAssetsLoaded = true;
+    TryBeginPlacement();
+}
+
+/**
+ * @brief Starts the alternating placement once the start message has finished and the assets are loaded.
+ *
+ * Publishes the unit archetype table first: it has streamed in with the match assets, and no unit
+ * is placed or planned for until placement starts.
+ */
+void UUnitPlacementManager::TryBeginPlacement()
+{
+    if (!bStartMessageDone || !bMatchAssetsLoaded || bPlacementStarted)
+        return;
+
+    bPlacementStarted = true;
+
+    if (UBattleAssetRegistry* Assets = UBattleAssetRegistry::Get(this))
+    {
+        Assets->PublishUnitArchetypes();
+    }
+
+    for (UTeam* Team : AllTeams)
+    {
+        Team->ResolveUnitClasses();
+    }
+
     StartNextPlacementStep();
 }
 
@@ -52,8 +104,8 @@ void UUnitPlacementManager::Initialise(ABattleGameMode* InGameMode, AGridManager
  */
 void UUnitPlacementManager::ShowStartMessage()
 {
-    FString WidgetPath = TEXT("/Game/Blueprints/WBP_StartMessage.WBP_StartMessage_C");
-    TSubclassOf<UStartMessageWidget> StartWidgetClass = Cast<UClass>(StaticLoadClass(UUserWidget::StaticClass(), nullptr, *WidgetPath));
+    UBattleAssetRegistry* Assets = UBattleAssetRegistry::Get(this);
+    TSubclassOf<UUserWidget> StartWidgetClass = Assets ? Assets->GetWidgetClass(EBattleWidget::StartMessage) : nullptr;
     if (!StartWidgetClass) return;
 
     APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0);
@@ -97,7 +149,7 @@ void UUnitPlacementManager::StartNextPlacementStep()
             GameMode->SpawnGameStatusWidget();
 
             GameMode->SetGamePhase(GameMode->DoesPlayerStart() ? EGamePhase::PlayerTurn : EGamePhase::AITurn);
-            UE_LOG(LogTemp, Log, TEXT("All units placed. Game begins."));
+            UE_LOG(LogSNPlacement, Log, TEXT("All units placed. Game begins."));
             return;
         }
 
@@ -112,11 +164,11 @@ void UUnitPlacementManager::StartNextPlacementStep()
         {
             if (!UnitSelectionWidgetClass)
             {
-                FString WidgetPath = TEXT("/Game/Blueprints/WBP_UnitSelectionWidget.WBP_UnitSelectionWidget_C");
-                UnitSelectionWidgetClass = Cast<UClass>(StaticLoadClass(UUserWidget::StaticClass(), nullptr, *WidgetPath));
+                UBattleAssetRegistry* Assets = UBattleAssetRegistry::Get(this);
+                UnitSelectionWidgetClass = Assets ? Assets->GetWidgetClass(EBattleWidget::UnitSelection) : nullptr;
                 if (!UnitSelectionWidgetClass)
                 {
-                    UE_LOG(LogTemp, Error, TEXT("Failed to load UnitSelectionWidgetClass"));
+                    UE_LOG(LogSNPlacement, Error, TEXT("Failed to load UnitSelectionWidgetClass"));
                     return;
                 }
             }
@@ -127,7 +179,7 @@ void UUnitPlacementManager::StartNextPlacementStep()
             UUnitSelectionWidget* Widget = CreateWidget<UUnitSelectionWidget>(PC, UnitSelectionWidgetClass);
             if (!Widget)
             {
-                UE_LOG(LogTemp, Error, TEXT("Failed to create UnitSelectionWidget"));
+                UE_LOG(LogSNPlacement, Error, TEXT("Failed to create UnitSelectionWidget"));
                 return;
             }
 
@@ -148,7 +200,7 @@ void UUnitPlacementManager::StartNextPlacementStep()
     }
     else
     {
-        int32 Index = FMath::RandRange(0, AvailableUnits->Num() - 1);
+        int32 Index = GameMode->GetMatchRandom().AI().RandRange(0, AvailableUnits->Num() - 1);
         FTimerHandle AIDelayHandle;
         GridManager->GetWorld()->GetTimerManager().SetTimer(AIDelayHandle, [this, AvailableUnits, Index]()
             {
@@ -165,7 +217,7 @@ void UUnitPlacementManager::HandleUnitChosen(TSubclassOf<AUnitActor> ChosenUnit)
 {
     UnitToPlaceNext = ChosenUnit;
 
-    UE_LOG(LogTemp, Log, TEXT("%s chose to place %s"),
+    UE_LOG(LogSNPlacement, Log, TEXT("%s chose to place %s"),
         *TeamPlacingNext->GetTeamColour().ToString(),
         *GetNameSafe(ChosenUnit));
 
@@ -192,6 +244,7 @@ void UUnitPlacementManager::HandlePlayerClickedGrid(const FVector& ClickLocation
     if (NewUnit)
     {
         TeamPlacingNext->AddUnit(NewUnit);
+        GameMode->RecordReplayPlacement(NewUnit, TeamPlacingNext);
         RemoveUnitFromQueue(UnitToPlaceNext, TeamPlacingNext);
         UnitToPlaceNext = nullptr;
         CurrentPlacementTeamIndex = 1 - CurrentPlacementTeamIndex;
@@ -209,13 +262,14 @@ void UUnitPlacementManager::PlaceAIUnit()
     if (!UnitToPlaceNext || !GridManager) return;
 
     FVector Location;
-    if (GridManager->GetRandomValidPlacementLocation(Location))
+    if (GridManager->GetRandomValidPlacementLocation(Location, GameMode->GetMatchRandom().AI()))
     {
         FIntPoint GridCoord = GridManager->WorldToGrid(Location);
         AUnitActor* NewUnit = GridManager->SpawnAndPlaceUnit(GridCoord, UnitToPlaceNext);
         if (NewUnit)
         {
             TeamPlacingNext->AddUnit(NewUnit);
+            GameMode->RecordReplayPlacement(NewUnit, TeamPlacingNext);
 
             RemoveUnitFromQueue(UnitToPlaceNext, TeamPlacingNext);
             UnitToPlaceNext = nullptr;
@@ -246,6 +300,6 @@ void UUnitPlacementManager::RemoveUnitFromQueue(TSubclassOf<AUnitActor> UnitClas
         }
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("Tried to remove unit %s from team %s, but it wasn't found in queue."),
+    UE_LOG(LogSNPlacement, Warning, TEXT("Tried to remove unit %s from team %s, but it wasn't found in queue."),
         *GetNameSafe(UnitClass), *OwningTeam->GetTeamColour().ToString());
 }
\ No newline at end of file
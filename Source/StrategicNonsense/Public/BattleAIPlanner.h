@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BattleState.h"
+#include "BattleTranspositionTable.h"
+#include <atomic>
+
+/**
+ * @struct FBattleAIPlannerSettings
+ * @brief Plain copy of the game mode's AI settings, safe to read from a worker thread.
+ */
+struct FBattleAIPlannerSettings
+{
+    bool bUseMonteCarlo = false;
+    double TurnBudgetSeconds = 0.25;
+    int32 SearchMaxDepth = 8;
+    int32 MonteCarloWorkers = 0;
+    int32 Seed = 0;
+
+    /** Shared with earlier plans so positions searched last turn are remembered (may be null). */
+    TSharedPtr<FBattleTranspositionTable, ESPMode::ThreadSafe> TranspositionTable;
+};
+
+/**
+ * @class FBattleAIPlanner
+ * @brief Plans a whole AI turn on a snapshot, without touching any UObject.
+ *
+ * Meant to run on a background task: it only reads its own board and state copies, and polls
+ * a cancel flag between (and inside) searches.
+ */
+class STRATEGICNONSENSE_API FBattleAIPlanner
+{
+public:
+    static void PlanTurn(const FBattleBoard& Board, const FBattleState& State, const FBattleAIPlannerSettings& Settings,
+        const std::atomic<bool>& bCancelled, TArray<FBattleAction>& OutCommands);
+
+    static FBattleOutcome GetExpectedOutcome(const FBattleBoard& Board, const FBattleState& State, const FBattleAction& Action);
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/Interface.h"
+#include "Templates/Function.h"
+#include "BattleActorPool.generated.h"
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class UBattlePooledActor : public UInterface
+{
+    GENERATED_BODY()
+};
+
+/**
+ * @class IBattlePooledActor
+ * @brief Optional hooks for actors recycled by UBattleActorPool.
+ *
+ * The pool itself hides every released actor and turns off its collision and ticking. Actors
+ * that keep gameplay state (health, turn flags, a random texture) implement these hooks to
+ * put it back the way a fresh spawn would have it, since BeginPlay does not run again.
+ */
+class STRATEGICNONSENSE_API IBattlePooledActor
+{
+    GENERATED_BODY()
+
+public:
+    /** Called when a released actor is handed out again, after it has been moved and prepared. */
+    virtual void OnReactivated() {}
+
+    /** Called when the actor is released, before it is hidden. */
+    virtual void OnDeactivated() {}
+};
+
+/** Released actors of one class, waiting to be handed out again. */
+USTRUCT()
+struct FBattleActorPoolList
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<TObjectPtr<AActor>> Actors;
+};
+
+/**
+ * @class UBattleActorPool
+ * @brief Recycles the match's units, obstacles and grid cell actors instead of destroying them.
+ *
+ * Acquire hands out a released actor of the exact class requested, or spawns one when none is
+ * free; Release parks it hidden for the next Acquire. A restarted match therefore reuses the
+ * previous match's actors, and nothing the grid spawns becomes garbage until the world ends.
+ */
+UCLASS()
+class STRATEGICNONSENSE_API UBattleActorPool : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    static UBattleActorPool* Get(const UObject* WorldContextObject);
+
+    AActor* Acquire(UClass* Class, const FTransform& Transform, TFunctionRef<void(AActor*)> Prepare);
+
+    template<typename T>
+    T* Acquire(TSubclassOf<T> Class, const FTransform& Transform)
+    {
+        return Cast<T>(Acquire(Class.Get(), Transform, [](AActor*) {}));
+    }
+
+    void Release(AActor* Actor);
+
+    int32 GetNumFree(UClass* Class) const;
+    int32 GetNumSpawned() const { return NumSpawned; }
+    int32 GetNumReused() const { return NumReused; }
+
+private:
+    UPROPERTY()
+    TMap<TObjectPtr<UClass>, FBattleActorPoolList> FreeActors;
+
+    int32 NumSpawned = 0;
+    int32 NumReused = 0;
+};
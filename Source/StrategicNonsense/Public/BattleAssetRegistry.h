@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "UnitActor.h"
+#include "BattleAssetRegistry.generated.h"
+
+class UUserWidget;
+class UDataTable;
+
+/** Widget blueprints the match shows; each maps to one class path in the registry. */
+UENUM()
+enum class EBattleWidget : uint8
+{
+    StartMessage,
+    UnitSelection,
+    GameStatus,
+    EndTurn,
+    GameOver,
+
+    Count UMETA(Hidden)
+};
+
+/**
+ * @class UBattleAssetRegistry
+ * @brief Streams the match's widget and unit blueprints in the background and hands out the cached classes.
+ *
+ * The widget classes are requested as soon as the game instance starts; the four unit classes of
+ * the chosen team colours are requested by PreloadMatchAssets while the start message is shown.
+ * Gameplay code asks for classes through GetWidgetClass and GetUnitClass, which return the cached
+ * class. A class that was not preloaded is still loaded synchronously (with a warning), so a
+ * missing preload costs a hitch rather than a broken match. Loaded classes stay referenced for
+ * the lifetime of the game instance, so later matches start warm.
+ *
+ * The unit archetype DataTable (rows of FUnitArchetypeRow) streams with the match assets and is
+ * copied into FBattleArchetypeTable by PublishUnitArchetypes. Without it the built-in Sniper and
+ * Brawler stats stay in effect.
+ */
+UCLASS()
+class STRATEGICNONSENSE_API UBattleAssetRegistry : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    static UBattleAssetRegistry* Get(const UObject* WorldContextObject);
+
+    void PreloadMatchAssets(TConstArrayView<FName> TeamColours, FSimpleDelegate OnLoaded);
+
+    TSubclassOf<UUserWidget> GetWidgetClass(EBattleWidget Widget);
+    TSubclassOf<AUnitActor> GetUnitClass(FName TeamColour, EGameUnitType UnitType);
+
+    void PublishUnitArchetypes();
+
+    static FSoftClassPath GetWidgetClassPath(EBattleWidget Widget);
+    static FSoftClassPath GetUnitClassPath(FName TeamColour, EGameUnitType UnitType);
+    static FSoftObjectPath GetUnitArchetypeTablePath();
+
+private:
+    void RequestAsyncLoad(TArray<FSoftObjectPath> Paths, FSimpleDelegate OnLoaded);
+    UClass* ResolveClass(const FSoftClassPath& Path);
+
+    FStreamableManager StreamableManager;
+
+    /** Requests still streaming; dropped once their classes are cached. */
+    TArray<TSharedPtr<FStreamableHandle>> PendingHandles;
+
+    UPROPERTY()
+    TMap<FSoftObjectPath, TObjectPtr<UClass>> LoadedClasses;
+
+    UPROPERTY()
+    TObjectPtr<UDataTable> UnitArchetypeTable;
+
+    /** Set once the archetype table was looked for and found missing, so the fallback is not retried. */
+    bool bUnitArchetypeTableMissing = false;
+};
@@ -3,6 +3,9 @@
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
 #include "CombatManager.h"
+#include "MatchRandom.h"
+#include "BattleReplay.h"
+#include <atomic>
 #include "BattleGameMode.generated.h"
 
 /**
@@ -24,6 +27,10 @@ class UCombatManager;
 class GameOverWidget;
 class UGameStatusWidget;
 class UEndTurnWidget;
+struct FBattleBoard;
+struct FBattleState;
+struct FBattleAction;
+class FBattleTranspositionTable;
 
 UENUM(BlueprintType)
 enum class EGamePhase : uint8
@@ -34,6 +41,23 @@ enum class EGamePhase : uint8
     GameOver
 };
 
+UENUM(BlueprintType)
+enum class EAIEngine : uint8
+{
+    /** Each unit walks toward the nearest cell it can attack from (RunApproachAITurn), then attacks if it can. */
+    Approach,
+    Expectiminimax,
+    MonteCarlo
+};
+
+/** One planned AI activation, bound to actors so it survives slot changes in later snapshots. */
+struct FQueuedAICommand
+{
+    TWeakObjectPtr<AUnitActor> Unit;
+    FIntPoint Destination = FIntPoint::ZeroValue;
+    TWeakObjectPtr<AUnitActor> Target;
+};
+
 USTRUCT()
 struct FUnitPlacementEntry
 {
@@ -54,6 +78,9 @@ class STRATEGICNONSENSE_API ABattleGameMode : public AGameModeBase
 public:
     ABattleGameMode();
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual bool SetPause(APlayerController* PC, FCanUnpause CanUnpauseDelegate = FCanUnpause()) override;
+    virtual bool ClearPause() override;
 
     UFUNCTION(BlueprintCallable)
     bool DoesPlayerStart() const { return bPlayerStarts; }
@@ -66,6 +93,18 @@ public:
 
     void HandleAITurn();
 
+    void CaptureBattleState(FBattleBoard& OutBoard, FBattleState& OutState, TArray<AUnitActor*>& OutSlots) const;
+
+    FMatchRandom& GetMatchRandom() { return MatchRandom; }
+
+    /** Starts the next match in this world, reusing the grid, camera and pooled actors instead of reloading the level. */
+    UFUNCTION(Exec, BlueprintCallable)
+    void RestartMatch();
+
+    void RecordReplayPlacement(const AUnitActor* Unit, const UTeam* Team);
+    void RecordReplayMove(const AUnitActor* Unit, const FIntPoint& Cell);
+    void RecordReplayAttack(const AUnitActor* Attacker, const AUnitActor* Target, int32 Damage, int32 CounterDamage);
+
 
     UPROPERTY()
     UCombatManager* CombatManager;
@@ -82,12 +121,52 @@ public:
     UPROPERTY()
     TSubclassOf<UEndTurnWidget> EndTurnWidgetClass;
 
+    UPROPERTY(EditAnywhere, Category = "AI")
+    EAIEngine AIEngine = EAIEngine::Expectiminimax;
+
+    /** Thinking time for a whole AI turn, shared between the AI's units. */
+    UPROPERTY(EditAnywhere, Category = "AI", meta = (ClampMin = "1"))
+    float AITurnBudgetMs = 250.0f;
+
+    UPROPERTY(EditAnywhere, Category = "AI", meta = (ClampMin = "1"))
+    int32 AISearchMaxDepth = 8;
+
+    /** Search trees for the Monte Carlo engine (0 = one per logical core). */
+    UPROPERTY(EditAnywhere, Category = "AI", meta = (ClampMin = "0"))
+    int32 AIMonteCarloWorkers = 0;
+
+    /** Memory for the expectiminimax transposition table, kept across turns. */
+    UPROPERTY(EditAnywhere, Category = "AI", meta = (ClampMin = "1"))
+    int32 AITranspositionTableMB = 16;
+
+    /** Delay between applying planned AI commands, so each move can be followed on screen. */
+    UPROPERTY(EditAnywhere, Category = "AI", meta = (ClampMin = "0"))
+    float AICommandInterval = 0.3f;
+
+    /** Records every match and writes it to Saved/Replays when it ends (see UBattleReplayCommandlet). */
+    UPROPERTY(EditAnywhere, Category = "Replay")
+    bool bRecordReplays = true;
+
 
 private:
     void SpawnTopDownCamera();
     void SpawnGridAndSetup();
     void SetupTeams();
     void DecideStartingPlayer();
+    void BeginMatch();
+
+    void RunApproachAITurn();
+    void StartAIPlanning();
+    void CancelAIPlanning();
+    void OnAIPlanReady(const TArray<FBattleAction>& Commands);
+    void ExecuteNextAICommand();
+    bool IsAICommandLegal(const FQueuedAICommand& Command) const;
+    void ExecuteAIAction(AUnitActor* Unit, const FIntPoint& Destination, AUnitActor* Target);
+
+    void StartReplay();
+    void SaveReplay();
+
+    void OnUnitHealthChanged(AUnitActor* Unit);
 
 private:
     EGamePhase CurrentPhase = EGamePhase::Placement;
@@ -106,6 +185,26 @@ private:
 
     bool bPlayerStarts = false;
 
+    /** Every random draw of the match; seeded in BeginPlay from -MatchSeed= or the clock. */
+    FMatchRandom MatchRandom;
+
+    /** The match so far; units are named by placement order through ReplayUnitIds. */
+    FBattleReplay Replay;
+    TMap<const AUnitActor*, uint8> ReplayUnitIds;
+    bool bReplaySaved = false;
+
+    /** Set to cancel the planning task in flight; null when no plan is pending. */
+    TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> AIPlanCancelFlag;
+
+    TSharedPtr<FBattleTranspositionTable, ESPMode::ThreadSafe> AITranspositionTable;
+
+    /** Actors behind the unit slots of the snapshot being planned on. */
+    TArray<TWeakObjectPtr<AUnitActor>> AIPlanSlots;
+
+    TArray<FQueuedAICommand> AICommandQueue;
+    FTimerHandle AICommandTimer;
+    bool bResumeAIOnUnpause = false;
+
     UPROPERTY()
     UUnitPlacementManager* UnitPlacementManager;
 
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BattleState.h"
+#include <atomic>
+
+/**
+ * @struct FBattleMCTSSettings
+ * @brief Limits for one FBattleMCTS::FindBestAction call.
+ */
+struct FBattleMCTSSettings
+{
+    /** Wall-clock budget shared by all workers. */
+    double TimeBudgetSeconds = 0.2;
+
+    /** Each worker stops after this many playouts even with time left (0 = none), so results do not depend on machine speed. */
+    int32 MaxPlayoutsPerWorker = 0;
+
+    /** Number of independent search trees (0 = one per logical core). */
+    int32 NumWorkers = 0;
+
+    /** Playouts stop after this many unit activations and are scored by remaining health. */
+    int32 MaxPlayoutPlies = 16;
+
+    /** Each worker stops growing its tree at this many nodes but keeps running playouts. */
+    int32 MaxNodesPerWorker = 100000;
+
+    /** UCB1 exploration constant. */
+    float Exploration = 0.7f;
+
+    /** Base seed; worker N uses Seed + N. */
+    int32 Seed = 0;
+
+    /** Optional flag polled between playouts; every worker stops once it is set. */
+    const std::atomic<bool>* CancelFlag = nullptr;
+};
+
+/**
+ * @struct FBattleMCTSResult
+ * @brief The chosen action plus throughput statistics.
+ */
+struct FBattleMCTSResult
+{
+    FBattleAction BestAction;
+    bool bHasAction = false;
+
+    /** Average playout reward of BestAction for the side to move, in [0, 1]. */
+    double WinRate = 0.0;
+
+    int64 Playouts = 0;
+    int32 NumWorkers = 0;
+    double Seconds = 0.0;
+    double PlayoutsPerSecond = 0.0;
+};
+
+/**
+ * @class FBattleMCTS
+ * @brief Root-parallel Monte Carlo tree search over the headless battle core.
+ *
+ * Every worker grows its own UCB1 tree from the same root on a ParallelFor task, so workers
+ * never share mutable state; their root visit counts are summed at the end and the most
+ * visited action wins. Dice are sampled per playout. Since dice only change health, and
+ * legality only depends on which units are alive, each action node keeps one child per set
+ * of surviving units instead of one per exact roll.
+ *
+ * Playouts follow the game rules (reachable cells, Manhattan range, counterattacks) with a
+ * light bias: units attack when they can and otherwise tend to close in on the enemy.
+ */
+class STRATEGICNONSENSE_API FBattleMCTS
+{
+public:
+    explicit FBattleMCTS(const FBattleBoard& InBoard);
+
+    FBattleMCTSResult FindBestAction(const FBattleState& Root, const FBattleMCTSSettings& Settings) const;
+
+private:
+    const FBattleBoard& Board;
+};
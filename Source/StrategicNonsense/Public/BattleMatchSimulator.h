@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BattleState.h"
+
+/** Who plays a side in a simulated match. */
+enum class EBattleAgent : uint8
+{
+    Random,
+    Expectiminimax,
+    MonteCarlo
+};
+
+/**
+ * @struct FBattleMatchConfig
+ * @brief Everything that defines one simulated match.
+ */
+struct FBattleMatchConfig
+{
+    int32 GridSizeX = 25;
+    int32 GridSizeY = 25;
+    float ObstaclePercentage = 10.0f;
+
+    EBattleAgent Agents[2] = { EBattleAgent::Random, EBattleAgent::Random };
+
+    /** Thinking time per unit activation for the search agents. 0 = depth-limited only (Monte Carlo then uses 20 ms). */
+    double ActionBudgetSeconds = 0.02;
+    int32 SearchMaxDepth = 3;
+
+    /**
+     * Search nodes (Expectiminimax) or playouts (Monte Carlo) per unit activation. When positive it
+     * replaces ActionBudgetSeconds for that agent, so the same seed plays the same match on any machine.
+     */
+    int64 ActionSearchNodes = 0;
+    int32 ActionPlayouts = 0;
+
+    /** The match is stopped (and reported as unfinished) after this many turns. */
+    int32 MaxTurns = 200;
+
+    /** Seeds the map, placement, coin toss, dice and agents. */
+    int32 Seed = 0;
+};
+
+/**
+ * @struct FBattleMatchReport
+ * @brief Result and statistics of one simulated match.
+ */
+struct FBattleMatchReport
+{
+    /** Ongoing if the turn limit was reached. */
+    EBattleResult Result = EBattleResult::Ongoing;
+    uint8 StartingTeam = 0;
+    int32 Turns = 0;
+    int32 Activations = 0;
+    double Seconds = 0.0;
+
+    /** Health removed by each hit, indexed by the attacking team. */
+    TArray<uint8> AttackDamage[2];
+
+    /** Health removed by each counterattack, indexed by the countering team. */
+    TArray<uint8> CounterDamage[2];
+};
+
+/**
+ * @class FBattleMatchSimulator
+ * @brief Plays complete matches on the headless core with no world, actors or timers.
+ *
+ * Follows the ABattleGameMode flow: obstacles from FGridObstacleLayout, a coin toss for the
+ * starting team, alternating random placement of each team's Sniper and Brawler, then turns
+ * until one team is wiped out. Safe to run many matches in parallel.
+ */
+class STRATEGICNONSENSE_API FBattleMatchSimulator
+{
+public:
+    static FBattleMatchReport RunMatch(const FBattleMatchConfig& Config);
+
+    static const TCHAR* GetAgentName(EBattleAgent Agent);
+    static bool ParseAgent(const FString& Name, EBattleAgent& OutAgent);
+};
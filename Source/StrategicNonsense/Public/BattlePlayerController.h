@@ -37,6 +37,9 @@ public:
     UFUNCTION()
     void HideEndTurnWidget();
 
+    /** Drops the selected unit, e.g. when a restarted match returns it to the actor pool. */
+    void ClearSelection() { SelectedUnit = nullptr; }
+
     UPROPERTY(EditDefaultsOnly, Category = "UI")
     TSubclassOf<class UEndTurnWidget> EndTurnWidgetClass;
 
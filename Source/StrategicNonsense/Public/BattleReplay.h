@@ -0,0 +1,148 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BattleState.h"
+
+class FArchive;
+
+/** Kinds of entries in a replay's command log. */
+enum class EBattleReplayCommand : uint8
+{
+    Place,
+    Move,
+    Attack,
+    EndTurn,
+
+    Count
+};
+
+/**
+ * @struct FBattleReplayCommand
+ * @brief One entry of the command log (8 bytes).
+ *
+ * Units are named by placement order, which is also their slot in the rebuilt FBattleState.
+ * Attacks carry their resolved dice, so playback never needs the random streams.
+ */
+struct FBattleReplayCommand
+{
+    EBattleReplayCommand Type = EBattleReplayCommand::EndTurn;
+
+    /** Acting unit; for Place, the slot the new unit takes. */
+    uint8 Unit = 0;
+
+    /** Place: team; Attack: target unit. */
+    uint8 Target = 0;
+
+    /** Place: archetype. */
+    uint8 Archetype = 0;
+
+    /** Place / Move: destination cell. Attack: damage dealt (X) and counter damage taken (Y). */
+    int16 X = 0;
+    int16 Y = 0;
+
+    static FBattleReplayCommand MakePlace(int32 Slot, uint8 Team, EBattleArchetype Archetype, const FIntPoint& Cell);
+    static FBattleReplayCommand MakeMove(int32 Unit, const FIntPoint& Cell);
+    static FBattleReplayCommand MakeAttack(int32 Unit, int32 Target, int32 Damage, int32 CounterDamage);
+    static FBattleReplayCommand MakeEndTurn();
+
+    friend FArchive& operator<<(FArchive& Ar, FBattleReplayCommand& Command);
+};
+
+static_assert(sizeof(FBattleReplayCommand) == 8, "FBattleReplayCommand should stay 8 bytes");
+
+/**
+ * @struct FBattleReplayArchetype
+ * @brief The stats one archetype had when the match was recorded.
+ */
+struct FBattleReplayArchetype
+{
+    uint8 ArchetypeId = 0;
+    FBattleUnitStats Stats;
+
+    friend FArchive& operator<<(FArchive& Ar, FBattleReplayArchetype& Entry);
+};
+
+/**
+ * @struct FBattleReplay
+ * @brief A recorded match: seeds, terrain, unit stats, starting side and the command log.
+ *
+ * The terrain is stored as one bit per cell rather than regenerated from the map seed, and the
+ * stats of every archetype placed are stored alongside, so a replay stays readable after the
+ * obstacle generator or the unit archetype DataTable changes. Files are little-endian and
+ * versioned; Serialize rejects unknown magic or newer versions. Version 1 files carry no stats and
+ * play back with the built-in archetypes.
+ */
+struct STRATEGICNONSENSE_API FBattleReplay
+{
+    static constexpr uint32 Magic = 0x50524E53; // "SNRP"
+    static constexpr uint16 Version = 2;
+
+    int32 MatchSeed = 0;
+    int32 StreamSeeds[3] = { 0, 0, 0 };
+    int16 GridSizeX = 0;
+    int16 GridSizeY = 0;
+    uint8 StartingTeam = 0;
+
+    /** Blocked cells, row-major, one bit per cell. */
+    TArray<uint8> Terrain;
+
+    /** Stats of the archetypes placed, one entry per archetype ID. */
+    TArray<FBattleReplayArchetype> Archetypes;
+
+    TArray<FBattleReplayCommand> Commands;
+
+    void SetTerrain(const FGridOccupancy& Occupancy);
+    bool IsTerrainBlocked(const FIntPoint& Cell) const;
+
+    void RecordArchetype(EBattleArchetype Archetype, const FBattleUnitStats& Stats);
+    bool BuildArchetypeTable(FBattleArchetypeTable& OutTable) const;
+
+    bool Serialize(FArchive& Ar);
+    bool SaveToFile(const FString& Path);
+    bool LoadFromFile(const FString& Path);
+};
+
+/**
+ * @class FBattleReplayPlayer
+ * @brief Rebuilds the headless battle state at any point of a replay without spawning actors.
+ *
+ * Initialise plays the whole log once to validate it, remembering where every turn starts and
+ * keeping a copy of the state every KeyframeInterval commands. A seek then resumes from the
+ * nearest keyframe at or before the target, so it never applies more than KeyframeInterval
+ * commands. Applying a command is a few stores into the fixed-size state; the hash is only
+ * refreshed once per seek.
+ */
+class STRATEGICNONSENSE_API FBattleReplayPlayer
+{
+public:
+    static constexpr int32 KeyframeInterval = 256;
+
+    bool Initialise(const FBattleReplay& InReplay);
+
+    const FBattleBoard& GetBoard() const { return Board; }
+    const FBattleState& GetState() const { return State; }
+
+    int32 GetNumCommands() const { return Commands.Num(); }
+    int32 GetCommandIndex() const { return CommandIndex; }
+    int32 GetNumTurns() const { return TurnStarts.Num(); }
+
+    void SeekToCommand(int32 InCommandIndex);
+    bool SeekToTurn(int32 Turn);
+    void SeekToEnd() { SeekToCommand(Commands.Num()); }
+
+    static bool ApplyCommand(const FBattleBoard& Board, FBattleState& State, const FBattleReplayCommand& Command);
+
+private:
+    FBattleBoard Board;
+    FBattleState InitialState;
+    FBattleState State;
+    int32 CommandIndex = 0;
+
+    TArray<FBattleReplayCommand> Commands;
+
+    /** State after every KeyframeInterval-th command; entry N is the state after N * KeyframeInterval commands. */
+    TArray<FBattleState> Keyframes;
+
+    /** Index of the first command of each turn. */
+    TArray<int32> TurnStarts;
+};
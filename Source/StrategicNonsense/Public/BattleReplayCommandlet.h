@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BattleReplayCommandlet.generated.h"
+
+/**
+ * @class UBattleReplayCommandlet
+ * @brief Loads a recorded match and prints the board state at a chosen turn, without spawning a world.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd StrategicNonsense.uproject -run=BattleReplay -nullrhi -unattended
+ *     -Replay=<path>.snreplay [-Turn=N]
+ *
+ * Without -Turn the final state is printed. Replays are written to Saved/Replays by
+ * ABattleGameMode when a match ends.
+ */
+UCLASS()
+class STRATEGICNONSENSE_API UBattleReplayCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UBattleReplayCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
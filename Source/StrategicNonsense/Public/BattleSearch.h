@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BattleState.h"
+#include "BattleTranspositionTable.h"
+#include <atomic>
+
+/**
+ * @struct FBattleSearchSettings
+ * @brief Limits for one FBattleSearch::FindBestAction call.
+ */
+struct FBattleSearchSettings
+{
+    /** Wall-clock budget; the deepest fully completed iteration is returned when it runs out. */
+    double TimeBudgetSeconds = 0.2;
+
+    /** Node budget, spent like the clock (0 = none). Unlike the clock, it gives the same result on any machine. */
+    int64 MaxNodes = 0;
+
+    /** Iterative deepening stops after this many plies (unit activations). */
+    int32 MaxDepth = 8;
+
+    /** Below the root, only the best-ordered actions are searched (0 = all). */
+    int32 MaxBranching = 24;
+
+    /** Optional flag polled with the clock; the search stops as if out of time once it is set. */
+    const std::atomic<bool>* CancelFlag = nullptr;
+
+    /** Optional table shared with other searches on the same board; it must outlive the search. */
+    FBattleTranspositionTable* TranspositionTable = nullptr;
+};
+
+/**
+ * @struct FBattleSearchResult
+ * @brief Outcome of a search: the chosen action and some statistics.
+ */
+struct FBattleSearchResult
+{
+    FBattleAction BestAction;
+    bool bHasAction = false;
+    int32 Score = 0;
+    int32 CompletedDepth = 0;
+    int64 NodesSearched = 0;
+
+    /** Transposition table traffic of this search alone. */
+    FBattleTranspositionTable::FStats TableStats;
+};
+
+/**
+ * @class FBattleSearch
+ * @brief Depth-limited expectiminimax with alpha-beta pruning over the headless battle core.
+ *
+ * Decision nodes alternate between the two sides as the turn passes; every attack becomes a
+ * chance node over the attacker's damage range and the 1-3 counterattack, with lethal outcomes
+ * merged. Chance nodes are pruned with Ballard's Star1 bounds, so the alpha-beta window stays
+ * useful through them. Runs under iterative deepening against a wall-clock budget and only
+ * ever touches its own state copy.
+ */
+class STRATEGICNONSENSE_API FBattleSearch
+{
+public:
+    static constexpr int32 WinScore = 100000;
+
+    explicit FBattleSearch(const FBattleBoard& InBoard);
+
+    FBattleSearchResult FindBestAction(const FBattleState& Root, const FBattleSearchSettings& Settings);
+
+    /** One distinct result of an attack's dice and its probability. */
+    struct FWeightedOutcome
+    {
+        FBattleOutcome Outcome;
+        double Probability = 0.0;
+    };
+
+    static void GetAttackOutcomes(const FBattleBoard& Board, const FBattleState& State, const FBattleAction& Action, TArray<FWeightedOutcome, TInlineAllocator<16>>& OutOutcomes);
+
+    int32 Evaluate(const FBattleState& State) const;
+
+private:
+    int32 SearchDecision(FBattleState& State, int32 Depth, int32 Alpha, int32 Beta, int32 Ply);
+    int32 SearchAction(FBattleState& State, const FBattleAction& Action, int32 Depth, int32 Alpha, int32 Beta, int32 Ply);
+    int32 ScoreTerminal(EBattleResult Result, int32 Ply) const;
+    void OrderActions(const FBattleState& State, TArray<FBattleAction>& Actions, const FBattleAction* FirstAction) const;
+    bool ShouldAbort();
+    uint64 GetTableKey(const FBattleState& State) const;
+
+    const FBattleBoard& Board;
+    FBattleScratch Scratch;
+    TArray<TArray<FBattleAction>> ActionStack;
+
+    FBattleSearchSettings ActiveSettings;
+    uint8 RootSide = 0;
+
+    /** FBattleBoard::ComputeKey of Board, mixed into every table key. */
+    uint64 BoardKey = 0;
+    double Deadline = 0.0;
+    int64 Nodes = 0;
+    bool bAborted = false;
+    FBattleTranspositionTable::FStats TableStats;
+};
@@ -0,0 +1,277 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridOccupancy.h"
+
+/**
+ * Headless battle core.
+ *
+ * Plain C++ mirror of the match rules (movement from FindReachableCellsBFS, attacks and
+ * counterattacks from UCombatManager) that runs without a UWorld or any UObject. The state is a
+ * fixed-size POD that can be copied freely, so AI search and batch simulation can explore
+ * hypothetical moves without touching live actors.
+ */
+
+/**
+ * Unit archetype IDs. The built-in values match EGameUnitType; data-driven archetypes take any
+ * further ID below FBattleArchetypeTable::MaxArchetypes.
+ */
+enum class EBattleArchetype : uint8
+{
+    Sniper = 0,
+    Brawler = 1,
+
+    NumBuiltIn
+};
+
+/**
+ * @struct FBattleUnitStats
+ * @brief Immutable per-archetype rules used by the headless core (12 bytes).
+ *
+ * Counterattacks: when a unit whose archetype provokes counters attacks a surviving target from
+ * no further than the target's CounterRange, the attacker takes CounterDamageMin..Max damage.
+ */
+struct STRATEGICNONSENSE_API FBattleUnitStats
+{
+    enum EFlags : uint8
+    {
+        Flag_ProvokesCounters = 1 << 0,
+    };
+
+    int16 MaxHealth = 0;
+    uint8 Movement = 0;
+    uint8 AttackRange = 0;
+    uint8 DamageMin = 0;
+    uint8 DamageMax = 0;
+
+    /** EAttackType value; FBattleBoard decides which attack types need line of sight. */
+    uint8 AttackType = 0;
+
+    /** Largest distance at which this unit counterattacks; 0 never counters. */
+    uint8 CounterRange = 0;
+    uint8 CounterDamageMin = 0;
+    uint8 CounterDamageMax = 0;
+    uint8 Flags = 0;
+
+    bool ProvokesCounters() const { return (Flags & Flag_ProvokesCounters) != 0; }
+    bool WouldBeCounteredBy(const FBattleUnitStats& Target, int32 Distance) const { return ProvokesCounters() && Distance <= Target.CounterRange; }
+
+    /** Stats from the active table; game thread only. Headless rules read FBattleBoard::GetStats. */
+    static const FBattleUnitStats& Get(EBattleArchetype Archetype);
+};
+
+/**
+ * @class FBattleArchetypeTable
+ * @brief Stats of every unit archetype, indexed by archetype ID.
+ *
+ * One table is active at a time. It starts as the built-in Sniper and Brawler rules, so the
+ * headless core, commandlets and tests need no assets; the game replaces it with the rows of the
+ * unit archetype DataTable.
+ *
+ * The active table is an immutable snapshot. Publish swaps in a new one instead of writing over
+ * the old, and every FBattleBoard holds the snapshot it was created with, so a search still
+ * running on a worker thread keeps reading its own rules after the game thread publishes new
+ * ones. Headless code reads stats only through its board. Publish is for the game thread and must
+ * not run while another thread calls Get or GetSnapshot (e.g. while boards are being made).
+ */
+class STRATEGICNONSENSE_API FBattleArchetypeTable
+{
+public:
+    static constexpr int32 MaxArchetypes = 64;
+
+    FBattleArchetypeTable();
+
+    int32 Num() const { return NumArchetypes; }
+    bool IsValid(int32 ArchetypeId) const { return ArchetypeId >= 0 && ArchetypeId < NumArchetypes && Stats[ArchetypeId].MaxHealth > 0; }
+    const FBattleUnitStats& operator[](int32 ArchetypeId) const { checkSlow(ArchetypeId >= 0 && ArchetypeId < MaxArchetypes); return Stats[ArchetypeId]; }
+
+    bool SetStats(int32 ArchetypeId, const FBattleUnitStats& InStats);
+
+    static const FBattleArchetypeTable& Get() { return *Active; }
+    static TSharedRef<const FBattleArchetypeTable, ESPMode::ThreadSafe> GetSnapshot() { return Active; }
+    static const FBattleArchetypeTable& GetBuiltIn();
+    static void Publish(const FBattleArchetypeTable& Table);
+
+private:
+    FBattleUnitStats Stats[MaxArchetypes];
+    int32 NumArchetypes = 0;
+
+    static TSharedRef<const FBattleArchetypeTable, ESPMode::ThreadSafe> Active;
+};
+
+static_assert(sizeof(FBattleUnitStats) == 12, "FBattleUnitStats should stay 12 bytes");
+
+FORCEINLINE const FBattleUnitStats& FBattleUnitStats::Get(EBattleArchetype Archetype)
+{
+    return FBattleArchetypeTable::Get()[static_cast<int32>(Archetype)];
+}
+
+/**
+ * @struct FBattleUnit
+ * @brief One unit slot in a battle state (8 bytes).
+ */
+struct FBattleUnit
+{
+    enum EFlags : uint8
+    {
+        Flag_Moved = 1 << 0,
+        Flag_Attacked = 1 << 1,
+    };
+
+    int16 X = 0;
+    int16 Y = 0;
+    int16 Health = 0;
+    EBattleArchetype Archetype = EBattleArchetype::Sniper;
+    uint8 Team : 1;
+    uint8 Flags : 7;
+
+    FBattleUnit() : Team(0), Flags(0) {}
+
+    FIntPoint GetCell() const { return FIntPoint(X, Y); }
+    bool IsAlive() const { return Health > 0; }
+    bool HasActed() const { return (Flags & Flag_Moved) != 0; }
+};
+
+/**
+ * @struct FBattleAction
+ * @brief One unit's activation: an optional move followed by an optional attack.
+ *
+ * Staying on the current cell with no target is a legal "wait" that still ends the unit's turn.
+ */
+struct FBattleAction
+{
+    int8 Unit = INDEX_NONE;
+    int8 Target = INDEX_NONE;
+    int16 ToX = 0;
+    int16 ToY = 0;
+
+    FIntPoint GetDestination() const { return FIntPoint(ToX, ToY); }
+    bool HasAttack() const { return Target != INDEX_NONE; }
+
+    bool operator==(const FBattleAction& Other) const
+    {
+        return Unit == Other.Unit && Target == Other.Target && ToX == Other.ToX && ToY == Other.ToY;
+    }
+};
+
+/**
+ * @struct FBattleOutcome
+ * @brief Resolved dice for an attack: damage dealt to the target and counter damage taken.
+ */
+struct FBattleOutcome
+{
+    int16 Damage = 0;
+    int16 CounterDamage = 0;
+};
+
+/** Match result as seen by the headless core. Team 0 is the first team of the match. */
+enum class EBattleResult : uint8
+{
+    Ongoing,
+    Team0Wins,
+    Team1Wins,
+    Draw
+};
+
+/**
+ * @struct FBattleBoard
+ * @brief Static terrain and unit rules shared by every state of a match (obstacles only, no units).
+ */
+struct STRATEGICNONSENSE_API FBattleBoard
+{
+    FGridOccupancy Terrain;
+
+    /** One bit per attack type (FBattleUnitStats::AttackType) that needs a clear line of sight over Terrain. */
+    uint8 LineOfSightAttackTypes = 0;
+
+    /** The archetype table active when the board was made; immutable, so copies may go to worker threads. */
+    TSharedRef<const FBattleArchetypeTable, ESPMode::ThreadSafe> Archetypes = FBattleArchetypeTable::GetSnapshot();
+
+    void InitialiseFromOccupancy(const FGridOccupancy& Occupancy);
+    uint64 ComputeKey() const;
+
+    const FBattleUnitStats& GetStats(EBattleArchetype Archetype) const { return (*Archetypes)[static_cast<int32>(Archetype)]; }
+    const FBattleUnitStats& GetStats(const FBattleUnit& Unit) const { return GetStats(Unit.Archetype); }
+
+    bool RequiresLineOfSight(EBattleArchetype Archetype) const { return (LineOfSightAttackTypes >> GetStats(Archetype).AttackType) & 1; }
+};
+
+struct FBattleUndo;
+
+/**
+ * @struct FBattleScratch
+ * @brief Reusable buffers for move generation; one per thread.
+ */
+struct STRATEGICNONSENSE_API FBattleScratch
+{
+    TArray<uint32> VisitStamp;
+    TArray<FIntPoint> Queue;
+    TArray<uint8> Distance;
+    uint32 Generation = 0;
+
+    void Prepare(int32 NumCells);
+};
+
+/**
+ * @struct FBattleState
+ * @brief Complete dynamic state of a match: unit slots, side to move and turn counter.
+ *
+ * Trivially copyable. All rule queries take the shared board for terrain and unit stats.
+ *
+ * Hash is a Zobrist key over every unit's archetype, team, cell, health and flags plus the side
+ * to move; unused slots contribute nothing. AddUnit, ApplyAction and UndoAction keep it up to
+ * date incrementally; code that writes the fields directly must call RefreshHash afterwards.
+ */
+struct STRATEGICNONSENSE_API FBattleState
+{
+    static constexpr int32 MaxUnits = 8;
+
+    FBattleUnit Units[MaxUnits];
+    uint8 NumUnits = 0;
+    uint8 SideToMove = 0;
+    uint16 TurnNumber = 0;
+    uint64 Hash = 0;
+
+    uint64 ComputeHash() const;
+    void RefreshHash() { Hash = ComputeHash(); }
+
+    int32 AddUnit(const FBattleBoard& Board, EBattleArchetype Archetype, uint8 Team, const FIntPoint& Cell);
+
+    bool IsCellFree(const FBattleBoard& Board, const FIntPoint& Cell) const;
+    int32 GetUnitAt(const FIntPoint& Cell) const;
+    bool HasLivingUnits(uint8 Team) const;
+    EBattleResult GetResult() const;
+    bool IsTerminal() const { return GetResult() != EBattleResult::Ongoing; }
+
+    int32 FindReachableCells(const FBattleBoard& Board, int32 UnitIndex, FBattleScratch& Scratch, TArray<FIntPoint>& OutCells) const;
+    void GenerateActions(const FBattleBoard& Board, FBattleScratch& Scratch, TArray<FBattleAction>& OutActions) const;
+    bool IsActionLegal(const FBattleBoard& Board, const FBattleAction& Action, FBattleScratch& Scratch) const;
+
+    static int32 GetDistance(const FIntPoint& A, const FIntPoint& B);
+    bool IsInRange(const FBattleBoard& Board, int32 AttackerIndex, const FIntPoint& From, int32 TargetIndex) const;
+    bool WouldCounterattack(const FBattleBoard& Board, int32 AttackerIndex, const FIntPoint& From, int32 TargetIndex) const;
+
+    void ApplyAction(const FBattleBoard& Board, const FBattleAction& Action, const FBattleOutcome& Outcome, FBattleUndo& OutUndo);
+    void UndoAction(const FBattleAction& Action, const FBattleUndo& Undo);
+
+private:
+    void EndTurnIfDone();
+    static uint64 GetUnitHash(int32 Slot, const FBattleUnit& Unit);
+};
+
+/**
+ * @struct FBattleUndo
+ * @brief Everything ApplyAction changes, so UndoAction can restore it exactly.
+ */
+struct FBattleUndo
+{
+    FBattleUnit Attacker;
+    FBattleUnit Target;
+    uint8 PreviousFlags[FBattleState::MaxUnits];
+    uint8 SideToMove = 0;
+    uint16 TurnNumber = 0;
+    uint64 Hash = 0;
+};
+
+static_assert(sizeof(FBattleUnit) == 8, "FBattleUnit should stay 8 bytes");
+static_assert(sizeof(FBattleState) <= 128, "FBattleState should stay small enough to copy per search node");
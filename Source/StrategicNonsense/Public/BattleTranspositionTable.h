@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BattleState.h"
+#include <atomic>
+
+/** How a stored search score relates to the true value of the position. */
+enum class EBattleBound : uint8
+{
+    None,
+    Exact,
+    Lower,
+    Upper
+};
+
+/**
+ * @struct FBattleTTEntry
+ * @brief Unpacked contents of one transposition table slot.
+ */
+struct FBattleTTEntry
+{
+    int32 Score = 0;
+    int32 Depth = 0;
+    EBattleBound Bound = EBattleBound::None;
+    bool bHasBestAction = false;
+    FBattleAction BestAction;
+};
+
+/**
+ * @class FBattleTranspositionTable
+ * @brief Fixed-size, lock-free cache of search results keyed by FBattleState::Hash.
+ *
+ * Many search threads may probe and store concurrently. Each slot is two 64-bit atomics holding
+ * the packed entry and the key XORed with it, so a slot torn by two simultaneous writers fails
+ * the key check on probe instead of returning a mixed entry.
+ *
+ * Hit statistics are batched: searches count locally and report through RecordStats, which keeps
+ * probes free of shared counter traffic.
+ */
+class STRATEGICNONSENSE_API FBattleTranspositionTable
+{
+public:
+    explicit FBattleTranspositionTable(int32 SizeMB);
+
+    bool Probe(uint64 Key, FBattleTTEntry& OutEntry) const;
+    void Store(uint64 Key, const FBattleTTEntry& Entry);
+    void Clear();
+
+    int64 GetNumEntries() const { return IndexMask + 1; }
+
+    struct FStats
+    {
+        int64 Probes = 0;
+        int64 Hits = 0;
+        int64 Stores = 0;
+
+        double GetHitRate() const { return Probes > 0 ? static_cast<double>(Hits) / Probes : 0.0; }
+    };
+
+    void RecordStats(const FStats& Delta);
+    FStats GetStats() const;
+    void ResetStats();
+
+private:
+    struct FSlot
+    {
+        std::atomic<uint64> KeyXorData{ 0 };
+        std::atomic<uint64> Data{ 0 };
+    };
+
+    static uint64 Pack(const FBattleTTEntry& Entry);
+    static FBattleTTEntry Unpack(uint64 Data);
+
+    TUniquePtr<FSlot[]> Slots;
+    uint64 IndexMask = 0;
+
+    std::atomic<int64> TotalProbes{ 0 };
+    std::atomic<int64> TotalHits{ 0 };
+    std::atomic<int64> TotalStores{ 0 };
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BattleState.h"
+
+/**
+ * @class FBattleUnitRegistry
+ * @brief Per-match unit table stored as parallel arrays, with a cell-to-unit index.
+ *
+ * Each placed unit gets an ID that indexes every array (cell, health, team, flags, archetype)
+ * for the rest of the match; dead units keep their ID with zero health. Ownership, the unit on
+ * a cell, living-unit counts and "has this team finished its turn" are all O(1), so game-side
+ * queries no longer walk team lists and dereference every actor. Unit actors mirror their entry
+ * for rendering and write through to it when their state changes.
+ *
+ * Plain C++ with no UObject references; the grid manager owns one and keeps its actor array in
+ * step with the IDs.
+ */
+class STRATEGICNONSENSE_API FBattleUnitRegistry
+{
+public:
+    static constexpr int32 MaxTeams = 2;
+    static constexpr uint8 NoTeam = MAX_uint8;
+
+    void Initialise(int32 InWidth, int32 InHeight);
+
+    int32 AddUnit(EBattleArchetype Archetype, const FIntPoint& Cell);
+
+    int32 Num() const { return Cells.Num(); }
+    bool IsValidUnit(int32 Unit) const { return Cells.IsValidIndex(Unit); }
+
+    FIntPoint GetCell(int32 Unit) const { return Cells[Unit]; }
+    int32 GetHealth(int32 Unit) const { return Health[Unit]; }
+    uint8 GetTeam(int32 Unit) const { return Teams[Unit]; }
+    uint8 GetFlags(int32 Unit) const { return Flags[Unit]; }
+    EBattleArchetype GetArchetype(int32 Unit) const { return Archetypes[Unit]; }
+    bool IsAlive(int32 Unit) const { return Health[Unit] > 0; }
+    bool IsOwnedBy(int32 Unit, uint8 Team) const { return IsValidUnit(Unit) && Teams[Unit] == Team; }
+
+    int32 GetUnitAt(const FIntPoint& Cell) const;
+    TConstArrayView<int32> GetTeamUnits(uint8 Team) const { return TeamUnits[Team]; }
+    int32 GetNumLiving(uint8 Team) const { return NumLiving[Team]; }
+    bool HasTeamFinishedTurn(uint8 Team) const { return NumToAct[Team] == 0; }
+
+    void SetTeam(int32 Unit, uint8 Team);
+    void SetCell(int32 Unit, const FIntPoint& Cell);
+    void ClearCell(const FIntPoint& Cell);
+    void SetHealth(int32 Unit, int32 InHealth);
+    void SetFlags(int32 Unit, uint8 InFlags);
+    void ResetTeamForNewTurn(uint8 Team);
+
+private:
+    bool IsValidCell(const FIntPoint& Cell) const { return Cell.X >= 0 && Cell.Y >= 0 && Cell.X < Width && Cell.Y < Height; }
+    bool NeedsToAct(int32 Unit) const { return Health[Unit] > 0 && (Flags[Unit] & FBattleUnit::Flag_Moved) == 0; }
+    void RemoveFromCounts(int32 Unit);
+    void AddToCounts(int32 Unit);
+
+    // One entry per unit, indexed by unit ID
+    TArray<FIntPoint> Cells;
+    TArray<int16> Health;
+    TArray<uint8> Teams;
+    TArray<uint8> Flags;
+    TArray<EBattleArchetype> Archetypes;
+
+    /** Unit IDs per team, in the order they joined it. */
+    TArray<int32> TeamUnits[MaxTeams];
+
+    int32 NumLiving[MaxTeams] = {};
+
+    /** Living units per team that have not moved this turn. */
+    int32 NumToAct[MaxTeams] = {};
+
+    /** Unit ID standing on each cell (row-major), or INDEX_NONE. */
+    TArray<int32> CellUnits;
+    int32 Width = 0;
+    int32 Height = 0;
+};
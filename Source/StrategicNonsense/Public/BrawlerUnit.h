@@ -6,9 +6,9 @@
 
 /**
  * @class  ABrawlerUnit
- * @brief Specialised unit type with distinct movement and attack capabilities.
+ * @brief The built-in Brawler archetype (melee).
  *
- * - Brawler: 6 movement, 1 range, 16 damage, 40 HP.
+ * Stats come from FBattleArchetypeTable; the class only selects the archetype.
  */
 
 
@@ -19,7 +19,4 @@ class STRATEGICNONSENSE_API ABrawlerUnit : public AUnitActor
 
 public:
     ABrawlerUnit();
-
-    virtual int32 GetMovementRange() const override { return 6; }
-
 };
@@ -18,6 +18,7 @@
 class AUnitActor;
 class AGridManager;
 class ABattleGameMode;
+struct FRandomStream;
 
 
 UCLASS()
@@ -26,7 +27,7 @@ class STRATEGICNONSENSE_API UCombatManager : public UObject
     GENERATED_BODY()
 
 public:
-    void Initialise(AGridManager* Grid);
+    void Initialise(AGridManager* Grid, FRandomStream& InCombatStream);
     bool ExecuteAttack(AUnitActor* Attacker, AUnitActor* Target);
 
     UPROPERTY()
@@ -36,6 +37,9 @@ public:
 private:
     AGridManager* GridManager;
 
+    /** Damage and counterattack rolls; owned by whoever owns the match (see FMatchRandom). */
+    FRandomStream* CombatStream = nullptr;
+
     bool IsInRange(AUnitActor* Attacker, AUnitActor* Target) const;
     void HandleCounterattack(AUnitActor* Attacker, AUnitActor* Target);
     void RemoveUnitIfDead(AUnitActor* Unit);
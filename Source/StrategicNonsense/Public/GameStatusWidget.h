@@ -12,6 +12,10 @@
  *
  * Shows current player turn, remaining health per unit.
  * Helps players keep track of the game state visually.
+ *
+ * The setters only queue values. Once per frame the widget writes the rows whose queued value
+ * differs from the one on screen, so a burst of updates (an attack, its counter and a death)
+ * costs one SetText per changed row, and repeating an unchanged value costs nothing.
  */
 
 
@@ -30,6 +34,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "UI")
     void SetTurnText(const FString& TurnDescription);
 
+    /** Writes the queued rows now instead of on the next tick. */
+    void FlushPendingUpdates();
+
 
 protected:
     UPROPERTY(meta = (BindWidget))
@@ -52,5 +59,33 @@ protected:
 
     UPROPERTY(meta = (BindWidget))
     class UTextBlock* Turntext;
+
+    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+private:
+    /** Health numbers of one row; INDEX_NONE until first set. */
+    struct FHealthRow
+    {
+        int32 Current = INDEX_NONE;
+        int32 Max = INDEX_NONE;
+    };
+
+    static constexpr int32 NumHealthRows = 4;
+    static int32 GetHealthRow(bool bIsTeam1, EGameUnitType UnitType);
+
+    // Bits of DirtyRows: one per health row, one per team row, one for the turn
+    static constexpr uint32 HealthDirtyBit = 1 << 0;
+    static constexpr uint32 TeamInfoDirtyBit = 1 << NumHealthRows;
+    static constexpr uint32 TurnDirtyBit = 1 << (NumHealthRows + 2);
+
+    FHealthRow PendingHealth[NumHealthRows];
+    FHealthRow ShownHealth[NumHealthRows];
+    FString PendingTeamInfo[2];
+    FString ShownTeamInfo[2];
+    FString PendingTurn;
+    FString ShownTurn;
+
+    /** Rows queued since the last flush. */
+    uint32 DirtyRows = 0;
 };
 
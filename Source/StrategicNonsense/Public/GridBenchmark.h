@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Per-call timings and heap allocations of one function at one grid size and density. */
+struct STRATEGICNONSENSE_API FGridBenchmarkResult
+{
+    FString Name;
+    int32 GridSize = 0;
+    int32 Density = 0;
+    TArray<double> Microseconds;
+    uint64 Allocations = 0;
+
+    double GetAllocationsPerCall() const { return Microseconds.IsEmpty() ? 0.0 : static_cast<double>(Allocations) / Microseconds.Num(); }
+
+    FString GetKey() const { return FString::Printf(TEXT("%s/%d/%d"), *Name, GridSize, Density); }
+
+    double GetPercentile(double Fraction) const;
+    double GetMean() const;
+};
+
+/** Median time and allocations per call from a previous report. */
+struct FGridBenchmarkBaseline
+{
+    double MedianUs = 0.0;
+    double AllocationsPerCall = 0.0;
+};
+
+/**
+ * @class FGridBenchmark
+ * @brief Times the grid, pathfinding and combat hot paths for one grid size and obstacle density.
+ *
+ * Shared by UGridBenchmarkCommandlet and the StrategicNonsense.Perf automation tests, so both
+ * measure the same calls and write the same JSON report. Each configuration gets a fresh
+ * AGridManager in a transient world; the caller brackets runs with Begin/EndAllocationCounting to
+ * count heap allocations through a GMalloc proxy.
+ */
+class STRATEGICNONSENSE_API FGridBenchmark
+{
+public:
+    static constexpr int32 DefaultNumSamples = 200;
+    static constexpr float DefaultTolerance = 0.25f;
+
+    static TArray<int32> GetDefaultSizes() { return { 25, 64, 128, 256, 512 }; }
+    static TArray<int32> GetDefaultDensities() { return { 0, 10, 20, 30, 40 }; }
+
+    static void BeginAllocationCounting();
+    static void EndAllocationCounting();
+
+    static void RunConfiguration(int32 GridSize, int32 Density, int32 NumSamples, int32 Seed, TArray<FGridBenchmarkResult>& OutResults);
+
+    static bool SaveReport(const TArray<FGridBenchmarkResult>& Results, const FString& Label, int32 Seed, const FString& Path);
+    static bool LoadBaseline(const FString& Path, TMap<FString, FGridBenchmarkBaseline>& OutEntries);
+
+    static int32 FindRegressions(const TArray<FGridBenchmarkResult>& Results, const TMap<FString, FGridBenchmarkBaseline>& Baseline,
+        float Tolerance, TArray<FString>& OutMessages);
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GridBenchmarkCommandlet.generated.h"
+
+/**
+ * @class UGridBenchmarkCommandlet
+ * @brief Times the grid, pathfinding and combat hot paths across grid sizes and obstacle densities.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd StrategicNonsense.uproject -run=GridBenchmark -nullrhi -unattended
+ *     [-Sizes=25,64,128,256,512] [-Densities=0,10,20,30,40] [-Samples=200] [-Seed=0]
+ *     [-Label=<commit>] [-Output=<path>.json] [-Baseline=<path>.json] [-Tolerance=0.25]
+ *
+ * Each size/density pair gets a fresh AGridManager in a transient world (see FGridBenchmark).
+ * Results (min, median, mean and p95 in microseconds per call, plus heap allocations per call
+ * counted through a GMalloc proxy) are written as JSON. With -Baseline, any benchmark whose median
+ * is slower than the baseline by more than Tolerance, or that allocates more, fails the run (exit
+ * code 2).
+ *
+ * The same measurements run as automation tests, one per size/density pair:
+ *   UnrealEditor-Cmd StrategicNonsense.uproject -nullrhi -unattended
+ *     -ExecCmds="Automation RunTests StrategicNonsense.Perf; Quit"
+ */
+UCLASS()
+class STRATEGICNONSENSE_API UGridBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGridBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
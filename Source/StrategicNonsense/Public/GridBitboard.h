@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGridOccupancy;
+
+/**
+ * @class FGridBitboard
+ * @brief Bit-parallel flood fills over FGridOccupancy's row-padded blocked words.
+ *
+ * A grid row fits in one or a few 64-bit words, so one BFS layer is a dilation: shift each word
+ * left and right by one (carrying across word boundaries), OR in the rows above and below, and
+ * AND with the free-cell mask. Each word op covers 64 cells, and the word loops use AVX2, SSE2 or
+ * NEON, chosen at compile time (scalar otherwise).
+ *
+ * - Range queries dilate layer by layer inside the bounding box of the range diamond, so each
+ *   newly set bit is exactly one layer further out.
+ * - Connectivity fills whole horizontal runs at once (a Kogge-Stone fill per word) and sweeps the
+ *   rows down and up until nothing changes, so the number of passes follows how often paths turn
+ *   back rather than how long they are.
+ *
+ * Scratch rows carry a zero word at each end and the scratch grids a zero row at the top and
+ * bottom, so neighbour reads never need bounds checks. Buffers are reused between queries.
+ */
+class STRATEGICNONSENSE_API FGridBitboard
+{
+public:
+    int32 FindReachableMask(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, TArrayView<uint64> OutMask);
+    int32 FindReachableCells(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, TArrayView<FIntPoint> OutCells);
+    int32 FindReachableCells(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, TArrayView<FIntPoint> OutCells, TArrayView<uint16> OutDistances);
+
+    bool AreCellsConnected(const FGridOccupancy& Occupancy, TConstArrayView<FIntPoint> ExtraBlocked, TConstArrayView<FIntPoint> Cells);
+
+    /** Name of the instruction set the word loops were compiled for. */
+    static const TCHAR* GetBackendName();
+
+private:
+    template <typename VisitorType>
+    int32 Dilate(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, VisitorType&& Visitor);
+
+    /** Bounding box of the current range query, in occupancy rows and words. */
+    int32 BoxFirstRow = 0;
+    int32 BoxFirstWord = 0;
+    int32 BoxStride = 0;
+
+    TArray<uint64> Free;
+    TArray<uint64> Visited;
+    TArray<uint64> Frontier;
+    TArray<uint64> Next;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridBitboard.h"
+
+struct FGridOccupancy;
+
+/**
+ * @class FGridConnectivity
+ * @brief Answers "would blocking this footprint split the free region?" without flooding the grid.
+ *
+ * Assumes the free cells are currently one connected region (the invariant PlaceObstacles keeps).
+ * Any path broken by the footprint must enter and leave it through the free cells bordering it,
+ * so the region stays connected exactly when those border cells can still reach each other.
+ * The check runs one BFS per border cell in lockstep, merging searches that meet through a
+ * small union-find; it stops as soon as every search has merged (connected) or one group
+ * runs out of cells to expand (that group is sealed off). The cost is proportional to the
+ * smaller side of a cut rather than to the grid size.
+ *
+ * When both sides of a cut are large (a long wall across an open map) the searches can expand a
+ * sizeable part of the grid. Past an expansion budget the check switches to one FGridBitboard
+ * flood fill from the border cells, which costs a fixed number of word passes over the grid.
+ *
+ * Scratch buffers are owned by the checker and reused between queries.
+ */
+class STRATEGICNONSENSE_API FGridConnectivity
+{
+public:
+    bool WouldDisconnect(const FGridOccupancy& Occupancy, TConstArrayView<FIntPoint> Footprint);
+
+private:
+    /** Cell expansions before switching to the bitboard fill: NumCells / ExpansionBudgetDivisor, at least MinExpansionBudget. */
+    static constexpr int32 ExpansionBudgetDivisor = 64;
+    static constexpr int32 MinExpansionBudget = 256;
+
+    void PrepareScratch(int32 NumCells);
+    bool IsOpen(const FGridOccupancy& Occupancy, const FIntPoint& Cell) const;
+    int32 FindGroup(int32 Seed);
+
+    /** Stamp value marking cells touched by the current query; bumped per query. */
+    uint32 Generation = 0;
+
+    TArray<uint32> FootprintStamp;
+    TArray<uint32> OwnerStamp;
+    TArray<int32> Owner;
+
+    TArray<TArray<FIntPoint>> SeedQueues;
+    TArray<int32> SeedHeads;
+    TArray<int32> GroupParent;
+    TArray<int32> GroupActiveQueues;
+
+    FGridBitboard Bitboard;
+    TArray<FIntPoint> SeedCells;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGridOccupancy;
+
+/**
+ * @class FGridDistanceField
+ * @brief Steps from every cell to the nearest of a set of source cells (a "Dijkstra map").
+ *
+ * One multi-source BFS answers "how far is the nearest enemy" or "how far is the nearest cell I
+ * can attack from" for every cell at once, so all AI units in a turn can share one field instead
+ * of pathfinding to each target. Distances are stored in a flat row-major int16 array.
+ *
+ * Free cells carry their distance; blocked cells carry Unreachable unless they are sources (enemy
+ * units stand on their own cells, so sources may be blocked). An optional Blocked mask, in the
+ * occupancy's word layout, blocks further cells for this field only (e.g. cells the caller wants
+ * to route around); it is fixed until the next Compute. GetDistance treats a blocked cell as
+ * one step beyond its best free neighbour, which is what a unit asking about its own cell wants.
+ *
+ * The field tracks changes incrementally. After a cell's blocked state or a source changes, only
+ * the region whose shortest paths went through it is repaired:
+ * - Raise: cells that lost their only support one step closer are invalidated, in order of old distance.
+ * - Lower: the invalidated cells and the changed cells are re-seeded from their valid neighbours
+ *   and relaxed outward with a small heap.
+ * The cost follows the size of the affected region, not the grid.
+ *
+ * Distances saturate below Unreachable (32767 steps). Up to MaxSourceCopies copies of one source
+ * cell are counted; further copies are ignored. Scratch buffers are reused between updates.
+ */
+class STRATEGICNONSENSE_API FGridDistanceField
+{
+public:
+    static constexpr int16 Unreachable = MAX_int16;
+    static constexpr uint16 MaxSourceCopies = MAX_uint16;
+
+    void Compute(const FGridOccupancy& Occupancy, TConstArrayView<FIntPoint> InSources, TConstArrayView<uint64> InBlocked = {});
+    void Recompute(const FGridOccupancy& Occupancy);
+
+    void OnCellChanged(const FGridOccupancy& Occupancy, const FIntPoint& Cell);
+    void AddSource(const FGridOccupancy& Occupancy, const FIntPoint& Cell);
+    void RemoveSource(const FGridOccupancy& Occupancy, const FIntPoint& Cell);
+    void MoveSource(const FGridOccupancy& Occupancy, const FIntPoint& From, const FIntPoint& To);
+
+    int32 GetDistance(const FGridOccupancy& Occupancy, const FIntPoint& Cell) const;
+
+    /** Raw row-major distances; Unreachable for blocked non-source cells and cells no source reaches. */
+    TConstArrayView<int16> GetDistances() const { return Distances; }
+    TConstArrayView<FIntPoint> GetSources() const { return Sources; }
+
+    /** Cells whose distance was recomputed by the last incremental update, for profiling. */
+    int32 GetLastNumRepaired() const { return LastNumRepaired; }
+
+private:
+    bool IsPassable(const FGridOccupancy& Occupancy, int32 Index) const;
+    bool IsMasked(int32 Index) const;
+    void Repair(const FGridOccupancy& Occupancy, int32 ChangedIndex);
+
+    static uint64 MakeHeapKey(int32 Distance, int32 Index) { return (static_cast<uint64>(Distance) << 32) | static_cast<uint32>(Index); }
+
+    int32 Width = 0;
+    int32 Height = 0;
+
+    TArray<int16> Distances;
+    TArray<uint16> SourceCounts;
+    TArray<FIntPoint> Sources;
+
+    /** Extra blocked cells in FGridOccupancy's word layout; empty when Compute was given no mask. */
+    TArray<uint64> BlockedMask;
+    int32 WordsPerRow = 0;
+
+    int32 LastNumRepaired = 0;
+
+    /** Stamp value marking cells invalidated by the current repair; bumped per repair. */
+    uint32 Generation = 0;
+    TArray<uint32> InvalidStamp;
+    TArray<int32> Invalidated;
+    TArray<int32> Queue;
+    TArray<uint64> Heap;
+};
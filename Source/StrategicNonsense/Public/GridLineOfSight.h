@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGridOccupancy;
+
+/**
+ * @class FGridLineOfSight
+ * @brief Line-of-sight tests between cell centres, with a per-cell cache of visible cells.
+ *
+ * A line is blocked when it passes through a blocked cell of the blocker layer (obstacles only;
+ * units do not block sight). TraceLine walks the supercover of the segment, i.e. every cell the
+ * segment touches, so a shot cannot slip diagonally through a wall. Where the segment passes
+ * exactly through a cell corner it is only blocked if both cells beside the corner are blocked.
+ * The walk is symmetric: A sees B exactly when B sees A.
+ *
+ * The cache holds, for recently used source cells, one bit per cell of the diamond of radius
+ * CachedRange around the source, so repeated "can A shoot B" checks within that range are a
+ * single bit read. Slots are direct-mapped by source cell; a collision rebuilds the slot. Lines
+ * never leave the bounding box of their endpoints, so a blocker change only affects sources
+ * within CachedRange of it; the owner reports changes through InvalidateCell or InvalidateAll.
+ * Queries beyond CachedRange trace the line directly.
+ */
+class STRATEGICNONSENSE_API FGridLineOfSight
+{
+public:
+    static constexpr int32 NumSlots = 1024;
+
+    void SetCachedRange(int32 InCachedRange);
+    int32 GetCachedRange() const { return CachedRange; }
+
+    bool HasLineOfSight(const FGridOccupancy& Blockers, const FIntPoint& From, const FIntPoint& To);
+
+    void InvalidateCell(const FIntPoint& Cell);
+    void InvalidateAll();
+
+    uint64 GetNumHits() const { return NumHits; }
+    uint64 GetNumMisses() const { return NumMisses; }
+
+    static bool TraceLine(const FGridOccupancy& Blockers, const FIntPoint& From, const FIntPoint& To);
+
+private:
+    void BuildSlot(const FGridOccupancy& Blockers, int32 Slot, const FIntPoint& Source);
+
+    static int32 GetSlot(int32 CellIndex) { return static_cast<int32>((static_cast<uint32>(CellIndex) * 2654435761u) >> 22); }
+
+    int32 CachedRange = 0;
+
+    /** Words per row of a slot's (2 * CachedRange + 1)^2 bounding box. */
+    int32 SlotWordsPerRow = 0;
+
+    /** Source cell of each slot, FIntPoint::NoneValue when empty. */
+    TArray<FIntPoint> SlotSources;
+    TArray<uint64> SlotBits;
+
+    uint64 NumHits = 0;
+    uint64 NumMisses = 0;
+};
@@ -2,6 +2,16 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "GridOccupancy.h"
+#include "GridConnectivity.h"
+#include "GridDistanceField.h"
+#include "GridLineOfSight.h"
+#include "GridPathfinder.h"
+#include "GridBitboard.h"
+#include "GridReachability.h"
+#include "GridReachabilityCache.h"
+#include "BattleUnitRegistry.h"
+#include "UnitActor.h"
 #include "GridManager.generated.h"
 
 /**
@@ -9,10 +19,15 @@
  * @brief Manages the game grid and unit occupancy.
  *
  * Initializes the 25x25 grid with labelled cells (A1Y25).
- * Tracks occupied cells, retrieves random free positions, and supports obstacle generation.
+ * Tracks occupied cells in a flat row-major occupancy layer, retrieves random free positions,
+ * and supports obstacle generation.
  */
 
 
+class UHierarchicalInstancedStaticMeshComponent;
+class UStaticMesh;
+class UMaterialInterface;
+
 UCLASS()
 class STRATEGICNONSENSE_API AGridManager : public AActor
 {
@@ -25,22 +40,49 @@ public:
     void GenerateGrid();
 
     UFUNCTION(BlueprintCallable)
-    void PlaceObstacles();
+    void PlaceObstacles(UPARAM(ref) FRandomStream& Stream);
 
     void SetBlueprints();
 
     bool TryPlaceUnitAtLocation(const FVector& ClickLocation, TSubclassOf<class AUnitActor> UnitToPlace);
 
     UFUNCTION(BlueprintCallable)
-    bool GetRandomValidPlacementLocation(FVector& OutLocation);
+    bool GetRandomValidPlacementLocation(FVector& OutLocation, UPARAM(ref) FRandomStream& Stream);
     FIntPoint WorldToGrid(const FVector& Location) const;
     FVector GridToWorld(const FIntPoint& Cell) const;
 
 
     bool IsCellWalkable(const FIntPoint& Cell) const;
     void SetUnitAtCell(const FIntPoint& Cell, class AUnitActor* Unit);
+    AUnitActor* GetUnitAtCell(const FIntPoint& Cell) const;
+
+    const FGridOccupancy& GetOccupancy() const { return Occupancy; }
+    const FBattleUnitRegistry& GetUnitRegistry() const { return UnitRegistry; }
+    AUnitActor* GetRegisteredUnit(int32 UnitId) const { return PlacedUnits.IsValidIndex(UnitId) ? PlacedUnits[UnitId] : nullptr; }
+    void ResetTeamForNewTurn(uint8 Team);
+
+    /** Overrides the editor-set size and density for managers spawned without a map; applies from the next GenerateGrid / PlaceObstacles. */
+    void SetGridSize(int32 InGridSizeX, int32 InGridSizeY) { GridSizeX = InGridSizeX; GridSizeY = InGridSizeY; }
+    void SetObstaclePercentage(float InObstaclePercentage) { ObstaclePercentage = InObstaclePercentage; }
+
+    bool IsUsingInstancedCells() const { return bInstancedCellsActive; }
+    void SetCellHighlight(const FIntPoint& Cell, float Highlight);
+    void SetCellColour(const FIntPoint& Cell, const FLinearColor& Colour);
+    void ClearCellHighlights();
 
     TSet<FIntPoint> FindReachableCellsBFS(FIntPoint StartCell, int32 MaxRange) const;
+    int32 FindReachableCells(const FIntPoint& StartCell, int32 MaxRange, TArrayView<FIntPoint> OutCells) const;
+    int32 FindReachableMask(const FIntPoint& StartCell, int32 MaxRange, TArrayView<uint64> OutMask) const;
+    TConstArrayView<FIntPoint> GetReachableCells(const FIntPoint& StartCell, int32 MaxRange) const;
+    int32 GetReachableDistance(const FIntPoint& StartCell, int32 MaxRange, const FIntPoint& Cell) const;
+    bool FindPath(const FIntPoint& StartCell, const FIntPoint& GoalCell, int32 MaxCost, TArray<FIntPoint>& OutPath) const;
+    TSharedRef<FGridDistanceField> ComputeDistanceField(TConstArrayView<FIntPoint> Sources, TConstArrayView<uint64> Blocked = {});
+    TSharedRef<FGridDistanceField> ComputeAttackPositionField(TConstArrayView<FIntPoint> Targets, int32 AttackRange, EAttackType AttackType, TConstArrayView<uint64> Blocked = {});
+
+    bool RequiresLineOfSight(EAttackType AttackType) const { return LineOfSightAttackTypes.Contains(AttackType); }
+    bool HasLineOfSight(const FIntPoint& From, const FIntPoint& To) const;
+    bool CanAttackFrom(const AUnitActor* Attacker, const FIntPoint& From, const FIntPoint& TargetCell) const;
+    const FGridOccupancy& GetSightBlockers() const { return SightBlockers; }
 
     AUnitActor* SpawnAndPlaceUnit(const FIntPoint& GridCoord, TSubclassOf<AUnitActor> UnitClass);
 
@@ -58,11 +100,80 @@ private:
     UPROPERTY(EditAnywhere, Category = "Grid")
     float CellSize = 100.0f;
 
+    /** Grids with more cells than this are drawn as mesh instances instead of one BP_GridCell actor per cell. 0 = always instanced. */
+    UPROPERTY(EditAnywhere, Category = "Grid|Rendering")
+    int32 InstancedCellThreshold = 2500;
+
+    /** Fraction of CellSize covered by each instanced cell, leaving a visible gap between cells. */
+    UPROPERTY(EditAnywhere, Category = "Grid|Rendering")
+    float InstancedCellScale = 0.95f;
+
+    /** Mesh for instanced cells; must span 100x100 units in XY like the engine plane. */
+    UPROPERTY(EditAnywhere, Category = "Grid|Rendering")
+    UStaticMesh* CellMesh;
+
+    /** Material for instanced cells. Reads PerInstanceCustomData 0 (highlight) and 1-3 (RGB colour). */
+    UPROPERTY(EditAnywhere, Category = "Grid|Rendering")
+    UMaterialInterface* CellMaterial;
+
+    UPROPERTY(VisibleAnywhere, Category = "Grid|Rendering")
+    UHierarchicalInstancedStaticMeshComponent* CellInstances;
+
     UPROPERTY(EditAnywhere, Category = "Obstacles")
     float ObstaclePercentage = 10.0f;
 
+    /** Attack types whose shots obstacles block. Empty keeps the documented rules, where snipers shoot over obstacles. */
+    UPROPERTY(EditAnywhere, Category = "Combat")
+    TArray<EAttackType> LineOfSightAttackTypes;
+
+    /** Radius of the cached per-cell visibility sets; longer lines are traced on demand. Usually the longest attack range. */
+    UPROPERTY(EditAnywhere, Category = "Combat")
+    int32 LineOfSightCacheRange = 10;
+
     bool IsCellValid(const FIntPoint& Cell) const;
-    TSet<FIntPoint> OccupiedCells;
+    void GenerateInstancedCells();
+    void GenerateCellActors();
+    void ReleaseMatchActors();
+    void BlockCell(const FIntPoint& Cell, AUnitActor* Unit);
+    int32 RegisterUnit(AUnitActor* Unit, const FIntPoint& Cell);
+    void SetCellBlocked(const FIntPoint& Cell, bool bBlocked);
+    void RecomputeDistanceFields();
+    void RebuildSightBlockers();
+
+    FGridOccupancy Occupancy;
+    FGridConnectivity Connectivity;
+
+    /** Every unit placed this match; IDs index PlacedUnits as well. */
+    FBattleUnitRegistry UnitRegistry;
+
+    /** Scratch for FindPath; mutable because queries only reuse its buffers. Game thread only. */
+    mutable FGridPathfinder Pathfinder;
+
+    /** Scratch for the uncached reachability queries; mutable for the same reason. Game thread only. */
+    mutable FGridBitboard Bitboard;
+
+    /** Recent reachability results; SetCellBlocked invalidates the entries a change can affect. */
+    mutable FGridReachabilityCache ReachabilityCache;
+
+    /** Obstacle cells only; units do not block sight. */
+    FGridOccupancy SightBlockers;
+
+    /** Cached visibility sets over SightBlockers; mutable because queries only fill the cache. Game thread only. */
+    mutable FGridLineOfSight LineOfSight;
+
+    /** Distance fields handed out by ComputeDistanceField, repaired by SetCellBlocked while their owners keep them alive. */
+    TArray<TWeakPtr<FGridDistanceField>> TrackedDistanceFields;
+
+    /** Actor of each unit in UnitRegistry, indexed by unit ID; also the occupancy layer's cell-to-unit indices. */
+    UPROPERTY()
+    TArray<AUnitActor*> PlacedUnits;
+
+    /** Pooled actors spawned for the current grid; returned to the pool when the grid is regenerated. */
+    UPROPERTY()
+    TArray<AActor*> CellActors;
+
+    UPROPERTY()
+    TArray<AActor*> ObstacleActors;
 
     UPROPERTY()
     TSubclassOf<AGridManager> GridManagerClass;
@@ -79,6 +190,6 @@ private:
     UPROPERTY()
     TSubclassOf<AActor> BP_Mountain;
 
-    bool WouldBlockConnectivity(const TArray<FIntPoint>& ProposedObstacle);
+    bool bInstancedCellsActive = false;
 
 };
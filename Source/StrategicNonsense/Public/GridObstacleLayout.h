@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGridOccupancy;
+struct FRandomStream;
+class FGridConnectivity;
+
+/** Obstacle kinds placed by AGridManager::PlaceObstacles. */
+enum class EGridObstacleType : uint8
+{
+    Mountain,
+    Tree1,
+    Tree2,
+
+    Count
+};
+
+/**
+ * @struct FGridObstacle
+ * @brief One placed obstacle: its kind, its bounding box origin and size in cells.
+ */
+struct FGridObstacle
+{
+    EGridObstacleType Type = EGridObstacleType::Tree1;
+    FIntPoint Origin = FIntPoint::ZeroValue;
+    FIntPoint Size = FIntPoint(1, 1);
+};
+
+/**
+ * @class FGridObstacleLayout
+ * @brief World-free obstacle generation, shared by the grid manager and headless simulations.
+ *
+ * Fills the occupancy layer up to a percentage of blocked cells with mountains and trees, never
+ * splitting the free region, and reports what was placed so the caller can spawn visuals.
+ */
+class STRATEGICNONSENSE_API FGridObstacleLayout
+{
+public:
+    static void Generate(FGridOccupancy& Occupancy, FGridConnectivity& Connectivity, float ObstaclePercentage,
+        FRandomStream& Stream, TArray<FGridObstacle>& OutObstacles);
+
+    static FIntPoint GetSize(EGridObstacleType Type);
+    static TConstArrayView<FIntPoint> GetMountainShape();
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @struct FGridOccupancy
+ * @brief Dense, row-major occupancy layer for the game grid.
+ *
+ * Stores blocked cells as a bitset (one row per run of 64-bit words) and a compact
+ * cell-to-unit index array. Replaces hashed point sets so that grid queries are
+ * plain array reads and neighbour scans stay within a few cache lines.
+ */
+struct STRATEGICNONSENSE_API FGridOccupancy
+{
+public:
+    void Initialise(int32 InWidth, int32 InHeight);
+    void Reset();
+
+    int32 GetWidth() const { return Width; }
+    int32 GetHeight() const { return Height; }
+    int32 GetNumCells() const { return Width * Height; }
+    int32 GetNumBlocked() const { return NumBlocked; }
+    int32 GetNumFree() const { return Width * Height - NumBlocked; }
+    int32 GetWordsPerRow() const { return WordsPerRow; }
+
+    bool IsValidCell(const FIntPoint& Cell) const
+    {
+        return Cell.X >= 0 && Cell.X < Width && Cell.Y >= 0 && Cell.Y < Height;
+    }
+
+    int32 ToIndex(const FIntPoint& Cell) const { return Cell.Y * Width + Cell.X; }
+    FIntPoint ToCell(int32 Index) const { return FIntPoint(Index % Width, Index / Width); }
+
+    /** Cell must be valid. */
+    bool IsBlocked(const FIntPoint& Cell) const
+    {
+        return (BlockedWords[Cell.Y * WordsPerRow + (Cell.X >> 6)] >> (Cell.X & 63)) & 1ull;
+    }
+
+    bool IsBlockedIndex(int32 Index) const { return IsBlocked(ToCell(Index)); }
+
+    void SetBlocked(const FIntPoint& Cell, bool bBlocked);
+
+    int32 GetUnitIndex(const FIntPoint& Cell) const { return CellUnits[ToIndex(Cell)]; }
+    void SetUnitIndex(const FIntPoint& Cell, int32 UnitIndex);
+
+    /** Row-padded blocked words; bits past Width in the last word of each row are always zero. */
+    const TArray<uint64>& GetBlockedWords() const { return BlockedWords; }
+
+    /** Calls Visitor(Cell) for every free cell in row-major order. */
+    template <typename VisitorType>
+    void ForEachFreeCell(VisitorType&& Visitor) const
+    {
+        for (int32 Y = 0; Y < Height; ++Y)
+        {
+            for (int32 X = 0; X < Width; ++X)
+            {
+                const FIntPoint Cell(X, Y);
+                if (!IsBlocked(Cell))
+                {
+                    Visitor(Cell);
+                }
+            }
+        }
+    }
+
+private:
+    int32 Width = 0;
+    int32 Height = 0;
+    int32 WordsPerRow = 0;
+    int32 NumBlocked = 0;
+
+    TArray<uint64> BlockedWords;
+    TArray<int16> CellUnits;
+};
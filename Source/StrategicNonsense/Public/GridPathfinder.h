@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGridOccupancy;
+
+/**
+ * @class FGridPathfinder
+ * @brief A* shortest paths over the occupancy layer's 4-connected free cells.
+ *
+ * Every step costs 1 and the Manhattan distance is the heuristic, so the first time the goal
+ * is popped its path is optimal. The open list is a binary heap of cell indices; ties on f
+ * prefer the deeper node, which keeps expansions close to the path length on open maps.
+ * Costs, parents and the closed set live in one flat per-cell array stamped with a query
+ * generation, so nothing is cleared or reallocated between queries on the same grid.
+ *
+ * Scratch buffers are owned by the pathfinder and reused between queries.
+ */
+class STRATEGICNONSENSE_API FGridPathfinder
+{
+public:
+    bool FindPath(const FGridOccupancy& Occupancy, const FIntPoint& Start, const FIntPoint& Goal, int32 MaxCost, TArray<FIntPoint>& OutPath);
+
+    /** Cells expanded by the last query, for profiling. */
+    int32 GetLastNumExpanded() const { return LastNumExpanded; }
+
+private:
+    /** Open list entry; Priority packs f in the high half and ~g in the low half so one compare orders the heap. */
+    struct FOpenNode
+    {
+        uint64 Priority;
+        int32 Index;
+
+        bool operator<(const FOpenNode& Other) const { return Priority < Other.Priority; }
+    };
+
+    static uint64 MakePriority(int32 F, int32 G) { return (static_cast<uint64>(F) << 32) | static_cast<uint32>(~G); }
+
+    void PrepareScratch(int32 NumCells);
+
+    /** Stamp value marking cells touched by the current query; bumped per query. */
+    uint32 Generation = 0;
+    int32 LastNumExpanded = 0;
+
+    /** Per-cell search state, kept together so a neighbour check touches one cache line. */
+    struct FCellRecord
+    {
+        uint32 SeenStamp;
+        uint32 ClosedStamp;
+        int32 Cost;
+        int32 Parent;
+    };
+
+    TArray<FCellRecord> Cells;
+    TArray<FOpenNode> Open;
+};
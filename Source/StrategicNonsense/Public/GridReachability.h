@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGridOccupancy;
+
+/**
+ * @class FGridReachability
+ * @brief Bounded-range BFS over the occupancy layer that never allocates once warmed up.
+ *
+ * Finds every free cell within MaxRange 4-connected steps of a start cell (the start itself is
+ * not reported and may be blocked by the moving unit). Visited cells are marked with a per-query
+ * generation stamp instead of a set, and the frontier lives in a power-of-two ring buffer. A BFS
+ * queue only holds two consecutive distance layers, which on open ground is at most
+ * 8 * MaxRange + 4 cells, so the ring is sized for that and stays a few hundred bytes for unit
+ * movement ranges. Walls can fold more cells into one layer; the ring then doubles and keeps
+ * the larger size.
+ *
+ * Results go to caller-owned storage, either a span of cells or a bitmask laid out like
+ * FGridOccupancy's row-padded blocked words. Scratch buffers are owned by the searcher and
+ * reused between queries; they only grow when the grid or the range gets larger.
+ */
+class STRATEGICNONSENSE_API FGridReachability
+{
+public:
+    int32 FindReachableCells(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, TArrayView<FIntPoint> OutCells);
+    int32 FindReachableCells(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, TArrayView<FIntPoint> OutCells, TArrayView<uint16> OutDistances);
+    int32 FindReachableMask(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, TArrayView<uint64> OutMask);
+
+    /** Upper bound on the cells a query can report: the diamond of radius MaxRange minus its centre, capped by the grid. */
+    static int32 GetMaxReachableCells(int32 MaxRange, int32 NumCells)
+    {
+        const int64 Range = FMath::Max(MaxRange, 0);
+        return static_cast<int32>(FMath::Min<int64>(2 * Range * (Range + 1), NumCells));
+    }
+
+    /** Reads a cell from a mask written by FindReachableMask. Cell must be valid. */
+    static bool IsCellInMask(TConstArrayView<uint64> Mask, int32 WordsPerRow, const FIntPoint& Cell)
+    {
+        return (Mask[Cell.Y * WordsPerRow + (Cell.X >> 6)] >> (Cell.X & 63)) & 1ull;
+    }
+
+private:
+    struct FQueueEntry
+    {
+        FIntPoint Cell;
+        int32 Distance;
+    };
+
+    template <typename VisitorType>
+    int32 Search(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, VisitorType&& Visitor);
+
+    void PrepareScratch(int32 NumCells, int32 MaxRange);
+    void GrowQueue(uint32& Head, uint32& Tail);
+
+    /** Stamp value marking cells visited by the current query; bumped per query. */
+    uint32 Generation = 0;
+
+    TArray<uint32> VisitStamp;
+    TArray<FQueueEntry> Queue;
+};
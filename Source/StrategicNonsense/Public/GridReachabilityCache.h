@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridBitboard.h"
+#include "GridReachability.h"
+
+struct FGridOccupancy;
+
+/**
+ * @class FGridReachabilityCache
+ * @brief Remembers recent reachability results so repeated queries for the same unit are lookups.
+ *
+ * Entries are keyed by start cell and movement range (one unit stands on a cell, so this is
+ * effectively per unit). Each keeps the reachable cells nearest first plus a distance field over
+ * the range's bounding box, so "can this unit reach that cell, and in how many steps" is one
+ * array read. A BFS limited to MaxRange steps never leaves the diamond of that radius, so an entry
+ * is only invalidated when a cell inside its diamond changes; the owner reports every change
+ * through InvalidateCell (or InvalidateAll for bulk edits).
+ *
+ * Holds a fixed number of entries and replaces the least recently used. Entry buffers are
+ * reused, so a warm cache does not allocate.
+ */
+class STRATEGICNONSENSE_API FGridReachabilityCache
+{
+public:
+    static constexpr int32 MaxEntries = 16;
+
+    TConstArrayView<FIntPoint> GetReachableCells(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange);
+    int32 GetDistance(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange, const FIntPoint& Cell);
+
+    void InvalidateCell(const FIntPoint& Cell);
+    void InvalidateAll();
+
+    uint64 GetNumHits() const { return NumHits; }
+    uint64 GetNumMisses() const { return NumMisses; }
+
+private:
+    struct FEntry
+    {
+        FIntPoint Start = FIntPoint::ZeroValue;
+        int32 MaxRange = 0;
+        bool bValid = false;
+        uint32 LastUsed = 0;
+
+        /** Bounding box of the diamond, clipped to the grid. */
+        FIntPoint BoxMin = FIntPoint::ZeroValue;
+        FIntPoint BoxSize = FIntPoint::ZeroValue;
+
+        TArray<FIntPoint> Cells;
+        TArray<uint16> CellDistances;
+
+        /** Steps from Start for every cell in the box; Unreachable where no path fits the range. */
+        TArray<uint16> DistanceField;
+    };
+
+    static constexpr uint16 Unreachable = MAX_uint16;
+
+    FEntry& FindOrBuild(const FGridOccupancy& Occupancy, const FIntPoint& Start, int32 MaxRange);
+
+    FEntry Entries[MaxEntries];
+    uint32 UseCounter = 0;
+    uint64 NumHits = 0;
+    uint64 NumMisses = 0;
+
+    FGridBitboard Search;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+/** Independent random sequences of one match. */
+enum class EMatchRandomStream : uint8
+{
+    /** Obstacle layout and looks, the starting coin toss and team colours. */
+    Map,
+
+    /** Damage rolls and counterattacks. */
+    Combat,
+
+    /** AI unit placement, random moves and search seeds. */
+    AI,
+
+    Count
+};
+
+/**
+ * @class FMatchRandom
+ * @brief Per-match random number service replacing the global FMath::Rand state.
+ *
+ * The match seed derives one seed per sub-stream, so map generation, combat and AI draw from
+ * separate sequences: an extra AI roll never shifts the damage rolls that follow it. The match
+ * seed comes from -MatchSeed= and each sub-stream can be pinned on its own with -MapSeed=,
+ * -CombatSeed= or -AISeed=. Without -MatchSeed= a seed is taken from the clock and logged, so
+ * any match can be rerun exactly. Nothing here is global; every simulation can own its own.
+ */
+class STRATEGICNONSENSE_API FMatchRandom
+{
+public:
+    void Initialise(int32 InMatchSeed);
+    void InitialiseFromCommandLine(const TCHAR* CommandLine);
+
+    int32 GetMatchSeed() const { return MatchSeed; }
+    int32 GetStreamSeed(EMatchRandomStream Stream) const { return Streams[static_cast<int32>(Stream)].GetInitialSeed(); }
+    void SetStreamSeed(EMatchRandomStream Stream, int32 Seed);
+
+    FRandomStream& GetStream(EMatchRandomStream Stream) { return Streams[static_cast<int32>(Stream)]; }
+    FRandomStream& Map() { return GetStream(EMatchRandomStream::Map); }
+    FRandomStream& Combat() { return GetStream(EMatchRandomStream::Combat); }
+    FRandomStream& AI() { return GetStream(EMatchRandomStream::AI); }
+
+    static int32 DeriveStreamSeed(int32 InMatchSeed, EMatchRandomStream Stream);
+
+private:
+    int32 MatchSeed = 0;
+    FRandomStream Streams[static_cast<int32>(EMatchRandomStream::Count)];
+};
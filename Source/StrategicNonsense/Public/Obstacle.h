@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "BattleActorPool.h"
 #include "Obstacle.generated.h"
 
 /**
@@ -14,7 +15,7 @@
 
 
 UCLASS()
-class STRATEGICNONSENSE_API AObstacle : public AActor
+class STRATEGICNONSENSE_API AObstacle : public AActor, public IBattlePooledActor
 {
 	GENERATED_BODY()
 
@@ -22,6 +23,12 @@ public:
 	// Sets default values for this actor's properties
 	AObstacle();
 
+	// Seeds the texture pick; set by the grid before the obstacle finishes spawning
+	void SetTextureSeed(int32 Seed) { TextureSeed = Seed; }
+
+	// Re-picks the texture for the new seed when the pool hands the obstacle out again
+	virtual void OnReactivated() override;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
@@ -42,4 +49,8 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Setup")
 	FVector ScaleOverride = FVector(1.0f, 1.0f, 1.0f);
 
+	// Seed for the texture pick, so the same match seed always gives the same looks
+	UPROPERTY(EditAnywhere, Category = "Obstacle")
+	int32 TextureSeed = 0;
+
 };
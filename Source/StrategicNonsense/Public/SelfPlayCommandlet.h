@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SelfPlayCommandlet.generated.h"
+
+/**
+ * @class USelfPlayCommandlet
+ * @brief Runs batches of headless matches in parallel and writes balance statistics to CSV.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd StrategicNonsense.uproject -run=SelfPlay -nullrhi -unattended
+ *     [-Matches=1000] [-Team0=Random|Expectiminimax|MonteCarlo] [-Team1=...]
+ *     [-GridX=25] [-GridY=25] [-Obstacles=10] [-BudgetMs=20] [-Depth=3]
+ *     [-Nodes=<search nodes>] [-Playouts=<playouts>] [-MaxTurns=200] [-Seed=0] [-Output=<path>.csv]
+ *
+ * Writes <Output> (summary), <Output>_matches.csv (one row per match) and
+ * <Output>_damage.csv (damage histograms). Match N uses seed Seed + N.
+ *
+ * The search agents think for BudgetMs per unit activation by default, so their play depends on
+ * machine load. -Nodes and -Playouts give them a fixed amount of work instead, which makes a batch
+ * reproducible; -Seed= without -BudgetMs= switches to 20000 nodes and 1000 playouts.
+ */
+UCLASS()
+class STRATEGICNONSENSE_API USelfPlayCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USelfPlayCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
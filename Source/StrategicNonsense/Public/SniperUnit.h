@@ -6,9 +6,9 @@
 
 /**
  * @class ASniperUnit
- * @brief Specialised unit type with distinct movement and attack capabilities.
+ * @brief The built-in Sniper archetype (ranged, provokes counters).
  *
- * 3 movement, 10 range, ignores obstacles, 48 damage, 20 HP.
+ * Stats come from FBattleArchetypeTable; the class only selects the archetype.
  */
 
 
@@ -19,7 +19,4 @@ class STRATEGICNONSENSE_API ASniperUnit : public AUnitActor
 
 public:
     ASniperUnit();
-
-    virtual int32 GetMovementRange() const override { return 3; }
-
 };
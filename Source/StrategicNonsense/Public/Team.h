@@ -14,6 +14,7 @@
 
 
 class AUnitActor;
+class AGridManager;
 
 UCLASS(Blueprintable)
 class STRATEGICNONSENSE_API UTeam : public UObject
@@ -21,7 +22,8 @@ class STRATEGICNONSENSE_API UTeam : public UObject
     GENERATED_BODY()
 
 public:
-    void Initialise(FName Colour, bool bIsPlayer);
+    void Initialise(FName Colour, bool bIsPlayer, uint8 InTeamIndex, AGridManager* InGridManager);
+    void ResolveUnitClasses();
 
     TSubclassOf<AUnitActor> GetSniperBlueprint() const;
     TSubclassOf<AUnitActor> GetBrawlerBlueprint() const;
@@ -30,6 +32,7 @@ public:
 
 
     bool IsPlayerControlled() const;
+    uint8 GetTeamIndex() const { return TeamIndex; }
 
     FName GetTeamColour() const;
 
@@ -39,6 +42,7 @@ public:
     const TArray<AUnitActor*>& GetControlledUnits() const;
 
     void ResetUnitsForNewTurn();
+    void MarkUnitsAsDone();
 
     bool OwnsUnit(const AUnitActor* Unit) const;
 
@@ -64,4 +68,10 @@ private:
     UPROPERTY()
     TArray<AUnitActor*> ControlledUnits;
 
+    uint8 TeamIndex = 0;
+
+    /** Owns the unit registry, which answers the per-team queries without touching the actors. */
+    UPROPERTY()
+    AGridManager* GridManager = nullptr;
+
 };
\ No newline at end of file
@@ -2,14 +2,26 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "BattleActorPool.h"
+#include "BattleState.h"
 #include "UnitActor.generated.h"
 
+struct FRandomStream;
+class AUnitActor;
+class FBattleUnitRegistry;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnUnitHealthChanged, AUnitActor* /*Unit*/);
+
 /**
  * @class AUnitActor
  * @brief Base class for all game units (Sniper, Brawler).
  *
- * Stores shared properties like health, position, and team reference.
- * Implements generic unit logic to be extended by specific unit types.
+ * Stores shared properties like health, position, and team reference. Movement, range, damage
+ * and maximum health come from the archetype's row in FBattleArchetypeTable, so blueprints only
+ * pick an ArchetypeId and a sprite.
+ *
+ * Once placed, a unit's entry in the grid's FBattleUnitRegistry is the state game logic reads;
+ * the actor mirrors it for rendering and writes every change through to it.
  */
 
 
@@ -42,18 +54,19 @@ struct FDamageRange
 };
 
 UCLASS(Abstract)
-class STRATEGICNONSENSE_API AUnitActor : public AActor
+class STRATEGICNONSENSE_API AUnitActor : public AActor, public IBattlePooledActor
 {
     GENERATED_BODY()
 
 public:
     AUnitActor();
 
-    UFUNCTION(BlueprintCallable, Category = "Combat")
-    int32 GetRandomDamage() const;
+    /** Not pure: every call advances Stream, so Blueprint must call it exactly once per roll. */
+    UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Combat")
+    int32 GetRandomDamage(UPARAM(ref) FRandomStream& Stream) const;
 
     UFUNCTION(BlueprintCallable, Category = "Combat")
-    void ApplyDamageTo(AUnitActor* Target);
+    void ApplyDamageTo(AUnitActor* Target, UPARAM(ref) FRandomStream& Stream);
 
     UFUNCTION(BlueprintCallable, Category = "Combat")
     void ReceiveDamage(int32 Amount);
@@ -64,51 +77,72 @@ public:
     void SetGridPosition(FIntPoint NewPos) { GridPosition = NewPos; }
 
     bool HasMovedThisTurn() const { return bHasMoved; }
-    void MarkAsMoved() { bHasMoved = true; }
-    void ResetMovement() { bHasMoved = false; }
+    void MarkAsMoved() { bHasMoved = true; SyncFlagsToRegistry(); }
+    void ResetMovement() { bHasMoved = false; SyncFlagsToRegistry(); }
 
-    virtual int32 GetMovementRange() const { return 0; } // Default: immobile
+    EBattleArchetype GetArchetype() const { return static_cast<EBattleArchetype>(ArchetypeId); }
+    const FBattleUnitStats& GetStats() const { return FBattleUnitStats::Get(GetArchetype()); }
 
-    int32 GetAttackRange() const { return AttackRange; }
+    int32 GetMovementRange() const { return GetStats().Movement; }
+    int32 GetAttackRange() const { return GetStats().AttackRange; }
+    EAttackType GetAttackType() const { return static_cast<EAttackType>(GetStats().AttackType); }
     EGameUnitType GetUnitType() const { return UnitType; }
 
     int32 GetHealth() const { return Health; }
-    int32 GetMaxHealth() const { return (UnitType == EGameUnitType::Sniper) ? 20 : 40; }
+    int32 GetMaxHealth() const { return GetStats().MaxHealth; }
 
     bool HasAttackedThisTurn() const { return bHasAttacked; }
-    void MarkAsAttacked() { bHasAttacked = true; }
-    void ResetAttack() { bHasAttacked = false; }
+    void MarkAsAttacked() { bHasAttacked = true; SyncFlagsToRegistry(); }
+    void ResetAttack() { bHasAttacked = false; SyncFlagsToRegistry(); }
 
     bool IsActionComplete() const { return bHasMoved && bHasAttacked; }
-    void MarkAsDone() { bHasMoved = true; bHasAttacked = true; }
+    void MarkAsDone() { bHasMoved = true; bHasAttacked = true; SyncFlagsToRegistry(); }
+
+    void BindToRegistry(FBattleUnitRegistry* InRegistry, int32 InRegistryId);
+    void UnbindFromRegistry();
+    void SyncFlagsFromRegistry();
+    int32 GetRegistryId() const { return RegistryId; }
+
+    /** 0 or 1 once the unit joins a team; FBattleUnitRegistry::NoTeam before. Kept after death and release. */
+    uint8 GetTeamIndex() const { return TeamIndex; }
+    void SetTeamIndex(uint8 InTeamIndex);
+
+    virtual void OnReactivated() override;
+    virtual void OnDeactivated() override;
+
+    /** Broadcast whenever damage changes the unit's health, including the hit that kills it. */
+    FOnUnitHealthChanged OnHealthChanged;
 
 
 
 
 protected:
+    virtual void BeginPlay() override;
+
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Visual", meta = (AllowPrivateAccess = "true"))
     UPaperSpriteComponent* SpriteComponent;
 
+    /** Status widget row the unit is shown in. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
     EGameUnitType UnitType;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
-    int32 MaxMovement;
+    /** Row of FBattleArchetypeTable (and ArchetypeId of the unit archetype DataTable) this unit plays by. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats", meta = (ClampMin = "0", ClampMax = "63"))
+    uint8 ArchetypeId;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
-    EAttackType AttackType;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
-    int32 AttackRange;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
-    FDamageRange Damage;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Stats")
     int32 Health;
 
     FIntPoint GridPosition;
     bool bHasMoved = false;
     bool bHasAttacked = false;
 
+private:
+    void SyncFlagsToRegistry();
+
+    /** The grid's registry while the unit is placed; owned by the grid manager. */
+    FBattleUnitRegistry* Registry = nullptr;
+    int32 RegistryId = INDEX_NONE;
+    uint8 TeamIndex;
+
 };
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "UnitActor.h"
+#include "UnitArchetype.generated.h"
+
+struct FBattleUnitStats;
+
+/**
+ * @struct FUnitArchetypeRow
+ * @brief One unit archetype in the unit archetype DataTable.
+ *
+ * Rows are copied into FBattleArchetypeTable when a match begins; gameplay, the AI and the
+ * headless simulator only ever read that table. A new unit type needs a row and a blueprint
+ * whose ArchetypeId names the row, not a new C++ class.
+ */
+USTRUCT(BlueprintType)
+struct STRATEGICNONSENSE_API FUnitArchetypeRow : public FTableRowBase
+{
+    GENERATED_BODY()
+
+    /** Index into the stats table; stored in replays, so keep it stable once shipped. 0 and 1 are Sniper and Brawler. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Archetype", meta = (ClampMin = "0", ClampMax = "63"))
+    int32 ArchetypeId = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats", meta = (ClampMin = "1", ClampMax = "32767"))
+    int32 MaxHealth = 1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats", meta = (ClampMin = "0", ClampMax = "255"))
+    int32 Movement = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+    EAttackType AttackType = EAttackType::ShortRange;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats", meta = (ClampMin = "0", ClampMax = "255"))
+    int32 AttackRange = 1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
+    FDamageRange Damage = { 1, 1 };
+
+    /** Whether targets within their counter range hit back when this unit attacks them. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Counterattack")
+    bool bProvokesCounters = false;
+
+    /** Largest distance at which this unit counterattacks; 0 never counters. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Counterattack", meta = (ClampMin = "0", ClampMax = "255"))
+    int32 CounterRange = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Counterattack")
+    FDamageRange CounterDamage = { 1, 3 };
+
+    bool ToStats(FBattleUnitStats& OutStats) const;
+};
@@ -38,6 +38,8 @@ private:
     void PlaceAIUnit();
     void RemoveUnitFromQueue(TSubclassOf<AUnitActor> UnitClass, UTeam* OwningTeam);
     void ShowStartMessage();
+    void OnMatchAssetsLoaded();
+    void TryBeginPlacement();
 
 
     UPROPERTY()
@@ -60,6 +62,9 @@ private:
 
     int32 CurrentPlacementTeamIndex = 0;
     bool bUnitSelectionWidgetShown = false;
+    bool bStartMessageDone = false;
+    bool bMatchAssetsLoaded = false;
+    bool bPlacementStarted = false;
     FText StartText;
 
 };
@@ -2,5 +2,39 @@
 
 #include "StrategicNonsense.h"
 #include "Modules/ModuleManager.h"
+#include "Misc/CoreDelegates.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, StrategicNonsense, "StrategicNonsense" );
+DEFINE_LOG_CATEGORY(LogSNGrid);
+DEFINE_LOG_CATEGORY(LogSNCombat);
+DEFINE_LOG_CATEGORY(LogSNAI);
+DEFINE_LOG_CATEGORY(LogSNPlacement);
+DEFINE_LOG_CATEGORY(LogSNGame);
+
+/**
+ * @class FStrategicNonsenseModule
+ * @brief Game module; zeroes the Insights counters at the start of each frame, as the stat system does for its counters.
+ */
+class FStrategicNonsenseModule : public FDefaultGameModuleImpl
+{
+public:
+    virtual void StartupModule() override
+    {
+        BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddStatic(&FStrategicNonsenseModule::ResetFrameCounters);
+    }
+
+    virtual void ShutdownModule() override
+    {
+        FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+    }
+
+private:
+    static void ResetFrameCounters()
+    {
+        TRACE_COUNTER_SET(SNBFSNodesExpanded, 0);
+        TRACE_COUNTER_SET(SNAIStatesEvaluated, 0);
+    }
+
+    FDelegateHandle BeginFrameHandle;
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FStrategicNonsenseModule, StrategicNonsense, "StrategicNonsense" );
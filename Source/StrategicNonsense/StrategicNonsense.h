@@ -3,4 +3,47 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
 
+/**
+ * Log categories of the game, one per system. Each defaults to Log at runtime.
+ *
+ * Per-cell, per-hit and per-click traces are logged at Verbose or VeryVerbose. Shipping and Test
+ * builds compile those out entirely; other builds keep them, silent until enabled with e.g.
+ * "Log LogSNGrid VeryVerbose" in the console or -LogCmds="LogSNGrid VeryVerbose".
+ */
+#if UE_BUILD_SHIPPING || UE_BUILD_TEST
+#define SN_LOG_COMPILE_TIME_VERBOSITY Log
+#else
+#define SN_LOG_COMPILE_TIME_VERBOSITY All
+#endif
+
+/** Grid generation, occupancy, obstacles and the actor pool. */
+DECLARE_LOG_CATEGORY_EXTERN(LogSNGrid, Log, SN_LOG_COMPILE_TIME_VERBOSITY);
+
+/** Attacks, damage and counterattacks. */
+DECLARE_LOG_CATEGORY_EXTERN(LogSNCombat, Log, SN_LOG_COMPILE_TIME_VERBOSITY);
+
+/** AI turns, planners and self-play. */
+DECLARE_LOG_CATEGORY_EXTERN(LogSNAI, Log, SN_LOG_COMPILE_TIME_VERBOSITY);
+
+/** Team setup and the unit placement phase. */
+DECLARE_LOG_CATEGORY_EXTERN(LogSNPlacement, Log, SN_LOG_COMPILE_TIME_VERBOSITY);
+
+/** Match flow, player input, widgets, assets, seeds and replays. */
+DECLARE_LOG_CATEGORY_EXTERN(LogSNGame, Log, SN_LOG_COMPILE_TIME_VERBOSITY);
+
+/**
+ * Stat group for the game's systems ("stat StrategicNonsense"). Instrumented functions also open a
+ * TRACE_CPUPROFILER_EVENT_SCOPE so they appear in Unreal Insights captures of builds without stats.
+ */
+DECLARE_STATS_GROUP(TEXT("StrategicNonsense"), STATGROUP_StrategicNonsense, STATCAT_Advanced);
+
+/**
+ * Insights counters mirroring the per-frame stat counters. The module resets them at the start of
+ * every frame, so each track shows per-frame work like its stat rather than a running total.
+ */
+TRACE_DECLARE_INT_COUNTER_EXTERN(SNBFSNodesExpanded);
+TRACE_DECLARE_INT_COUNTER_EXTERN(SNAIStatesEvaluated);